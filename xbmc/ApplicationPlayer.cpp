@@ -385,7 +385,8 @@ int64_t CApplicationPlayer::GetTotalTime() const
   std::shared_ptr<IPlayer> player = GetInternal();
   if (player)
   {
-    int64_t total = CDataCacheCore::GetInstance().GetMaxTime() - CDataCacheCore::GetInstance().GetMinTime();
+    const PlayerStateSnapshot state = CDataCacheCore::GetInstance().GetPlayerStateSnapshot();
+    int64_t total = state.timeMax - state.timeMin;
     return total;
   }
   else
@@ -166,10 +166,7 @@ bool CPartyModeManager::Enable(PartyModeContext context /*= PARTYMODECONTEXT_MUS
     m_songIDCache.insert(m_songIDCache.end(), songIDs2.begin(), songIDs2.end());
   }
 
-  // Songs and music videos are random from query, but need mixing together when have both
-  if (songcount > 0 && videocount > 0 )
-    KODI::UTILS::RandomShuffle(m_songIDCache.begin(), m_songIDCache.end());
- 
+  // Songs and music videos are picked at random from the cache in AddRandomSongs
   CLog::Log(LOGINFO,"PARTY MODE MANAGER: Matching songs = {0}", m_iMatchingSongs);
   CLog::Log(LOGINFO,"PARTY MODE MANAGER: Party mode enabled!");
 
@@ -311,7 +308,11 @@ bool CPartyModeManager::AddRandomSongs()
   {
     // Limit songs fetched to remainder of songID cache
     iMissingSongs = std::min(iMissingSongs, static_cast<int>(m_songIDCache.size()) - m_iMatchingSongsPicked);
-      
+
+    // Shuffle just the songs to pick to the front of the remainder, rather than the whole cache
+    KODI::UTILS::RandomSample(m_songIDCache.begin() + m_iMatchingSongsPicked, m_songIDCache.end(),
+                              iMissingSongs);
+
     // Pick iMissingSongs from remaining songID cache
     std::string sqlWhereMusic = "songview.idSong IN (";
     std::string sqlWhereVideo = "idMVideo IN (";
@@ -24,6 +24,7 @@ using namespace ActiveAE;
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "windowing/WinSystem.h"
+#include "utils/TimeUtils.h"
 #include "utils/log.h"
 
 #define MAX_CACHE_LEVEL 0.4   // total cache time of stream in seconds
@@ -246,6 +247,24 @@ AEAudioFormat CEngineStats::GetCurrentSinkFormat()
   return m_sinkFormat;
 }
 
+void CEngineStats::AddStageTime(Stage stage, int64_t startCounter)
+{
+  m_stageTimes[static_cast<int>(stage)].fetch_add(CurrentHostCounter() - startCounter,
+                                                  std::memory_order_relaxed);
+}
+
+int64_t CEngineStats::GetStageTime(Stage stage) const
+{
+  const int64_t ticks = m_stageTimes[static_cast<int>(stage)].load(std::memory_order_relaxed);
+  return ticks * 1000000 / CurrentHostFrequency();
+}
+
+void CEngineStats::ResetStageTimes()
+{
+  for (auto& time : m_stageTimes)
+    time.store(0, std::memory_order_relaxed);
+}
+
 CActiveAE::CActiveAE() :
   CThread("ActiveAE"),
   m_controlPort("OutputControlPort", &m_inMsgEvent, &m_outMsgEvent),
@@ -1879,7 +1898,7 @@ bool CActiveAE::RunStages()
   for (it = m_streams.begin(); it != m_streams.end(); ++it)
   {
     if ((*it)->m_processingBuffers && !(*it)->m_paused)
-      busy = (*it)->m_processingBuffers->ProcessBuffers();
+      busy = (*it)->m_processingBuffers->ProcessBuffers(&m_stats);
 
     if ((*it)->m_streamIsBuffering &&
         (*it)->m_processingBuffers &&
@@ -1975,6 +1994,7 @@ bool CActiveAE::RunStages()
     // mix streams and sounds sounds
     if (m_mode != MODE_RAW)
     {
+      const int64_t mixStart = CurrentHostCounter();
       CSampleBuffer *out = NULL;
       if (!m_sounds_playing.empty() && m_streams.empty())
       {
@@ -2271,6 +2291,8 @@ bool CActiveAE::RunStages()
         busy = true;
       }
 
+      m_stats.AddStageTime(CEngineStats::Stage::MIX, mixStart);
+
       // update stats
       if(out)
       {
@@ -2304,7 +2326,9 @@ bool CActiveAE::RunStages()
   }
 
   // serve sink buffers
+  const int64_t convertStart = CurrentHostCounter();
   busy |= m_sinkBuffers->ResampleBuffers();
+  m_stats.AddStageTime(CEngineStats::Stage::SINK_CONVERT, convertStart);
   while(!m_sinkBuffers->m_outputSamples.empty())
   {
     CSampleBuffer *out = NULL;
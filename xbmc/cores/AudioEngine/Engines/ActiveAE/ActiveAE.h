@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <string>
 #include <vector>
@@ -193,6 +194,20 @@ public:
   void SetSinkLatency(float time) { m_sinkLatency = time; }
   bool IsSuspended();
   AEAudioFormat GetCurrentSinkFormat();
+
+  // stages of the engine whose processing time is accounted, for benchmarking
+  enum class Stage
+  {
+    RESAMPLE, // resampling, remapping and conversion of stream data
+    ATEMPO,
+    MIX, // volume, mixing of streams and gui sounds
+    SINK_CONVERT, // conversion to the sink format
+    SINK_OUTPUT, // writing to the sink, includes waiting for it
+    COUNT
+  };
+  void AddStageTime(Stage stage, int64_t startCounter);
+  int64_t GetStageTime(Stage stage) const; // in microseconds
+  void ResetStageTimes();
 protected:
   float m_sinkCacheTotal;
   float m_sinkLatency;
@@ -213,6 +228,7 @@ protected:
     CAESyncInfo::AESyncState m_syncState;
   };
   std::vector<StreamStats> m_streamStats;
+  std::atomic<int64_t> m_stageTimes[static_cast<int>(Stage::COUNT)] = {}; // in host counter ticks
 };
 
 class CActiveAE : public IAE, public IDispResource, private CThread
@@ -265,6 +281,9 @@ public:
   void OnResetDisplay() override;
   void OnAppFocusChange(bool focus) override;
 
+  int64_t GetStageTime(CEngineStats::Stage stage) const { return m_stats.GetStageTime(stage); }
+  void ResetStageTimes() { m_stats.ResetStageTimes(); }
+
 protected:
   void PlaySound(CActiveAESound *sound);
   static uint8_t **AllocSoundSample(SampleConfig &config, int &samples, int &bytes_per_sample, int &planes, int &linesize);
@@ -15,6 +15,7 @@
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "utils/EndianSwap.h"
 #include "utils/MemUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/log.h"
 
 #include <algorithm>
@@ -436,7 +437,11 @@ void CActiveAESink::StateMachine(int signal, Protocol *port, Message *msg)
           CSampleBuffer *samples;
           unsigned int delay;
           samples = *((CSampleBuffer**)msg->data);
-          delay = OutputSamples(samples);
+          {
+            const int64_t start = CurrentHostCounter();
+            delay = OutputSamples(samples);
+            m_stats->AddStageTime(CEngineStats::Stage::SINK_OUTPUT, start);
+          }
           msg->Reply(CSinkDataProtocol::RETURNSAMPLE, &samples, sizeof(CSampleBuffer*));
           if (m_extError)
           {
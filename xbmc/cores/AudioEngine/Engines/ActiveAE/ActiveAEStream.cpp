@@ -12,6 +12,7 @@
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "threads/SingleLock.h"
+#include "utils/TimeUtils.h"
 #include "utils/log.h"
 
 using namespace ActiveAE;
@@ -626,10 +627,11 @@ void CActiveAEStreamBuffers::SetExtraData(int profile, enum AVMatrixEncoding mat
   /*! @todo Implement set dsp config with new AudioDSP buffer implementation */
 }
 
-bool CActiveAEStreamBuffers::ProcessBuffers()
+bool CActiveAEStreamBuffers::ProcessBuffers(CEngineStats *stats /* = nullptr */)
 {
   bool busy = false;
   CSampleBuffer *buf;
+  int64_t start = CurrentHostCounter();
 
   while (!m_inputSamples.empty())
   {
@@ -640,6 +642,11 @@ bool CActiveAEStreamBuffers::ProcessBuffers()
   }
 
   busy |= m_resampleBuffers->ResampleBuffers();
+  if (stats)
+  {
+    stats->AddStageTime(CEngineStats::Stage::RESAMPLE, start);
+    start = CurrentHostCounter();
+  }
 
   while (!m_resampleBuffers->m_outputSamples.empty())
   {
@@ -650,6 +657,8 @@ bool CActiveAEStreamBuffers::ProcessBuffers()
   }
 
   busy |= m_atempoBuffers->ProcessBuffers();
+  if (stats)
+    stats->AddStageTime(CEngineStats::Stage::ATEMPO, start);
 
   while (!m_atempoBuffers->m_outputSamples.empty())
   {
@@ -0,0 +1,157 @@
+/*
+ *  Copyright (C) 2010-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AESinkNULL.h"
+
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "threads/SystemClock.h"
+#include "utils/TimeUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+constexpr const char* CAESinkNULL::DEVICE_REALTIME;
+constexpr const char* CAESinkNULL::DEVICE_UNPACED;
+constexpr unsigned int CAESinkNULL::PERIOD_MS;
+constexpr unsigned int CAESinkNULL::PERIODS;
+
+namespace
+{
+
+const AEDataFormatList NULL_FORMATS = {AE_FMT_FLOAT, AE_FMT_S32NE, AE_FMT_S16NE};
+
+} // unnamed namespace
+
+void CAESinkNULL::Register()
+{
+  AE::AESinkRegEntry entry;
+  entry.sinkName = "NULL";
+  entry.createFunc = CAESinkNULL::Create;
+  entry.enumerateFunc = CAESinkNULL::EnumerateDevicesEx;
+  AE::CAESinkFactory::RegisterSink(entry);
+}
+
+IAESink* CAESinkNULL::Create(std::string &device, AEAudioFormat& desiredFormat)
+{
+  IAESink* sink = new CAESinkNULL();
+  if (sink->Initialize(desiredFormat, device))
+    return sink;
+
+  delete sink;
+  return nullptr;
+}
+
+void CAESinkNULL::EnumerateDevicesEx(AEDeviceInfoList &list, bool force)
+{
+  CAEDeviceInfo info;
+  AddDeviceFormats(info, NULL_FORMATS);
+
+  info.m_deviceName = DEVICE_REALTIME;
+  info.m_displayName = "Null";
+  info.m_displayNameExtra = "real time";
+  list.push_back(info);
+
+  info.m_deviceName = DEVICE_UNPACED;
+  info.m_displayNameExtra = "unpaced";
+  list.push_back(info);
+}
+
+void CAESinkNULL::AddDeviceFormats(CAEDeviceInfo &info, const AEDataFormatList &dataFormats)
+{
+  info.m_deviceType = AE_DEVTYPE_PCM;
+  info.m_wantsIECPassthrough = false;
+  info.m_channels = AE_CH_LAYOUT_7_1;
+  info.m_sampleRates = {32000, 44100, 48000, 88200, 96000, 176400, 192000};
+  info.m_dataFormats = dataFormats;
+}
+
+void CAESinkNULL::NegotiateFormat(AEAudioFormat &format, const AEDataFormatList &dataFormats)
+{
+  if (std::find(dataFormats.begin(), dataFormats.end(), format.m_dataFormat) == dataFormats.end())
+    format.m_dataFormat = dataFormats.front();
+  if (format.m_channelLayout.Count() == 0)
+    format.m_channelLayout = AE_CH_LAYOUT_2_0;
+  if (format.m_sampleRate == 0)
+    format.m_sampleRate = 48000;
+
+  format.m_frames = format.m_sampleRate * PERIOD_MS / 1000;
+  format.m_frameSize =
+      (CAEUtil::DataFormatToBits(format.m_dataFormat) >> 3) * format.m_channelLayout.Count();
+}
+
+bool CAESinkNULL::Initialize(AEAudioFormat &format, std::string &device)
+{
+  m_realtime = device != DEVICE_UNPACED;
+  NegotiateFormat(format, NULL_FORMATS);
+  m_format = format;
+  m_playedUntil = 0;
+
+  CLog::Log(LOGINFO, "CAESinkNULL::{} - {} Hz, {} channels, {}, {}", __FUNCTION__,
+            m_format.m_sampleRate, m_format.m_channelLayout.Count(),
+            CAEUtil::DataFormatToStr(m_format.m_dataFormat),
+            m_realtime ? "real time" : "unpaced");
+  return true;
+}
+
+void CAESinkNULL::Deinitialize()
+{
+  m_playedUntil = 0;
+}
+
+double CAESinkNULL::GetCacheTotal()
+{
+  return static_cast<double>(PERIODS * PERIOD_MS) / 1000;
+}
+
+void CAESinkNULL::GetDelay(AEDelayStatus& status)
+{
+  const int64_t buffered = m_playedUntil - CurrentHostCounter();
+  if (!m_realtime || buffered <= 0)
+    status.SetDelay(0);
+  else
+    status.SetDelay(static_cast<double>(buffered) / CurrentHostFrequency());
+}
+
+unsigned int CAESinkNULL::AddPackets(uint8_t **data, unsigned int frames, unsigned int offset)
+{
+  Play(frames);
+  return frames;
+}
+
+void CAESinkNULL::AddPause(unsigned int millis)
+{
+  Play(m_format.m_sampleRate * millis / 1000);
+}
+
+void CAESinkNULL::Drain()
+{
+  const int64_t buffered = m_playedUntil - CurrentHostCounter();
+  if (m_realtime && buffered > 0)
+    XbmcThreads::ThreadSleep(static_cast<unsigned int>(buffered * 1000 / CurrentHostFrequency()));
+  m_playedUntil = 0;
+}
+
+void CAESinkNULL::Play(unsigned int frames)
+{
+  if (!m_realtime)
+    return;
+
+  const int64_t now = CurrentHostCounter();
+  const int64_t frequency = CurrentHostFrequency();
+
+  // the device underran, it plays from now on
+  if (m_playedUntil < now)
+    m_playedUntil = now;
+  m_playedUntil += static_cast<int64_t>(frames) * frequency / m_format.m_sampleRate;
+
+  // block like a device until the frames fit into its buffer
+  const int64_t overfull =
+      m_playedUntil - now - static_cast<int64_t>(GetCacheTotal() * frequency);
+  if (overfull > 0)
+    XbmcThreads::ThreadSleep(static_cast<unsigned int>(overfull * 1000 / frequency));
+}
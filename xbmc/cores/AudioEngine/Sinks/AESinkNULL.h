@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2010-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Interfaces/AESink.h"
+#include "cores/AudioEngine/Utils/AEDeviceInfo.h"
+
+#include <stdint.h>
+
+/*!
+ * \brief Sink discarding all audio, for running the engine without an audio device.
+ *
+ * Device "realtime" simulates a device playing from a buffer of a few periods, so the engine is
+ * paced as with real hardware. Device "unpaced" consumes audio as soon as it is added, which
+ * lets the engine run as fast as it can.
+ */
+class CAESinkNULL : public IAESink
+{
+public:
+  const char *GetName() override { return "NULL"; }
+
+  CAESinkNULL() = default;
+  ~CAESinkNULL() override = default;
+
+  static void Register();
+  static IAESink* Create(std::string &device, AEAudioFormat &desiredFormat);
+  static void EnumerateDevicesEx(AEDeviceInfoList &list, bool force = false);
+
+  bool Initialize(AEAudioFormat &format, std::string &device) override;
+  void Deinitialize() override;
+
+  double GetCacheTotal() override;
+  void GetDelay(AEDelayStatus& status) override;
+  unsigned int AddPackets(uint8_t **data, unsigned int frames, unsigned int offset) override;
+  void AddPause(unsigned int millis) override;
+  void Drain() override;
+
+  static constexpr const char* DEVICE_REALTIME = "realtime";
+  static constexpr const char* DEVICE_UNPACED = "unpaced";
+
+protected:
+  /*!
+   * \brief Adapt format to one of the given data formats and set period and frame size.
+   */
+  static void NegotiateFormat(AEAudioFormat &format, const AEDataFormatList &dataFormats);
+  static void AddDeviceFormats(CAEDeviceInfo &info, const AEDataFormatList &dataFormats);
+
+  /*!
+   * \brief Account for frames played, waits for buffer space if playing in real time.
+   */
+  void Play(unsigned int frames);
+
+  static constexpr unsigned int PERIOD_MS = 20;
+  static constexpr unsigned int PERIODS = 4;
+
+  AEAudioFormat m_format;
+  bool m_realtime = true;
+  int64_t m_playedUntil = 0; // host counter at which all added frames have been played
+};
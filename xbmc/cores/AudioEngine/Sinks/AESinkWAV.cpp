@@ -0,0 +1,165 @@
+/*
+ *  Copyright (C) 2010-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AESinkWAV.h"
+
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+constexpr const char* CAESinkWAV::DEFAULT_DEVICE;
+
+namespace
+{
+
+// audio is written as is, so only formats stored little endian
+#ifndef WORDS_BIGENDIAN
+const AEDataFormatList WAV_FORMATS = {AE_FMT_FLOAT, AE_FMT_S32LE, AE_FMT_S16LE};
+#else
+const AEDataFormatList WAV_FORMATS = {AE_FMT_S32LE, AE_FMT_S16LE};
+#endif
+
+constexpr unsigned int WAV_HEADER_SIZE = 44;
+constexpr uint16_t WAVE_FORMAT_PCM = 1;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 3;
+
+void PutLE16(uint8_t* dst, uint16_t value)
+{
+  dst[0] = value & 0xff;
+  dst[1] = value >> 8;
+}
+
+void PutLE32(uint8_t* dst, uint32_t value)
+{
+  PutLE16(dst, value & 0xffff);
+  PutLE16(dst + 2, value >> 16);
+}
+
+} // unnamed namespace
+
+CAESinkWAV::~CAESinkWAV()
+{
+  Deinitialize();
+}
+
+void CAESinkWAV::Register()
+{
+  AE::AESinkRegEntry entry;
+  entry.sinkName = "WAV";
+  entry.createFunc = CAESinkWAV::Create;
+  entry.enumerateFunc = CAESinkWAV::EnumerateDevicesEx;
+  AE::CAESinkFactory::RegisterSink(entry);
+}
+
+IAESink* CAESinkWAV::Create(std::string &device, AEAudioFormat& desiredFormat)
+{
+  IAESink* sink = new CAESinkWAV();
+  if (sink->Initialize(desiredFormat, device))
+    return sink;
+
+  delete sink;
+  return nullptr;
+}
+
+void CAESinkWAV::EnumerateDevicesEx(AEDeviceInfoList &list, bool force)
+{
+  CAEDeviceInfo info;
+  AddDeviceFormats(info, WAV_FORMATS);
+  info.m_deviceName = DEFAULT_DEVICE;
+  info.m_displayName = "WAV file";
+  info.m_displayNameExtra = DEFAULT_DEVICE;
+  list.push_back(info);
+}
+
+bool CAESinkWAV::Initialize(AEAudioFormat &format, std::string &device)
+{
+  if (device.empty())
+    device = DEFAULT_DEVICE;
+
+  m_realtime = false;
+  NegotiateFormat(format, WAV_FORMATS);
+  m_format = format;
+  m_dataSize = 0;
+
+  if (!m_file.OpenForWrite(device, true) || !WriteHeader())
+  {
+    CLog::Log(LOGERROR, "CAESinkWAV::{} - unable to write {}", __FUNCTION__, device);
+    m_file.Close();
+    return false;
+  }
+  m_isOpen = true;
+
+  CLog::Log(LOGINFO, "CAESinkWAV::{} - capturing {} Hz, {} channels, {} to {}", __FUNCTION__,
+            m_format.m_sampleRate, m_format.m_channelLayout.Count(),
+            CAEUtil::DataFormatToStr(m_format.m_dataFormat), device);
+  return true;
+}
+
+void CAESinkWAV::Deinitialize()
+{
+  if (!m_isOpen)
+    return;
+
+  // the sizes are known now
+  if (m_file.Seek(0) != 0 || !WriteHeader())
+    CLog::Log(LOGERROR, "CAESinkWAV::{} - unable to finish header", __FUNCTION__);
+  m_file.Close();
+  m_isOpen = false;
+}
+
+unsigned int CAESinkWAV::AddPackets(uint8_t **data, unsigned int frames, unsigned int offset)
+{
+  const size_t size = static_cast<size_t>(frames) * m_format.m_frameSize;
+  const uint8_t* buffer = data[0] + static_cast<size_t>(offset) * m_format.m_frameSize;
+  if (m_file.Write(buffer, size) != static_cast<ssize_t>(size))
+  {
+    CLog::Log(LOGERROR, "CAESinkWAV::{} - write failed", __FUNCTION__);
+    return 0;
+  }
+
+  // the sizes of the header can't hold more
+  m_dataSize = static_cast<uint32_t>(std::min<uint64_t>(
+      static_cast<uint64_t>(m_dataSize) + size,
+      std::numeric_limits<uint32_t>::max() - WAV_HEADER_SIZE));
+  return frames;
+}
+
+void CAESinkWAV::AddPause(unsigned int millis)
+{
+  const unsigned int frames = m_format.m_sampleRate * millis / 1000;
+  std::vector<uint8_t> silence(static_cast<size_t>(frames) * m_format.m_frameSize, 0);
+  uint8_t* buffer = silence.data();
+  AddPackets(&buffer, frames, 0);
+}
+
+bool CAESinkWAV::WriteHeader()
+{
+  const uint16_t channels = static_cast<uint16_t>(m_format.m_channelLayout.Count());
+  const uint16_t bits = static_cast<uint16_t>(CAEUtil::DataFormatToBits(m_format.m_dataFormat));
+
+  uint8_t header[WAV_HEADER_SIZE];
+  memcpy(header, "RIFF", 4);
+  PutLE32(header + 4, WAV_HEADER_SIZE - 8 + m_dataSize);
+  memcpy(header + 8, "WAVEfmt ", 8);
+  PutLE32(header + 16, 16);
+  PutLE16(header + 20, m_format.m_dataFormat == AE_FMT_FLOAT ? WAVE_FORMAT_IEEE_FLOAT
+                                                             : WAVE_FORMAT_PCM);
+  PutLE16(header + 22, channels);
+  PutLE32(header + 24, m_format.m_sampleRate);
+  PutLE32(header + 28, m_format.m_sampleRate * m_format.m_frameSize);
+  PutLE16(header + 32, static_cast<uint16_t>(m_format.m_frameSize));
+  PutLE16(header + 34, bits);
+  memcpy(header + 36, "data", 4);
+  PutLE32(header + 40, m_dataSize);
+
+  return m_file.Write(header, sizeof(header)) == static_cast<ssize_t>(sizeof(header));
+}
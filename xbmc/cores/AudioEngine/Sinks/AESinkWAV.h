@@ -0,0 +1,47 @@
+/*
+ *  Copyright (C) 2010-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "filesystem/File.h"
+
+/*!
+ * \brief Sink capturing audio to a WAV file, e.g. for comparing the output of the engine
+ * bit by bit.
+ *
+ * The device is the path of the file, it is overwritten when the sink is opened. Audio is
+ * written as fast as the engine produces it.
+ */
+class CAESinkWAV : public CAESinkNULL
+{
+public:
+  const char *GetName() override { return "WAV"; }
+
+  CAESinkWAV() = default;
+  ~CAESinkWAV() override;
+
+  static void Register();
+  static IAESink* Create(std::string &device, AEAudioFormat &desiredFormat);
+  static void EnumerateDevicesEx(AEDeviceInfoList &list, bool force = false);
+
+  bool Initialize(AEAudioFormat &format, std::string &device) override;
+  void Deinitialize() override;
+
+  unsigned int AddPackets(uint8_t **data, unsigned int frames, unsigned int offset) override;
+  void AddPause(unsigned int millis) override;
+
+  static constexpr const char* DEFAULT_DEVICE = "special://temp/audiocapture.wav";
+
+private:
+  bool WriteHeader();
+
+  XFILE::CFile m_file;
+  bool m_isOpen = false;
+  uint32_t m_dataSize = 0;
+};
@@ -0,0 +1,338 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AudioEngineBenchmark.h"
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAE.h"
+#include "cores/AudioEngine/Interfaces/AEStream.h"
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "cores/AudioEngine/Sinks/AESinkWAV.h"
+#include "cores/AudioEngine/Utils/AEStreamData.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/SystemClock.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/TimeUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <map>
+#include <memory>
+
+using namespace ActiveAE;
+
+namespace
+{
+
+constexpr unsigned int CHUNK_FRAMES = 1024;
+constexpr unsigned int STALL_TIMEOUT = 5000; // ms without any progress of the engine
+constexpr double TONE_FREQUENCY = 440.0;
+
+int64_t ElapsedMicroseconds(int64_t start)
+{
+  return (CurrentHostCounter() - start) * 1000000 / CurrentHostFrequency();
+}
+
+/*!
+ * \brief A stream fed with a tone, each channel an octave above the previous one.
+ */
+struct CBenchmarkStream
+{
+  CAudioEngineBenchmark::StreamOptions options;
+  IAEStream* stream = nullptr;
+  unsigned int channels = 0;
+  unsigned int frameSize = 0;
+  uint64_t framesTotal = 0;
+  uint64_t framesAdded = 0;
+  std::vector<uint8_t> buffer;
+
+  // the samples only depend on their position, so refused frames are generated again
+  void Generate(unsigned int frames)
+  {
+    buffer.resize(static_cast<size_t>(frames) * frameSize);
+    for (unsigned int i = 0; i < frames; i++)
+    {
+      const double t = static_cast<double>(framesAdded + i) / options.sampleRate;
+      for (unsigned int c = 0; c < channels; c++)
+      {
+        const double value = 0.5 * std::sin(2 * M_PI * TONE_FREQUENCY * (1 << (c % 4)) * t);
+        const size_t index = static_cast<size_t>(i) * channels + c;
+        switch (options.dataFormat)
+        {
+          case AE_FMT_S16NE:
+            reinterpret_cast<int16_t*>(buffer.data())[index] = static_cast<int16_t>(value * INT16_MAX);
+            break;
+          case AE_FMT_S32NE:
+            reinterpret_cast<int32_t*>(buffer.data())[index] = static_cast<int32_t>(value * INT32_MAX);
+            break;
+          default:
+            reinterpret_cast<float*>(buffer.data())[index] = static_cast<float>(value);
+            break;
+        }
+      }
+    }
+  }
+};
+
+/*!
+ * \brief Replaces the registered sinks by the NULL and WAV sinks, restores them when going out of
+ * scope.
+ */
+class CBenchmarkSinks : private AE::CAESinkFactory
+{
+public:
+  CBenchmarkSinks()
+  {
+    m_sinks.swap(m_AESinkRegEntry);
+    CAESinkNULL::Register();
+    CAESinkWAV::Register();
+  }
+
+  ~CBenchmarkSinks() { m_sinks.swap(m_AESinkRegEntry); }
+
+private:
+  std::map<std::string, AE::AESinkRegEntry> m_sinks;
+};
+
+/*!
+ * \brief Replaces the audio output settings, restores them when going out of scope.
+ */
+class CBenchmarkSettings
+{
+public:
+  CBenchmarkSettings(const std::shared_ptr<CSettings>& settings,
+                     const CAudioEngineBenchmark::Options& options)
+    : m_settings(settings)
+  {
+    m_device = m_settings->GetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE);
+    m_config = m_settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_CONFIG);
+    m_sampleRate = m_settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_SAMPLERATE);
+    m_channels = m_settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_CHANNELS);
+    m_passthrough = m_settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH);
+
+    m_settings->SetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE,
+                          options.sink + ":" + options.device);
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CONFIG, AE_CONFIG_FIXED);
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_SAMPLERATE, options.sampleRate);
+    // the values of the setting are those of the standard layouts
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CHANNELS, options.channelLayout);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH, false);
+  }
+
+  ~CBenchmarkSettings()
+  {
+    m_settings->SetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE, m_device);
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CONFIG, m_config);
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_SAMPLERATE, m_sampleRate);
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CHANNELS, m_channels);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH, m_passthrough);
+  }
+
+private:
+  std::shared_ptr<CSettings> m_settings;
+  std::string m_device;
+  int m_config;
+  int m_sampleRate;
+  int m_channels;
+  bool m_passthrough;
+};
+
+} // unnamed namespace
+
+CAudioEngineBenchmark::CAudioEngineBenchmark(const Options& options) : m_options(options)
+{
+  if (m_options.streams.empty())
+    m_options.streams.emplace_back();
+}
+
+bool CAudioEngineBenchmark::Run(std::string& json)
+{
+  CVariant result;
+  if (!Run(result))
+    return false;
+
+  return CJSONVariantWriter::Write(result, json, false);
+}
+
+bool CAudioEngineBenchmark::Run(CVariant& result)
+{
+  for (const StreamOptions& options : m_options.streams)
+  {
+    if (options.dataFormat != AE_FMT_S16NE && options.dataFormat != AE_FMT_S32NE &&
+        options.dataFormat != AE_FMT_FLOAT)
+    {
+      CLog::Log(LOGERROR, "CAudioEngineBenchmark::{} - unsupported stream format {}",
+                __FUNCTION__, CAEUtil::DataFormatToStr(options.dataFormat));
+      return false;
+    }
+  }
+
+  // the settings changed below would reconfigure it
+  if (CServiceBroker::GetActiveAE())
+  {
+    CLog::Log(LOGERROR, "CAudioEngineBenchmark::{} - an audio engine is running", __FUNCTION__);
+    return false;
+  }
+
+  CBenchmarkSettings settings(CServiceBroker::GetSettingsComponent()->GetSettings(), m_options);
+  CBenchmarkSinks sinks;
+
+  std::unique_ptr<CActiveAE> engine(new CActiveAE());
+  engine->Start();
+
+  std::vector<CBenchmarkStream> streams(m_options.streams.size());
+  bool success = true;
+  for (size_t i = 0; i < streams.size() && success; i++)
+  {
+    CBenchmarkStream& stream = streams[i];
+    stream.options = m_options.streams[i];
+
+    AEAudioFormat format;
+    format.m_dataFormat = stream.options.dataFormat;
+    format.m_sampleRate = stream.options.sampleRate;
+    format.m_channelLayout = stream.options.channelLayout;
+    stream.channels = format.m_channelLayout.Count();
+    stream.frameSize = stream.channels * (CAEUtil::DataFormatToBits(format.m_dataFormat) >> 3);
+    stream.framesTotal = static_cast<uint64_t>(stream.options.sampleRate) * m_options.duration / 1000;
+
+    const unsigned int streamOptions = stream.options.tempo != 1.0 ? AESTREAM_FORCE_RESAMPLE : 0;
+    stream.stream = engine->MakeStream(format, streamOptions);
+    if (!stream.stream)
+    {
+      success = false;
+      break;
+    }
+    stream.stream->SetAmplification(stream.options.amplification);
+    stream.stream->SetVolume(stream.options.volume);
+    if (stream.options.tempo != 1.0)
+      stream.stream->SetResampleRatio(stream.options.tempo);
+  }
+
+  const int64_t startCounter = CurrentHostCounter();
+  const std::clock_t cpuStart = std::clock();
+  engine->ResetStageTimes();
+
+  double latencySum = 0.0;
+  double latencyMax = 0.0;
+  uint64_t latencySamples = 0;
+  XbmcThreads::EndTime stallTimer(STALL_TIMEOUT);
+
+  while (success)
+  {
+    bool done = true;
+    bool progress = false;
+    for (CBenchmarkStream& stream : streams)
+    {
+      if (stream.framesAdded >= stream.framesTotal)
+        continue;
+      done = false;
+
+      const uint64_t space = stream.stream->GetSpace() / stream.frameSize;
+      const unsigned int frames = static_cast<unsigned int>(
+          std::min<uint64_t>({space, CHUNK_FRAMES, stream.framesTotal - stream.framesAdded}));
+      if (frames == 0)
+        continue;
+
+      stream.Generate(frames);
+      const uint8_t* data = stream.buffer.data();
+      const unsigned int added = stream.stream->AddData(&data, 0, frames, nullptr);
+      stream.framesAdded += added;
+      progress |= added > 0;
+
+      // a frame added now is played after the delay of the stream
+      const double delay = stream.stream->GetDelay();
+      latencySum += delay;
+      latencyMax = std::max(latencyMax, delay);
+      latencySamples++;
+    }
+
+    if (done)
+      break;
+
+    if (progress)
+      stallTimer.Set(STALL_TIMEOUT);
+    else if (stallTimer.IsTimePast())
+    {
+      CLog::Log(LOGERROR, "CAudioEngineBenchmark::{} - engine stalled", __FUNCTION__);
+      success = false;
+    }
+    else
+      XbmcThreads::ThreadSleep(1);
+  }
+
+  // output is complete once all streams have been drained
+  if (success)
+  {
+    for (CBenchmarkStream& stream : streams)
+      stream.stream->Drain(false);
+
+    XbmcThreads::EndTime drainTimer(STALL_TIMEOUT);
+    while (!std::all_of(streams.begin(), streams.end(),
+                        [](const CBenchmarkStream& stream) { return stream.stream->IsDrained(); }))
+    {
+      if (drainTimer.IsTimePast())
+      {
+        CLog::Log(LOGERROR, "CAudioEngineBenchmark::{} - streams not drained", __FUNCTION__);
+        success = false;
+        break;
+      }
+      XbmcThreads::ThreadSleep(1);
+    }
+  }
+
+  const int64_t totalTime = ElapsedMicroseconds(startCounter);
+  const double cpuTime = static_cast<double>(std::clock() - cpuStart) * 1000 / CLOCKS_PER_SEC;
+
+  result = CVariant(CVariant::VariantTypeObject);
+  result["sink"] = m_options.sink;
+  result["device"] = m_options.device;
+  result["samplerate"] = m_options.sampleRate;
+  result["channels"] = CAEChannelInfo(m_options.channelLayout).Count();
+  result["duration_ms"] = m_options.duration;
+  result["totaltime_ms"] = totalTime / 1000;
+  result["cputime_ms"] = cpuTime;
+  result["realtimefactor"] =
+      totalTime > 0 ? static_cast<double>(m_options.duration) * 1000 / totalTime : 0.0;
+
+  CVariant& stages = result["stages_ms"];
+  stages["resample"] = engine->GetStageTime(CEngineStats::Stage::RESAMPLE) / 1000.0;
+  stages["atempo"] = engine->GetStageTime(CEngineStats::Stage::ATEMPO) / 1000.0;
+  stages["mix"] = engine->GetStageTime(CEngineStats::Stage::MIX) / 1000.0;
+  stages["sinkconvert"] = engine->GetStageTime(CEngineStats::Stage::SINK_CONVERT) / 1000.0;
+  stages["sinkoutput"] = engine->GetStageTime(CEngineStats::Stage::SINK_OUTPUT) / 1000.0;
+
+  result["latency"]["avg_ms"] = latencySamples > 0 ? latencySum * 1000 / latencySamples : 0.0;
+  result["latency"]["max_ms"] = latencyMax * 1000;
+
+  result["streams"] = CVariant(CVariant::VariantTypeArray);
+  for (const CBenchmarkStream& stream : streams)
+  {
+    CVariant info;
+    info["samplerate"] = stream.options.sampleRate;
+    info["channels"] = stream.channels;
+    info["format"] = CAEUtil::DataFormatToStr(stream.options.dataFormat);
+    info["tempo"] = stream.options.tempo;
+    info["frames"] = stream.framesAdded;
+    result["streams"].push_back(info);
+  }
+
+  for (CBenchmarkStream& stream : streams)
+  {
+    if (stream.stream)
+      engine->FreeStream(stream.stream, false);
+  }
+  engine.reset();
+
+  return success;
+}
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Utils/AEChannelData.h"
+
+#include <string>
+#include <vector>
+
+class CVariant;
+
+/*!
+ * \brief Headless benchmark of the ActiveAE pipeline.
+ *
+ * Streams of generated audio are fed to an audio engine playing to the NULL or WAV sink, so no
+ * audio device is needed. The output is fixed to a sample rate and channel layout, so streams in
+ * other formats are resampled and remapped. Streams played at another tempo go through the
+ * atempo filter, all streams are mixed.
+ *
+ * The registered sinks and the audio output settings are replaced while running and restored
+ * afterwards. It refuses to run while the application's audio engine is running. Part of the
+ * tests only, it's not built into the application.
+ */
+class CAudioEngineBenchmark
+{
+public:
+  struct StreamOptions
+  {
+    unsigned int sampleRate = 44100;
+    AEStdChLayout channelLayout = AE_CH_LAYOUT_2_0;
+    AEDataFormat dataFormat = AE_FMT_S16NE;
+    double tempo = 1.0; //!< speed of playback, the atempo filter is used beyond its threshold
+    float amplification = 1.0f;
+    float volume = 1.0f;
+  };
+
+  struct Options
+  {
+    std::string sink = "NULL"; //!< NULL or WAV
+    std::string device = "unpaced"; //!< device of the sink, the file to write for WAV
+    unsigned int sampleRate = 48000; //!< output sample rate
+    AEStdChLayout channelLayout = AE_CH_LAYOUT_2_0; //!< output channel layout
+    unsigned int duration = 10000; //!< audio in ms fed to each stream
+    std::vector<StreamOptions> streams;
+  };
+
+  explicit CAudioEngineBenchmark(const Options& options);
+
+  /*!
+   * \brief Run the benchmark
+   * \param result receives the real time factor, the time spent in each stage of the engine
+   * and the latency reported by the streams
+   * \return false if the engine or a stream could not be created
+   */
+  bool Run(CVariant& result);
+
+  /*!
+   * \brief Run the benchmark and serialize the result as JSON
+   */
+  bool Run(std::string& json);
+
+private:
+  Options m_options;
+};
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/test/AudioEngineBenchmark.h"
+#include "filesystem/File.h"
+#include "utils/Variant.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+/*
+ * Runs the headless audio engine benchmark when KODI_BENCHMARK_AUDIO is set, its value being the
+ * sink device, e.g. NULL:unpaced, NULL:realtime or WAV:/tmp/out.wav. Set KODI_BENCHMARK_OUTPUT
+ * to write the JSON result to a file instead of stdout.
+ */
+TEST(TestAudioEngineBenchmark, MixThroughput)
+{
+  const char* device = std::getenv("KODI_BENCHMARK_AUDIO");
+  if (!device)
+    GTEST_SKIP() << "KODI_BENCHMARK_AUDIO not set";
+
+  CAudioEngineBenchmark::Options options;
+  const std::string sink = device;
+  const size_t pos = sink.find(':');
+  options.sink = sink.substr(0, pos);
+  if (pos != std::string::npos)
+    options.device = sink.substr(pos + 1);
+  options.channelLayout = AE_CH_LAYOUT_5_1;
+
+  // resampled and downmixed, upmixed, and stretched in time
+  CAudioEngineBenchmark::StreamOptions music;
+  CAudioEngineBenchmark::StreamOptions movie;
+  movie.sampleRate = 48000;
+  movie.channelLayout = AE_CH_LAYOUT_7_1;
+  movie.dataFormat = AE_FMT_FLOAT;
+  movie.amplification = 2.0f;
+  CAudioEngineBenchmark::StreamOptions tempo;
+  tempo.sampleRate = 48000;
+  tempo.dataFormat = AE_FMT_S32NE;
+  tempo.tempo = 1.25;
+  tempo.volume = 0.5f;
+  options.streams = {music, movie, tempo};
+
+  CAudioEngineBenchmark benchmark(options);
+  std::string json;
+  ASSERT_TRUE(benchmark.Run(json));
+  EXPECT_FALSE(json.empty());
+
+  const char* output = std::getenv("KODI_BENCHMARK_OUTPUT");
+  if (output)
+  {
+    XFILE::CFile file;
+    ASSERT_TRUE(file.OpenForWrite(output, true));
+    EXPECT_EQ(static_cast<ssize_t>(json.size()), file.Write(json.c_str(), json.size()));
+  }
+  else
+    std::cout << json << std::endl;
+}
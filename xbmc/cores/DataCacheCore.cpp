@@ -15,11 +15,10 @@
 CDataCacheCore::CDataCacheCore() :
   m_playerVideoInfo {},
   m_playerAudioInfo {},
-  m_contentInfo {},
-  m_renderInfo {},
-  m_stateInfo {}
+  m_contentInfo {}
 {
   m_hasAVInfoChanges = false;
+  m_playerStateChanged = false;
 }
 
 CDataCacheCore::~CDataCacheCore() = default;
@@ -31,16 +30,14 @@ CDataCacheCore& CDataCacheCore::GetInstance()
 
 void CDataCacheCore::Reset()
 {
-  {
-    CSingleLock lock(m_stateSection);
-
-    m_stateInfo.m_speed = 1.0;
-    m_stateInfo.m_tempo = 1.0;
-    m_stateInfo.m_stateSeeking = false;
-    m_stateInfo.m_renderGuiLayer = false;
-    m_stateInfo.m_renderVideoLayer = false;
-    m_playerStateChanged = false;
-  }
+  UpdatePlayerState([](PlayerStateSnapshot& state) {
+    state.speed = 1.0;
+    state.tempo = 1.0;
+    state.stateSeeking = false;
+    state.renderGuiLayer = false;
+    state.renderVideoLayer = false;
+  });
+  m_playerStateChanged = false;
 
   {
     CSingleLock lock(m_contentSection);
@@ -72,12 +69,25 @@ void CDataCacheCore::SignalSubtitleInfoChange()
   m_hasAVInfoChanges = true;
 }
 
+PlayerStateSnapshot CDataCacheCore::GetPlayerStateSnapshot() const
+{
+  return m_playerState.Read();
+}
+
+uint32_t CDataCacheCore::GetPlayerStateGeneration() const
+{
+  return m_playerState.Generation();
+}
+
 void CDataCacheCore::SetVideoDecoderName(std::string name, bool isHw)
 {
-  CSingleLock lock(m_videoPlayerSection);
+  {
+    CSingleLock lock(m_videoPlayerSection);
+
+    m_playerVideoInfo.decoderName = name;
+  }
 
-  m_playerVideoInfo.decoderName = name;
-  m_playerVideoInfo.isHwDecoder = isHw;
+  UpdatePlayerState([isHw](PlayerStateSnapshot& state) { state.isHwDecoder = isHw; });
 }
 
 std::string CDataCacheCore::GetVideoDecoderName()
@@ -89,9 +99,7 @@ std::string CDataCacheCore::GetVideoDecoderName()
 
 bool CDataCacheCore::IsVideoHwDecoder()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.isHwDecoder;
+  return m_playerState.Read().isHwDecoder;
 }
 
 
@@ -139,52 +147,40 @@ std::string CDataCacheCore::GetVideoStereoMode()
 
 void CDataCacheCore::SetVideoDimensions(int width, int height)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.width = width;
-  m_playerVideoInfo.height = height;
+  UpdatePlayerState([width, height](PlayerStateSnapshot& state) {
+    state.width = width;
+    state.height = height;
+  });
 }
 
 int CDataCacheCore::GetVideoWidth()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.width;
+  return m_playerState.Read().width;
 }
 
 int CDataCacheCore::GetVideoHeight()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.height;
+  return m_playerState.Read().height;
 }
 
 void CDataCacheCore::SetVideoFps(float fps)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.fps = fps;
+  UpdatePlayerState([fps](PlayerStateSnapshot& state) { state.fps = fps; });
 }
 
 float CDataCacheCore::GetVideoFps()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.fps;
+  return m_playerState.Read().fps;
 }
 
 void CDataCacheCore::SetVideoDAR(float dar)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.dar = dar;
+  UpdatePlayerState([dar](PlayerStateSnapshot& state) { state.dar = dar; });
 }
 
 float CDataCacheCore::GetVideoDAR()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.dar;
+  return m_playerState.Read().dar;
 }
 
 // player audio info
@@ -218,30 +214,22 @@ std::string CDataCacheCore::GetAudioChannels()
 
 void CDataCacheCore::SetAudioSampleRate(int sampleRate)
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  m_playerAudioInfo.sampleRate = sampleRate;
+  UpdatePlayerState([sampleRate](PlayerStateSnapshot& state) { state.sampleRate = sampleRate; });
 }
 
 int CDataCacheCore::GetAudioSampleRate()
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  return m_playerAudioInfo.sampleRate;
+  return m_playerState.Read().sampleRate;
 }
 
 void CDataCacheCore::SetAudioBitsPerSample(int bitsPerSample)
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  m_playerAudioInfo.bitsPerSample = bitsPerSample;
+  UpdatePlayerState([bitsPerSample](PlayerStateSnapshot& state) { state.bitsPerSample = bitsPerSample; });
 }
 
 int CDataCacheCore::GetAudioBitsPerSample()
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  return m_playerAudioInfo.bitsPerSample;
+  return m_playerState.Read().bitsPerSample;
 }
 
 void CDataCacheCore::SetCutList(const std::vector<EDL::Cut>& cutList)
@@ -270,163 +258,128 @@ std::vector<std::pair<std::string, int64_t>> CDataCacheCore::GetChapters() const
 
 void CDataCacheCore::SetRenderClockSync(bool enable)
 {
-  CSingleLock lock(m_renderSection);
-
-  m_renderInfo.m_isClockSync = enable;
+  UpdatePlayerState([enable](PlayerStateSnapshot& state) { state.isClockSync = enable; });
 }
 
 bool CDataCacheCore::IsRenderClockSync()
 {
-  CSingleLock lock(m_renderSection);
-
-  return m_renderInfo.m_isClockSync;
+  return m_playerState.Read().isClockSync;
 }
 
 // player states
 void CDataCacheCore::SetStateSeeking(bool active)
 {
-  CSingleLock lock(m_stateSection);
-
-  m_stateInfo.m_stateSeeking = active;
+  UpdatePlayerState([active](PlayerStateSnapshot& state) { state.stateSeeking = active; });
   m_playerStateChanged = true;
 }
 
 bool CDataCacheCore::IsSeeking()
 {
-  CSingleLock lock(m_stateSection);
-
-  return m_stateInfo.m_stateSeeking;
+  return m_playerState.Read().stateSeeking;
 }
 
 void CDataCacheCore::SetSpeed(float tempo, float speed)
 {
-  CSingleLock lock(m_stateSection);
-
-  m_stateInfo.m_tempo = tempo;
-  m_stateInfo.m_speed = speed;
+  UpdatePlayerState([tempo, speed](PlayerStateSnapshot& state) {
+    state.tempo = tempo;
+    state.speed = speed;
+  });
 }
 
 float CDataCacheCore::GetSpeed()
 {
-  CSingleLock lock(m_stateSection);
-
-  return m_stateInfo.m_speed;
+  return m_playerState.Read().speed;
 }
 
 float CDataCacheCore::GetTempo()
 {
-  CSingleLock lock(m_stateSection);
-
-  return m_stateInfo.m_tempo;
+  return m_playerState.Read().tempo;
 }
 
 void CDataCacheCore::SetFrameAdvance(bool fa)
 {
-  CSingleLock lock(m_stateSection);
-
-  m_stateInfo.m_frameAdvance = fa;
+  UpdatePlayerState([fa](PlayerStateSnapshot& state) { state.frameAdvance = fa; });
 }
 
 bool CDataCacheCore::IsFrameAdvance()
 {
-  CSingleLock lock(m_stateSection);
-
-  return m_stateInfo.m_frameAdvance;
+  return m_playerState.Read().frameAdvance;
 }
 
 bool CDataCacheCore::IsPlayerStateChanged()
 {
-  CSingleLock lock(m_stateSection);
-
-  bool ret(m_playerStateChanged);
-  m_playerStateChanged = false;
-
-  return ret;
+  return m_playerStateChanged.exchange(false);
 }
 
 void CDataCacheCore::SetGuiRender(bool gui)
 {
-  CSingleLock lock(m_stateSection);
-
-  m_stateInfo.m_renderGuiLayer = gui;
+  UpdatePlayerState([gui](PlayerStateSnapshot& state) { state.renderGuiLayer = gui; });
   m_playerStateChanged = true;
 }
 
 bool CDataCacheCore::GetGuiRender()
 {
-  CSingleLock lock(m_stateSection);
-
-  return m_stateInfo.m_renderGuiLayer;
+  return m_playerState.Read().renderGuiLayer;
 }
 
 void CDataCacheCore::SetVideoRender(bool video)
 {
-  CSingleLock lock(m_stateSection);
-
-  m_stateInfo.m_renderVideoLayer = video;
+  UpdatePlayerState([video](PlayerStateSnapshot& state) { state.renderVideoLayer = video; });
   m_playerStateChanged = true;
 }
 
 bool CDataCacheCore::GetVideoRender()
 {
-  CSingleLock lock(m_stateSection);
-
-  return m_stateInfo.m_renderVideoLayer;
+  return m_playerState.Read().renderVideoLayer;
 }
 
 void CDataCacheCore::SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max)
 {
-  CSingleLock lock(m_stateSection);
-  m_timeInfo.m_startTime = start;
-  m_timeInfo.m_time = current;
-  m_timeInfo.m_timeMin = min;
-  m_timeInfo.m_timeMax = max;
+  UpdatePlayerState([start, current, min, max](PlayerStateSnapshot& state) {
+    state.startTime = start;
+    state.time = current;
+    state.timeMin = min;
+    state.timeMax = max;
+  });
 }
 
 void CDataCacheCore::GetPlayTimes(time_t &start, int64_t &current, int64_t &min, int64_t &max)
 {
-  CSingleLock lock(m_stateSection);
-  start = m_timeInfo.m_startTime;
-  current = m_timeInfo.m_time;
-  min = m_timeInfo.m_timeMin;
-  max = m_timeInfo.m_timeMax;
+  const PlayerStateSnapshot state = m_playerState.Read();
+  start = state.startTime;
+  current = state.time;
+  min = state.timeMin;
+  max = state.timeMax;
 }
 
 time_t CDataCacheCore::GetStartTime()
 {
-  CSingleLock lock(m_stateSection);
-  return m_timeInfo.m_startTime;
+  return m_playerState.Read().startTime;
 }
 
 int64_t CDataCacheCore::GetPlayTime()
 {
-  CSingleLock lock(m_stateSection);
-  return m_timeInfo.m_time;
+  return m_playerState.Read().time;
 }
 
 int64_t CDataCacheCore::GetMinTime()
 {
-  CSingleLock lock(m_stateSection);
-  return m_timeInfo.m_timeMin;
+  return m_playerState.Read().timeMin;
 }
 
 int64_t CDataCacheCore::GetMaxTime()
 {
-  CSingleLock lock(m_stateSection);
-  return m_timeInfo.m_timeMax;
+  return m_playerState.Read().timeMax;
 }
 
 float CDataCacheCore::GetPlayPercentage()
 {
-  CSingleLock lock(m_stateSection);
-
   // Note: To calculate accurate percentage, all time data must be consistent,
-  //       which is the case for data cache core. Calculation can not be done
-  //       outside of data cache core or a possibility to lock the data cache
-  //       core from outside would be needed.
-  int64_t iTotalTime = m_timeInfo.m_timeMax - m_timeInfo.m_timeMin;
+  //       which is the case for a single player state snapshot.
+  const PlayerStateSnapshot state = m_playerState.Read();
+  int64_t iTotalTime = state.timeMax - state.timeMin;
   if (iTotalTime <= 0)
     return 0;
 
-  return m_timeInfo.m_time * 100 / static_cast<float>(iTotalTime);
+  return state.time * 100 / static_cast<float>(iTotalTime);
 }
@@ -9,8 +9,11 @@
 #pragma once
 
 #include "threads/CriticalSection.h"
+#include "threads/SeqLock.h"
+#include "threads/SingleLock.h"
 
 #include <atomic>
+#include <ctime>
 #include <string>
 #include <vector>
 
@@ -19,6 +22,42 @@ namespace EDL
   struct Cut;
 }
 
+/*!
+ * \brief One consistent generation of the player state which is not string based.
+ *
+ * Published by the player threads as a whole and copied by readers without locking.
+ */
+struct PlayerStateSnapshot
+{
+  // video info
+  bool isHwDecoder;
+  int width;
+  int height;
+  float fps;
+  float dar;
+
+  // audio info
+  int sampleRate;
+  int bitsPerSample;
+
+  // render info
+  bool isClockSync;
+
+  // player states
+  bool stateSeeking;
+  bool renderGuiLayer;
+  bool renderVideoLayer;
+  float tempo;
+  float speed;
+  bool frameAdvance;
+
+  // time info
+  time_t startTime;
+  int64_t time;
+  int64_t timeMin;
+  int64_t timeMax;
+};
+
 class CDataCacheCore
 {
 public:
@@ -31,6 +70,19 @@ public:
   void SignalAudioInfoChange();
   void SignalSubtitleInfoChange();
 
+  /*!
+   * \brief Get a consistent copy of the current player state without taking any lock.
+   *
+   * Prefer this over the individual getters when several values are needed together,
+   * e.g. times and speed, as they are guaranteed to belong to the same update.
+   */
+  PlayerStateSnapshot GetPlayerStateSnapshot() const;
+
+  /*!
+   * \brief Get the number of player state updates published so far.
+   */
+  uint32_t GetPlayerStateGeneration() const;
+
   // player video info
   void SetVideoDecoderName(std::string name, bool isHw);
   std::string GetVideoDecoderName();
@@ -127,20 +179,23 @@ public:
   int64_t GetMaxTime();
 
 protected:
+  template<typename F>
+  void UpdatePlayerState(F&& update)
+  {
+    CSingleLock lock(m_snapshotSection);
+    update(m_pendingState);
+    m_playerState.Publish(m_pendingState);
+  }
+
   std::atomic_bool m_hasAVInfoChanges;
 
   CCriticalSection m_videoPlayerSection;
   struct SPlayerVideoInfo
   {
     std::string decoderName;
-    bool isHwDecoder;
     std::string deintMethod;
     std::string pixFormat;
     std::string stereoMode;
-    int width;
-    int height;
-    float fps;
-    float dar;
   } m_playerVideoInfo;
 
   CCriticalSection m_audioPlayerSection;
@@ -148,8 +203,6 @@ protected:
   {
     std::string decoderName;
     std::string channels;
-    int sampleRate;
-    int bitsPerSample;
   } m_playerAudioInfo;
 
   mutable CCriticalSection m_contentSection;
@@ -159,29 +212,10 @@ protected:
     std::vector<std::pair<std::string, int64_t>> m_chapters; // name and position for chapters
   } m_contentInfo;
 
-  CCriticalSection m_renderSection;
-  struct SRenderInfo
-  {
-    bool m_isClockSync;
-  } m_renderInfo;
+  std::atomic_bool m_playerStateChanged;
 
-  CCriticalSection m_stateSection;
-  bool m_playerStateChanged = false;
-  struct SStateInfo
-  {
-    bool m_stateSeeking;
-    bool m_renderGuiLayer;
-    bool m_renderVideoLayer;
-    float m_tempo;
-    float m_speed;
-    bool m_frameAdvance;
-  } m_stateInfo;
-
-  struct STimeInfo
-  {
-    time_t m_startTime;
-    int64_t m_time;
-    int64_t m_timeMax;
-    int64_t m_timeMin;
-  } m_timeInfo = {};
+  // writers serialize on m_snapshotSection and publish m_pendingState as a whole
+  CCriticalSection m_snapshotSection;
+  PlayerStateSnapshot m_pendingState = {};
+  XbmcThreads::CSeqLock<PlayerStateSnapshot> m_playerState;
 };
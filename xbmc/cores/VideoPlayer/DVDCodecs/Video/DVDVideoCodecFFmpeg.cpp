@@ -23,6 +23,7 @@
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <inttypes.h>
 #include <memory>
 
 #include "system.h"
@@ -33,6 +34,7 @@ extern "C" {
 #include <libavfilter/avfilter.h>
 #include <libavfilter/buffersink.h>
 #include <libavfilter/buffersrc.h>
+#include <libavutil/imgutils.h>
 #include <libavutil/pixdesc.h>
 }
 
@@ -61,6 +63,9 @@ enum EFilterFlags {
   FILTER_ROTATE              = 0x40,  //< rotate image according to the codec hints
 };
 
+// line and plane alignment of frames allocated by GetBuffer, enough for any simd in ffmpeg
+constexpr int FRAME_BUFFER_ALIGN = 64;
+
 //------------------------------------------------------------------------------
 // Video Buffers
 //------------------------------------------------------------------------------
@@ -184,6 +189,121 @@ void CVideoBufferPoolFFmpeg::Return(int id)
   m_free.push_back(id);
 }
 
+//------------------------------------------------------------------------------
+// Frame memory handed to libavcodec by get_buffer2
+// Blocks are recycled once the last reference, usually held by a picture in the
+// render queue, goes away. A block keeps the pool alive while it is in use, so
+// pictures may outlive the codec.
+//------------------------------------------------------------------------------
+
+class CFrameBufferPoolFFmpeg : public std::enable_shared_from_this<CFrameBufferPoolFFmpeg>
+{
+public:
+  ~CFrameBufferPoolFFmpeg();
+  AVBufferRef* Get(int size);
+  void GetStats(unsigned int& hits, unsigned int& misses, uint64_t& allocated);
+
+protected:
+  struct CBlock
+  {
+    uint8_t* data = nullptr;
+    int size = 0;
+    std::shared_ptr<CFrameBufferPoolFFmpeg> pool;
+  };
+
+  static void FreeBuffer(void* opaque, uint8_t* data);
+  void Return(CBlock* block);
+
+  CCriticalSection m_critSection;
+  std::vector<CBlock*> m_free;
+  int m_size = 0;
+  unsigned int m_hits = 0;
+  unsigned int m_misses = 0;
+  uint64_t m_allocated = 0;
+};
+
+CFrameBufferPoolFFmpeg::~CFrameBufferPoolFFmpeg()
+{
+  for (auto block : m_free)
+  {
+    av_free(block->data);
+    delete block;
+  }
+}
+
+AVBufferRef* CFrameBufferPoolFFmpeg::Get(int size)
+{
+  CSingleLock lock(m_critSection);
+
+  if (size != m_size)
+  {
+    for (auto block : m_free)
+    {
+      av_free(block->data);
+      delete block;
+    }
+    m_free.clear();
+    m_size = size;
+  }
+
+  CBlock* block = nullptr;
+  if (!m_free.empty())
+  {
+    block = m_free.back();
+    m_free.pop_back();
+    m_hits++;
+  }
+  else
+  {
+    uint8_t* data = static_cast<uint8_t*>(av_malloc(size));
+    if (!data)
+      return nullptr;
+    block = new CBlock;
+    block->data = data;
+    block->size = size;
+    m_misses++;
+    m_allocated += size;
+  }
+
+  AVBufferRef* buf = av_buffer_create(block->data, block->size, FreeBuffer, block, 0);
+  if (!buf)
+  {
+    m_free.push_back(block);
+    return nullptr;
+  }
+
+  block->pool = shared_from_this();
+  return buf;
+}
+
+void CFrameBufferPoolFFmpeg::GetStats(unsigned int& hits, unsigned int& misses, uint64_t& allocated)
+{
+  CSingleLock lock(m_critSection);
+  hits = m_hits;
+  misses = m_misses;
+  allocated = m_allocated;
+}
+
+void CFrameBufferPoolFFmpeg::FreeBuffer(void* opaque, uint8_t* data)
+{
+  CBlock* block = static_cast<CBlock*>(opaque);
+  std::shared_ptr<CFrameBufferPoolFFmpeg> pool = std::move(block->pool);
+  pool->Return(block);
+}
+
+void CFrameBufferPoolFFmpeg::Return(CBlock* block)
+{
+  CSingleLock lock(m_critSection);
+
+  if (block->size != m_size)
+  {
+    av_free(block->data);
+    delete block;
+    return;
+  }
+  m_free.push_back(block);
+}
+
 //------------------------------------------------------------------------------
 // main class
 //------------------------------------------------------------------------------
@@ -270,7 +390,7 @@ enum AVPixelFormat CDVDVideoCodecFFmpeg::GetFormat(struct AVCodecContext * avctx
   if (ctx->HasHardware())
   {
     ctx->SetHardware(nullptr);
-    avctx->get_buffer2 = avcodec_default_get_buffer2;
+    avctx->get_buffer2 = GetBuffer;
     avctx->slice_flags = 0;
     av_buffer_unref(&avctx->hw_frames_ctx);
   }
@@ -304,10 +424,69 @@ enum AVPixelFormat CDVDVideoCodecFFmpeg::GetFormat(struct AVCodecContext * avctx
   return avcodec_default_get_format(avctx, fmt);
 }
 
+int CDVDVideoCodecFFmpeg::GetBuffer(AVCodecContext* avctx, AVFrame* frame, int flags)
+{
+  ICallbackHWAccel* cb = static_cast<ICallbackHWAccel*>(avctx->opaque);
+  CDVDVideoCodecFFmpeg* ctx = dynamic_cast<CDVDVideoCodecFFmpeg*>(cb);
+
+  // hw surfaces, palettized and bitstream formats are left to ffmpeg
+  AVPixelFormat pixFormat = static_cast<AVPixelFormat>(frame->format);
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(pixFormat);
+  if (!ctx || !desc || (avctx->codec && (avctx->codec->capabilities & AV_CODEC_CAP_DR1) == 0) ||
+      (desc->flags & (AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_BITSTREAM)))
+    return avcodec_default_get_buffer2(avctx, frame, flags);
+
+  int width = frame->width;
+  int height = frame->height;
+  int linesizeAlign[AV_NUM_DATA_POINTERS];
+  avcodec_align_dimensions2(avctx, &width, &height, linesizeAlign);
+
+  // same approach as ffmpeg's default allocator: grow the width until every
+  // line is aligned for simd
+  int linesize[4];
+  int unaligned;
+  do
+  {
+    if (av_image_fill_linesizes(linesize, pixFormat, width) < 0)
+      return avcodec_default_get_buffer2(avctx, frame, flags);
+
+    width += width & ~(width - 1);
+    unaligned = 0;
+    for (int i = 0; i < 4; i++)
+      unaligned |= linesize[i] % FRAME_BUFFER_ALIGN;
+  } while (unaligned);
+
+  uint8_t* data[4];
+  int size = av_image_fill_pointers(data, pixFormat, height, nullptr, linesize);
+  if (size < 0)
+    return avcodec_default_get_buffer2(avctx, frame, flags);
+  size += 16 + FRAME_BUFFER_ALIGN - 1;
+
+  AVBufferRef* buf = ctx->m_frameBufferPool->Get(size);
+  if (!buf)
+    return avcodec_default_get_buffer2(avctx, frame, flags);
+
+  // the padding leaves room to align the first plane, the others follow at aligned offsets
+  uint8_t* base = reinterpret_cast<uint8_t*>(
+      (reinterpret_cast<uintptr_t>(buf->data) + FRAME_BUFFER_ALIGN - 1) &
+      ~static_cast<uintptr_t>(FRAME_BUFFER_ALIGN - 1));
+  av_image_fill_pointers(data, pixFormat, height, base, linesize);
+  for (int i = 0; i < AV_NUM_DATA_POINTERS; i++)
+  {
+    frame->data[i] = i < 4 ? data[i] : nullptr;
+    frame->linesize[i] = i < 4 ? linesize[i] : 0;
+    frame->buf[i] = i == 0 ? buf : nullptr;
+  }
+  frame->extended_data = frame->data;
+
+  return 0;
+}
+
 CDVDVideoCodecFFmpeg::CDVDVideoCodecFFmpeg(CProcessInfo &processInfo)
 : CDVDVideoCodec(processInfo), m_postProc(processInfo)
 {
   m_videoBufferPool = std::make_shared<CVideoBufferPoolFFmpeg>();
+  m_frameBufferPool = std::make_shared<CFrameBufferPoolFFmpeg>();
 
   m_decoderState = STATE_NONE;
 }
@@ -358,6 +537,7 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
   m_pCodecContext->debug = 0;
   m_pCodecContext->workaround_bugs = FF_BUG_AUTODETECT;
   m_pCodecContext->get_format = GetFormat;
+  m_pCodecContext->get_buffer2 = GetBuffer;
   m_pCodecContext->codec_tag = hints.codec_tag;
 
   // setup threading model
@@ -400,6 +580,13 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     m_pCodecContext->skip_loop_filter = static_cast<AVDiscard>(iSkipLoopFilter);
   }
 
+  // nothing but the key frame after a seek is needed, deblocking isn't visible once scaled down
+  if (hints.codecOptions & CODEC_KEYFRAMES_ONLY)
+  {
+    m_pCodecContext->skip_frame = AVDISCARD_NONKEY;
+    m_pCodecContext->skip_loop_filter = AVDISCARD_ALL;
+  }
+
   // set any special options
   for(std::vector<CDVDCodecOption>::iterator it = options.m_keys.begin(); it != options.m_keys.end(); ++it)
   {
@@ -444,11 +631,24 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
 
   m_dropCtrl.Reset(true);
   m_eof = false;
+  m_copiedBytes = 0;
   return true;
 }
 
 void CDVDVideoCodecFFmpeg::Dispose()
 {
+  if (m_pCodecContext)
+  {
+    unsigned int hits, misses;
+    uint64_t allocated;
+    m_frameBufferPool->GetStats(hits, misses, allocated);
+    CLog::Log(LOGDEBUG,
+              "CDVDVideoCodecFFmpeg::Dispose - frame pool hits: %u misses: %u (%.1f%%), "
+              "allocated: %" PRIu64 " bytes, copied: %" PRIu64 " bytes",
+              hits, misses, hits + misses > 0 ? 100.0 * hits / (hits + misses) : 0.0, allocated,
+              m_copiedBytes);
+  }
+
   av_frame_free(&m_pFrame);
   av_frame_free(&m_pDecodedFrame);
   av_frame_free(&m_pFilterFrame);
@@ -868,6 +1068,20 @@ bool CDVDVideoCodecFFmpeg::SetPictureParams(VideoPicture* pVideoPicture)
   {
     m_postProc.SetType(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoPPFFmpegPostProc, false);
     m_postProc.Process(pVideoPicture);
+
+    // post processing renders into a new buffer
+    if (pVideoPicture->videoBuffer != buffer)
+    {
+      int strides[YuvImage::MAX_PLANES];
+      pVideoPicture->videoBuffer->GetStrides(strides);
+      const AVPixFmtDescriptor* desc =
+          av_pix_fmt_desc_get(pVideoPicture->videoBuffer->GetFormat());
+      const int height = pVideoPicture->iHeight;
+      const int chromaHeight =
+          desc ? AV_CEIL_RSHIFT(height, desc->log2_chroma_h) : (height + 1) >> 1;
+      m_copiedBytes += static_cast<uint64_t>(strides[0]) * height +
+                       static_cast<uint64_t>(strides[1] + strides[2]) * chromaHeight;
+    }
   }
 
   return true;
@@ -1283,6 +1497,12 @@ void CDVDVideoCodecFFmpeg::SetCodecControl(int flags)
       m_pCodecContext->skip_idct = AVDISCARD_NONREF;
       m_pCodecContext->skip_loop_filter = AVDISCARD_NONREF;
     }
+    else if (m_hints.codecOptions & CODEC_KEYFRAMES_ONLY)
+    {
+      m_pCodecContext->skip_frame = AVDISCARD_NONKEY;
+      m_pCodecContext->skip_idct = AVDISCARD_DEFAULT;
+      m_pCodecContext->skip_loop_filter = AVDISCARD_ALL;
+    }
     else
     {
       m_pCodecContext->skip_frame = AVDISCARD_DEFAULT;
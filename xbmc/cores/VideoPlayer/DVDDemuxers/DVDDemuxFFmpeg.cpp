@@ -8,6 +8,7 @@
 
 #include "DVDDemuxFFmpeg.h"
 
+#include "DVDDemuxProbeCache.h"
 #include "DVDDemuxUtils.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
@@ -204,6 +205,9 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool fileinf
 {
   AVInputFormat* iformat = NULL;
   std::string strFile;
+  std::string probeCacheKey;
+  CDVDDemuxProbeCache::ProbeInfo probeInfo;
+  bool probeCached = false;
   m_streaminfo = !pInput->IsRealtime() && !m_reopen;
   m_reopen = false;
   m_currentPts = DVD_NOPTS_VALUE;
@@ -346,12 +350,29 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool fileinf
     if (StringUtils::StartsWith(content, "audio/l16"))
       iformat = av_find_input_format("s16be");
 
+    // results of earlier probes of an unchanged file are cached
+    if (seekable && m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE))
+    {
+      probeCacheKey = CDVDDemuxProbeCache::GetKey(strFile);
+      if (!probeCacheKey.empty())
+        probeCached = CDVDDemuxProbeCache::GetInstance().Get(probeCacheKey, probeInfo);
+    }
+
     if (iformat == nullptr)
     {
       // let ffmpeg decide which demuxer we have to open
       bool trySPDIFonly = (m_pInput->GetContent() == "audio/x-spdif-compressed");
 
-      if (!trySPDIFonly)
+      if (!trySPDIFonly && probeCached)
+      {
+        // a format name may be a list like "matroska,webm", the first entry finds the demuxer
+        const std::string formatName = probeInfo.format.substr(0, probeInfo.format.find(','));
+        iformat = av_find_input_format(formatName.c_str());
+        if (iformat)
+          CLog::Log(LOGDEBUG, "%s - using cached input format [%s]", __FUNCTION__, iformat->name);
+      }
+
+      if (!trySPDIFonly && !iformat)
         av_probe_input_buffer(m_ioContext, &iformat, strFile.c_str(), NULL, 0, 0);
 
       // Use the more low-level code in case we have been built against an old
@@ -515,8 +536,28 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool fileinf
     if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
+    // with a known stream layout a short analysis is sufficient to fill in codec parameters
+    const bool shortAnalysis = probeCached && !m_checkTransportStream &&
+                               m_pFormatContext->nb_streams > 0 &&
+                               m_pFormatContext->nb_streams == probeInfo.streams.size() &&
+                               probeInfo.format == m_pFormatContext->iformat->name;
+    if (shortAnalysis)
+      av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
+
     CLog::Log(LOGDEBUG, "%s - avformat_find_stream_info starting", __FUNCTION__);
     int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+    if (shortAnalysis && (iErr < 0 || !MatchesProbeInfo(probeInfo)))
+    {
+      CLog::Log(LOGDEBUG, "%s - cached probe info does not match, running full analysis", __FUNCTION__);
+      CDVDDemuxProbeCache::GetInstance().Remove(probeCacheKey);
+      probeCached = false;
+      av_opt_set_int(m_pFormatContext, "analyzeduration", 0, 0);
+      iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+    }
+    else if (shortAnalysis && m_pFormatContext->duration == AV_NOPTS_VALUE)
+    {
+      m_pFormatContext->duration = probeInfo.duration;
+    }
     if (iErr < 0)
     {
       CLog::Log(LOGWARNING,"could not find codec parameters for %s", CURL::GetRedacted(strFile).c_str());
@@ -536,6 +577,9 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool fileinf
     }
     CLog::Log(LOGDEBUG, "%s - av_find_stream_info finished", __FUNCTION__);
 
+    if (iErr >= 0 && !probeCached && !probeCacheKey.empty() && !m_checkTransportStream)
+      CDVDDemuxProbeCache::GetInstance().Set(probeCacheKey, GetProbeInfo());
+
     // print some extra information
     av_dump_format(m_pFormatContext, 0, CURL::GetRedacted(strFile).c_str(), 0);
 
@@ -646,6 +690,46 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool fileinf
   return true;
 }
 
+bool CDVDDemuxFFmpeg::MatchesProbeInfo(const CDVDDemuxProbeCache::ProbeInfo& info) const
+{
+  if (m_pFormatContext->nb_streams != info.streams.size())
+    return false;
+
+  for (unsigned int i = 0; i < m_pFormatContext->nb_streams; i++)
+  {
+    const AVCodecParameters* codecpar = m_pFormatContext->streams[i]->codecpar;
+    if (codecpar->codec_type != info.streams[i].codecType ||
+        codecpar->codec_id != info.streams[i].codecId)
+      return false;
+
+    // the short analysis must still have found the essential codec parameters
+    if (codecpar->codec_type == AVMEDIA_TYPE_VIDEO && codecpar->width <= 0)
+      return false;
+    if (codecpar->codec_type == AVMEDIA_TYPE_AUDIO &&
+        (codecpar->sample_rate <= 0 || codecpar->channels <= 0))
+      return false;
+  }
+
+  return true;
+}
+
+CDVDDemuxProbeCache::ProbeInfo CDVDDemuxFFmpeg::GetProbeInfo() const
+{
+  CDVDDemuxProbeCache::ProbeInfo info;
+  info.format = m_pFormatContext->iformat->name;
+  info.duration = m_pFormatContext->duration;
+
+  for (unsigned int i = 0; i < m_pFormatContext->nb_streams; i++)
+  {
+    CDVDDemuxProbeCache::StreamInfo stream;
+    stream.codecType = m_pFormatContext->streams[i]->codecpar->codec_type;
+    stream.codecId = m_pFormatContext->streams[i]->codecpar->codec_id;
+    info.streams.push_back(stream);
+  }
+
+  return info;
+}
+
 void CDVDDemuxFFmpeg::Dispose()
 {
   m_pkt.result = -1;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDDemux.h"
+#include "DVDDemuxProbeCache.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 #include <map>
@@ -138,6 +139,8 @@ protected:
   std::string ConvertCodecToInternalStereoMode(const std::string& mode, const StereoModeConversionMap* conversionMap);
 
   void GetL16Parameters(int& channels, int& samplerate);
+  bool MatchesProbeInfo(const CDVDDemuxProbeCache::ProbeInfo& info) const;
+  CDVDDemuxProbeCache::ProbeInfo GetProbeInfo() const;
   double SelectAspect(AVStream* st, bool& forced);
 
   CCriticalSection m_critSection;
@@ -0,0 +1,209 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDDemuxProbeCache.h"
+
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/Digest.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+using KODI::UTILITY::CDigest;
+
+namespace
+{
+const char* PROBE_CACHE_FILE = "special://temp/probecache.xml";
+// version 1 keyed entries by the plain path, including credentials
+constexpr int PROBE_CACHE_VERSION = 2;
+constexpr size_t PROBE_CACHE_MAX_ENTRIES = 500;
+}
+
+CDVDDemuxProbeCache& CDVDDemuxProbeCache::GetInstance()
+{
+  static CDVDDemuxProbeCache instance;
+  return instance;
+}
+
+std::string CDVDDemuxProbeCache::GetKey(const std::string& path)
+{
+  struct __stat64 st;
+  if (XFILE::CFile::Stat(path, &st) != 0 || st.st_size <= 0 || st.st_mtime == 0)
+    return "";
+
+  // the path may contain credentials, which must not end up in the cache file
+  return StringUtils::Format("%s|%lld|%lld", CDigest::Calculate(CDigest::Type::MD5, path).c_str(),
+                             static_cast<long long>(st.st_size),
+                             static_cast<long long>(st.st_mtime));
+}
+
+bool CDVDDemuxProbeCache::Get(const std::string& key, ProbeInfo& info)
+{
+  CSingleLock lock(m_section);
+  Load();
+
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+  {
+    m_misses++;
+    return false;
+  }
+
+  m_hits++;
+  it->second.lastUsed = ++m_useCounter;
+  info = it->second.info;
+  return true;
+}
+
+void CDVDDemuxProbeCache::Set(const std::string& key, const ProbeInfo& info)
+{
+  CSingleLock lock(m_section);
+  Load();
+
+  CacheEntry& entry = m_entries[key];
+  entry.info = info;
+  entry.lastUsed = ++m_useCounter;
+
+  if (m_entries.size() > PROBE_CACHE_MAX_ENTRIES)
+  {
+    auto oldest = std::min_element(m_entries.begin(), m_entries.end(),
+                                   [](const auto& a, const auto& b) {
+                                     return a.second.lastUsed < b.second.lastUsed;
+                                   });
+    m_entries.erase(oldest);
+  }
+
+  ScheduleSave();
+}
+
+void CDVDDemuxProbeCache::Remove(const std::string& key)
+{
+  CSingleLock lock(m_section);
+  Load();
+
+  if (m_entries.erase(key) > 0)
+    ScheduleSave();
+}
+
+void CDVDDemuxProbeCache::GetStats(unsigned int& hits, unsigned int& misses) const
+{
+  CSingleLock lock(m_section);
+  hits = m_hits;
+  misses = m_misses;
+}
+
+void CDVDDemuxProbeCache::Load()
+{
+  if (m_loaded)
+    return;
+  m_loaded = true;
+
+  if (!XFILE::CFile::Exists(PROBE_CACHE_FILE))
+    return;
+
+  CXBMCTinyXML doc;
+  if (!doc.LoadFile(PROBE_CACHE_FILE))
+  {
+    CLog::Log(LOGWARNING, "CDVDDemuxProbeCache::Load - unable to load %s (row %i column %i)",
+              PROBE_CACHE_FILE, doc.Row(), doc.Column());
+    return;
+  }
+
+  const TiXmlElement* root = doc.RootElement();
+  if (!root || strcmp(root->Value(), "probecache") != 0)
+    return;
+
+  // entries of older versions are dropped, together with the credentials they may contain
+  int version = 0;
+  root->Attribute("version", &version);
+  if (version != PROBE_CACHE_VERSION)
+  {
+    XFILE::CFile::Delete(PROBE_CACHE_FILE);
+    return;
+  }
+
+  for (const TiXmlElement* entry = root->FirstChildElement("entry"); entry;
+       entry = entry->NextSiblingElement("entry"))
+  {
+    const char* key = entry->Attribute("key");
+    const char* format = entry->Attribute("format");
+    if (!key || !format)
+      continue;
+
+    CacheEntry& cacheEntry = m_entries[key];
+    cacheEntry.info.format = format;
+    const char* duration = entry->Attribute("duration");
+    if (duration)
+      cacheEntry.info.duration = strtoll(duration, nullptr, 10);
+
+    for (const TiXmlElement* stream = entry->FirstChildElement("stream"); stream;
+         stream = stream->NextSiblingElement("stream"))
+    {
+      StreamInfo info;
+      stream->Attribute("type", &info.codecType);
+      stream->Attribute("codec", &info.codecId);
+      cacheEntry.info.streams.push_back(info);
+    }
+    cacheEntry.lastUsed = ++m_useCounter;
+  }
+}
+
+void CDVDDemuxProbeCache::ScheduleSave()
+{
+  // saving rewrites the whole file, keep that off the demuxer's open path
+  m_dirty = true;
+  if (m_saveScheduled)
+    return;
+
+  m_saveScheduled = true;
+  CJobManager::GetInstance().Submit([this]() { Save(); });
+}
+
+void CDVDDemuxProbeCache::Save()
+{
+  CSingleLock saveLock(m_saveSection);
+
+  CXBMCTinyXML doc;
+  TiXmlElement root("probecache");
+  root.SetAttribute("version", PROBE_CACHE_VERSION);
+
+  {
+    CSingleLock lock(m_section);
+    m_saveScheduled = false;
+    if (!m_dirty)
+      return;
+    m_dirty = false;
+
+    for (const auto& it : m_entries)
+    {
+      TiXmlElement entry("entry");
+      entry.SetAttribute("key", it.first);
+      entry.SetAttribute("format", it.second.info.format);
+      entry.SetAttribute("duration", std::to_string(it.second.info.duration));
+
+      for (const auto& stream : it.second.info.streams)
+      {
+        TiXmlElement streamElement("stream");
+        streamElement.SetAttribute("type", stream.codecType);
+        streamElement.SetAttribute("codec", stream.codecId);
+        entry.InsertEndChild(streamElement);
+      }
+      root.InsertEndChild(entry);
+    }
+  }
+  doc.InsertEndChild(root);
+
+  if (!doc.SaveFile(PROBE_CACHE_FILE))
+    CLog::Log(LOGWARNING, "CDVDDemuxProbeCache::Save - unable to save %s", PROBE_CACHE_FILE);
+}
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Persistent cache of container probe results.
+ *
+ * Remembers the input format and stream layout detected by CDVDDemuxFFmpeg for a file,
+ * keyed by a hash of the path, size and modification time. On a hit the demuxer can skip format probing
+ * and shorten stream info analysis, which saves several round trips on network shares.
+ */
+class CDVDDemuxProbeCache
+{
+public:
+  struct StreamInfo
+  {
+    int codecType = -1; //!< AVMediaType
+    int codecId = 0; //!< AVCodecID
+  };
+
+  struct ProbeInfo
+  {
+    std::string format; //!< name of the AVInputFormat
+    int64_t duration = 0; //!< in AV_TIME_BASE units
+    std::vector<StreamInfo> streams;
+  };
+
+  static CDVDDemuxProbeCache& GetInstance();
+
+  /*!
+   * \brief Build the cache key for a file, empty if the file can not be stat'ed.
+   */
+  static std::string GetKey(const std::string& path);
+
+  bool Get(const std::string& key, ProbeInfo& info);
+  void Set(const std::string& key, const ProbeInfo& info);
+  void Remove(const std::string& key);
+
+  void GetStats(unsigned int& hits, unsigned int& misses) const;
+
+private:
+  CDVDDemuxProbeCache() = default;
+
+  void Load();
+  void ScheduleSave();
+  void Save();
+
+  struct CacheEntry
+  {
+    ProbeInfo info;
+    uint64_t lastUsed = 0;
+  };
+
+  mutable CCriticalSection m_section;
+  CCriticalSection m_saveSection; //!< serializes writing the file
+  std::map<std::string, CacheEntry> m_entries;
+  uint64_t m_useCounter = 0;
+  unsigned int m_hits = 0;
+  unsigned int m_misses = 0;
+  bool m_loaded = false;
+  bool m_dirty = false;
+  bool m_saveScheduled = false;
+};
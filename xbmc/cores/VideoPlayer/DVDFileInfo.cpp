@@ -86,11 +86,131 @@ int DegreeToOrientation(int degrees)
   }
 }
 
+namespace
+{
+
+CDVDVideoCodec* OpenThumbCodec(CDVDStreamInfo& hint, CProcessInfo& processInfo, bool keyFramesOnly)
+{
+  hint.codecOptions = CODEC_FORCE_SOFTWARE;
+  if (keyFramesOnly)
+    hint.codecOptions |= CODEC_KEYFRAMES_ONLY;
+  return CDVDFactoryCodec::CreateVideoCodec(hint, processInfo);
+}
+
+bool DecodeThumb(CDVDDemux& demuxer,
+                 CDVDVideoCodec& codec,
+                 int nVideoStream,
+                 bool keyFramesOnly,
+                 VideoPicture& picture,
+                 int& packetsTried)
+{
+  codec.Reset();
+
+  bool bOk = false;
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  int abort_index = demuxer.GetNrOfStreams() * 160;
+  do
+  {
+    DemuxPacket* pPacket = demuxer.Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != nVideoStream)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    codec.AddData(*pPacket);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    // frames following the key frame are skipped, so a decoder delaying output for reordering
+    // would hold it back until the next key frame. Drain after each packet instead, a drained
+    // decoder is reset by the next AddData.
+    if (keyFramesOnly)
+      codec.SetCodecControl(DVD_CODEC_CTRL_DRAIN);
+
+    CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+    while (iDecoderState == CDVDVideoCodec::VC_NONE)
+    {
+      iDecoderState = codec.GetPicture(&picture);
+    }
+
+    if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
+      bOk = true;
+
+  } while (!bOk && abort_index--);
+
+  if (keyFramesOnly)
+    codec.SetCodecControl(0);
+
+  return bOk;
+}
+
+bool CacheThumb(VideoPicture& picture, const CDVDStreamInfo& hint, CTextureDetails& details)
+{
+  bool bOk = false;
+  unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
+  double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+  if(hint.forced_aspect && hint.aspect != 0)
+    aspect = hint.aspect;
+  unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+  uint8_t *pOutBuf = (uint8_t*)av_malloc(nWidth * nHeight * 4);
+  struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
+        AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
+
+  if (context)
+  {
+    uint8_t *planes[YuvImage::MAX_PLANES];
+    int stride[YuvImage::MAX_PLANES];
+    picture.videoBuffer->GetPlanes(planes);
+    picture.videoBuffer->GetStrides(stride);
+    uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
+    int srcStride[] = { stride[0], stride[1], stride[2], 0 };
+    uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
+    int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
+    int orientation = DegreeToOrientation(hint.orientation);
+    sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
+    sws_freeContext(context);
+
+    details.width = nWidth;
+    details.height = nHeight;
+    CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
+    bOk = true;
+  }
+  av_free(pOutBuf);
+  return bOk;
+}
+
+void CacheEmptyThumb(const CTextureDetails& details)
+{
+  XFILE::CFile file;
+  if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
+    file.Close();
+}
+
+} // unnamed namespace
+
 bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
                                 CTextureDetails &details,
                                 CStreamDetails *pStreamDetails,
                                 int64_t pos)
 {
+  std::vector<ThumbPosition> positions = {{pos, &details, false}};
+  return ExtractThumbs(fileItem, positions, pStreamDetails) > 0;
+}
+
+unsigned int CDVDFileInfo::ExtractThumbs(const CFileItem& fileItem,
+                                         std::vector<ThumbPosition>& positions,
+                                         CStreamDetails* pStreamDetails,
+                                         const std::function<bool(size_t)>& progress)
+{
+  for (auto& position : positions)
+    position.extracted = false;
+
   const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
   unsigned int nTime = XbmcThreads::SystemClockMillis();
 
@@ -100,13 +220,13 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
   if (!pInputStream)
   {
     CLog::Log(LOGERROR, "InputStream: Error creating stream for %s", redactPath.c_str());
-    return false;
+    return 0;
   }
 
   if (!pInputStream->Open())
   {
     CLog::Log(LOGERROR, "InputStream: Error opening, %s", redactPath.c_str());
-    return false;
+    return 0;
   }
 
   CDVDDemux *pDemuxer = NULL;
@@ -117,7 +237,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if(!pDemuxer)
     {
       CLog::Log(LOGERROR, "%s - Error creating demuxer", __FUNCTION__);
-      return false;
+      return 0;
     }
   }
   catch(...)
@@ -126,7 +246,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if (pDemuxer)
       delete pDemuxer;
 
-    return false;
+    return 0;
   }
 
   if (pStreamDetails)
@@ -181,123 +301,82 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     }
   }
 
-  bool bOk = false;
+  unsigned int extracted = 0;
+  size_t processed = 0;
+  bool aborted = false;
   int packetsTried = 0;
 
   if (nVideoStream != -1)
   {
-    CDVDVideoCodec *pVideoCodec;
     std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
     std::vector<AVPixelFormat> pixFmts;
     pixFmts.push_back(AV_PIX_FMT_YUV420P);
     pProcessInfo->SetPixFormats(pixFmts);
 
     CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
-    hint.codecOptions = CODEC_FORCE_SOFTWARE;
-
-    pVideoCodec = CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
+    bool keyFramesOnly = true;
+    std::unique_ptr<CDVDVideoCodec> pVideoCodec(OpenThumbCodec(hint, *pProcessInfo, keyFramesOnly));
 
     if (pVideoCodec)
     {
       int nTotalLen = pDemuxer->GetStreamLength();
-      int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
+      VideoPicture picture = {};
 
-      CLog::Log(LOGDEBUG, "%s - seeking to pos %lldms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
-      if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+      for (; processed < positions.size(); processed++)
       {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
+        ThumbPosition& position = positions[processed];
+        int64_t nSeekTo = (position.pos == -1) ? nTotalLen / 3 : position.pos;
 
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
+        CLog::Log(LOGDEBUG, "%s - seeking to pos %lldms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
+        if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
         {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
-
-          if (!pPacket)
-            break;
-
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
-
-          pVideoCodec->AddData(*pPacket);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
-
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+          bool decoded = DecodeThumb(*pDemuxer, *pVideoCodec, nVideoStream, keyFramesOnly, picture, packetsTried);
+          if (!decoded && keyFramesOnly && extracted == 0)
           {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
+            // e.g. streams without flagged key frames, fall back to decoding everything
+            CLog::Log(LOGDEBUG, "%s - no key frame decoded in %s, retrying with all frames", __FUNCTION__, redactPath.c_str());
+            keyFramesOnly = false;
+            picture.Reset();
+            pVideoCodec.reset(OpenThumbCodec(hint, *pProcessInfo, keyFramesOnly));
+            if (!pVideoCodec)
               break;
+            if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+              decoded = DecodeThumb(*pDemuxer, *pVideoCodec, nVideoStream, keyFramesOnly, picture, packetsTried);
           }
 
-        } while (abort_index--);
-
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
-        {
-          {
-            unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-            uint8_t *pOutBuf = (uint8_t*)av_malloc(nWidth * nHeight * 4);
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *planes[YuvImage::MAX_PLANES];
-              int stride[YuvImage::MAX_PLANES];
-              picture.videoBuffer->GetPlanes(planes);
-              picture.videoBuffer->GetStrides(stride);
-              uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
-              int srcStride[] = { stride[0], stride[1], stride[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
-          }
+          if (decoded)
+            position.extracted = CacheThumb(picture, hint, *position.details);
+          else
+            CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
         }
+
+        if (position.extracted)
+          extracted++;
         else
+          CacheEmptyThumb(*position.details);
+
+        if (progress && !progress(processed))
         {
-          CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
+          aborted = true;
+          break;
         }
       }
-      delete pVideoCodec;
     }
   }
 
   if (pDemuxer)
     delete pDemuxer;
 
-  if(!bOk)
+  // no decoder for the remaining positions, don't try again
+  if (!aborted)
   {
-    XFILE::CFile file;
-    if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
-      file.Close();
+    for (; processed < positions.size(); processed++)
+      CacheEmptyThumb(*positions[processed].details);
   }
 
   unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
-  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, redactPath.c_str(), packetsTried);
-  return bOk;
+  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract %u of %u thumbs from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, extracted, static_cast<unsigned int>(positions.size()), redactPath.c_str(), packetsTried);
+  return extracted;
 }
 
 /**
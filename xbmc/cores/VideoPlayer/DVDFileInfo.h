@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +29,27 @@ public:
                            CStreamDetails *pStreamDetails,
                            int64_t pos);
 
+  struct ThumbPosition
+  {
+    int64_t pos; ///< position in ms, -1 for a third into the file
+    CTextureDetails* details; ///< details->file is the cache file, width and height are filled in
+    bool extracted;
+  };
+
+  /*!
+   \brief Extract thumbnails at several positions of the media referenced by fileItem in one pass,
+   e.g. of all its chapters. The file and decoder are opened once and only the key frame at or
+   before each position is decoded. Positions are processed in the given order, pass them
+   ascending to avoid seeking back. A position that fails gets an empty cache file, just like
+   ExtractThumb().
+   \param progress called after each position with its index, return false to abort
+   \return number of extracted thumbnails
+   */
+  static unsigned int ExtractThumbs(const CFileItem& fileItem,
+                                    std::vector<ThumbPosition>& positions,
+                                    CStreamDetails* pStreamDetails,
+                                    const std::function<bool(size_t)>& progress = nullptr);
+
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
   static bool DemuxerToStreamDetails(std::shared_ptr<CDVDInputStream> pInputStream, CDVDDemux *pDemux, CStreamDetails &details, const std::string &path = "");
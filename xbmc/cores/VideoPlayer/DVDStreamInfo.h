@@ -16,6 +16,7 @@ extern "C" {
 
 #define CODEC_FORCE_SOFTWARE 0x01
 #define CODEC_ALLOW_FALLBACK 0x02
+#define CODEC_KEYFRAMES_ONLY 0x04 // decode key frames only, e.g. for thumbnails
 
 class CDemuxStream;
 struct DemuxCryptoSession;
@@ -20,6 +20,33 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+namespace
+{
+// how far ahead the worker renders
+const long long PRERENDER_TIME_MS = 5000;
+// images rendered per wakeup of the worker, typesetting can start many events at once
+const size_t PRERENDER_FRAMES = 16;
+const size_t MAX_CACHE_SIZE = 64 * 1024 * 1024;
+
+bool IsAnimated(const ASS_Event& event)
+{
+  if (event.Effect && *event.Effect)
+    return true; // scrolling and banner effects
+  if (!event.Text)
+    return false;
+  for (const char* tag : {"\\t(", "\\move", "\\fad", "\\k", "\\K"})
+  {
+    if (strstr(event.Text, tag))
+      return true;
+  }
+  return false;
+}
+} // unnamed namespace
+
 static void libass_log(int level, const char *fmt, va_list args, void *data)
 {
   if(level >= 5)
@@ -28,7 +55,7 @@ static void libass_log(int level, const char *fmt, va_list args, void *data)
   CLog::Log(LOGDEBUG, "CDVDSubtitlesLibass: [ass] %s", log.c_str());
 }
 
-CDVDSubtitlesLibass::CDVDSubtitlesLibass()
+CDVDSubtitlesLibass::CDVDSubtitlesLibass() : CThread("LibassPrerender")
 {
   //Setting the font directory to the temp dir(where mkv fonts are extracted to)
   std::string strPath = "special://temp/fonts/";
@@ -73,6 +100,7 @@ CDVDSubtitlesLibass::CDVDSubtitlesLibass()
 
 CDVDSubtitlesLibass::~CDVDSubtitlesLibass()
 {
+  StopThread();
   if(m_track)
     ass_free_track(m_track);
   ass_renderer_done(m_renderer);
@@ -93,6 +121,7 @@ bool CDVDSubtitlesLibass::DecodeHeader(char* data, int size)
   }
 
   ass_process_codec_private(m_track, data, size);
+  IndexEvents();
   return true;
 }
 
@@ -107,6 +136,7 @@ bool CDVDSubtitlesLibass::DecodeDemuxPkt(const char* data, int size, double star
 
   //! @bug libass isn't const correct
   ass_process_chunk(m_track, const_cast<char*>(data), size, DVD_TIME_TO_MSEC(start), DVD_TIME_TO_MSEC(duration));
+  IndexEvents();
   return true;
 }
 
@@ -125,12 +155,53 @@ bool CDVDSubtitlesLibass::CreateTrack(char* buf, size_t size)
   if(m_track == NULL)
     return false;
 
+  IndexEvents();
   return true;
 }
 
 ASS_Image* CDVDSubtitlesLibass::RenderImage(int frameWidth, int frameHeight, int videoWidth, int videoHeight, int sourceWidth, int sourceHeight,
                                             double pts, int useMargin, double position, int *changes)
 {
+  SFrameKey key;
+  key.params.frameWidth = frameWidth;
+  key.params.frameHeight = frameHeight;
+  key.params.videoWidth = videoWidth;
+  key.params.videoHeight = videoHeight;
+  key.params.sourceWidth = sourceWidth;
+  key.params.sourceHeight = sourceHeight;
+  key.params.useMargin = useMargin;
+  key.params.position = position;
+  const long long time = DVD_TIME_TO_MSEC(pts);
+
+  std::shared_ptr<SFrame> frame;
+  bool animated;
+  {
+    CSingleLock lock(m_cacheSection);
+    m_params = key.params;
+    m_hasParams = true;
+    m_renderTime = time;
+    animated = GetActiveEvents(time, key.events);
+    if (!animated)
+    {
+      auto it = m_cache.find(key);
+      if (it != m_cache.end())
+      {
+        frame = it->second;
+        frame->lastUsed = ++m_useCounter;
+        m_stats.hits++;
+        SetLastFrame(frame, animated, changes);
+      }
+    }
+  }
+
+  if (!IsRunning())
+    Create();
+  m_wakeWorker.Set();
+
+  // a hit doesn't wait for a frame the worker is rendering
+  if (frame)
+    return frame->images.empty() ? nullptr : frame->images.data();
+
   CSingleLock lock(m_section);
   if(!m_renderer || !m_track)
   {
@@ -138,16 +209,210 @@ ASS_Image* CDVDSubtitlesLibass::RenderImage(int frameWidth, int frameHeight, int
     return NULL;
   }
 
-  double sar = (double)sourceWidth / sourceHeight;
-  double dar = (double)videoWidth / videoHeight;
-  ass_set_frame_size(m_renderer, frameWidth, frameHeight);
-  int topmargin = (frameHeight - videoHeight) / 2;
-  int leftmargin = (frameWidth - videoWidth) / 2;
+  ApplyParams(key.params);
+  int assChanges = 0;
+  ASS_Image* images = ass_render_frame(m_renderer, m_track, time, &assChanges);
+
+  CSingleLock cacheLock(m_cacheSection);
+  // libass compares with the last frame it rendered, which may have been the worker's
+  if (assChanges == 0 && m_lastFrameLive && !m_workerRendered && m_lastFrame)
+    frame = m_lastFrame;
+  else
+  {
+    frame = CopyFrame(images);
+    if (!animated)
+      AddToCache(key, frame);
+  }
+  m_workerRendered = false;
+  m_stats.misses++;
+
+  SetLastFrame(frame, animated, changes);
+  return frame->images.empty() ? nullptr : frame->images.data();
+}
+
+void CDVDSubtitlesLibass::SetLastFrame(const std::shared_ptr<SFrame>& frame,
+                                       bool animated,
+                                       int* changes)
+{
+  if (changes)
+    *changes = frame == m_lastFrame ? 0 : 2;
+  m_lastFrameLive = animated;
+  m_lastFrame = frame;
+}
+
+void CDVDSubtitlesLibass::Process()
+{
+  while (!m_bStop)
+  {
+    AbortableWait(m_wakeWorker, 1000);
+
+    std::vector<std::pair<long long, SFrameKey>> todo;
+    {
+      CSingleLock lock(m_cacheSection);
+      if (!m_hasParams)
+        continue;
+
+      // the shown events only change where one starts or ends
+      std::vector<long long> times;
+      const long long end = m_renderTime + PRERENDER_TIME_MS;
+      for (const SEvent& event : m_events)
+      {
+        if (event.start > m_renderTime && event.start <= end)
+          times.push_back(event.start);
+        if (event.end > m_renderTime && event.end <= end)
+          times.push_back(event.end);
+      }
+      std::sort(times.begin(), times.end());
+      times.erase(std::unique(times.begin(), times.end()), times.end());
+
+      for (long long time : times)
+      {
+        SFrameKey key;
+        key.params = m_params;
+        if (GetActiveEvents(time, key.events) || m_cache.find(key) != m_cache.end())
+          continue;
+        if (std::find_if(todo.begin(), todo.end(), [&key](const std::pair<long long, SFrameKey>& item) {
+              return !(item.second < key) && !(key < item.second);
+            }) != todo.end())
+          continue;
+        todo.emplace_back(time, key);
+        if (todo.size() >= PRERENDER_FRAMES)
+          break;
+      }
+    }
+
+    for (const auto& item : todo)
+    {
+      if (m_bStop)
+        break;
+
+      CSingleLock lock(m_section);
+      if (!m_renderer || !m_track)
+        break;
+      ApplyParams(item.second.params);
+      ASS_Image* images = ass_render_frame(m_renderer, m_track, item.first, nullptr);
+      std::shared_ptr<SFrame> frame = CopyFrame(images);
+
+      CSingleLock cacheLock(m_cacheSection);
+      m_workerRendered = true;
+      if (item.second.params == m_params)
+      {
+        AddToCache(item.second, frame);
+        m_stats.prerendered++;
+      }
+    }
+  }
+}
+
+CDVDSubtitlesLibass::SCacheStats CDVDSubtitlesLibass::GetCacheStats()
+{
+  CSingleLock lock(m_cacheSection);
+  return m_stats;
+}
+
+void CDVDSubtitlesLibass::ApplyParams(const SRenderParams& params)
+{
+  double sar = (double)params.sourceWidth / params.sourceHeight;
+  double dar = (double)params.videoWidth / params.videoHeight;
+  ass_set_frame_size(m_renderer, params.frameWidth, params.frameHeight);
+  int topmargin = (params.frameHeight - params.videoHeight) / 2;
+  int leftmargin = (params.frameWidth - params.videoWidth) / 2;
   ass_set_margins(m_renderer, topmargin, topmargin, leftmargin, leftmargin);
-  ass_set_use_margins(m_renderer, useMargin);
-  ass_set_line_position(m_renderer, position);
+  ass_set_use_margins(m_renderer, params.useMargin);
+  ass_set_line_position(m_renderer, params.position);
   ass_set_aspect_ratio(m_renderer, dar, sar);
-  return ass_render_frame(m_renderer, m_track, DVD_TIME_TO_MSEC(pts), changes);
+}
+
+std::shared_ptr<CDVDSubtitlesLibass::SFrame> CDVDSubtitlesLibass::CopyFrame(const ASS_Image* images)
+{
+  std::shared_ptr<SFrame> frame = std::make_shared<SFrame>();
+  for (const ASS_Image* image = images; image; image = image->next)
+  {
+    // packed rows, the stride of libass is padded for SIMD
+    std::unique_ptr<unsigned char[]> bitmap(new unsigned char[image->w * image->h]);
+    for (int y = 0; y < image->h; y++)
+      memcpy(bitmap.get() + y * image->w, image->bitmap + y * image->stride, image->w);
+
+    ASS_Image copy = *image;
+    copy.stride = image->w;
+    copy.bitmap = bitmap.get();
+    frame->images.push_back(copy);
+    frame->bitmaps.push_back(std::move(bitmap));
+    frame->size += image->w * image->h + sizeof(ASS_Image);
+  }
+  for (size_t i = 0; i < frame->images.size(); i++)
+    frame->images[i].next = i + 1 < frame->images.size() ? &frame->images[i + 1] : nullptr;
+  return frame;
+}
+
+void CDVDSubtitlesLibass::IndexEvents()
+{
+  CSingleLock lock(m_cacheSection);
+  if (static_cast<int>(m_events.size()) > m_track->n_events)
+  {
+    // events were dropped, the indices of the cached event sets are stale
+    m_events.clear();
+    m_cache.clear();
+    m_cacheSize = 0;
+  }
+  for (int i = m_events.size(); i < m_track->n_events; i++)
+  {
+    const ASS_Event& event = m_track->events[i];
+    m_events.push_back({event.Start, event.Start + event.Duration, IsAnimated(event)});
+  }
+}
+
+bool CDVDSubtitlesLibass::GetActiveEvents(long long time, std::vector<int>& events) const
+{
+  bool animated = false;
+  for (size_t i = 0; i < m_events.size(); i++)
+  {
+    const SEvent& event = m_events[i];
+    if (event.start <= time && time < event.end)
+    {
+      events.push_back(i);
+      animated |= event.animated;
+    }
+  }
+  return animated;
+}
+
+void CDVDSubtitlesLibass::AddToCache(const SFrameKey& key, const std::shared_ptr<SFrame>& frame)
+{
+  frame->lastUsed = ++m_useCounter;
+  auto result = m_cache.insert(std::make_pair(key, frame));
+  if (!result.second)
+    return;
+  m_cacheSize += frame->size;
+
+  while (m_cacheSize > MAX_CACHE_SIZE && m_cache.size() > 1)
+  {
+    auto oldest = m_cache.begin();
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+    {
+      if (it->second->lastUsed < oldest->second->lastUsed)
+        oldest = it;
+    }
+    m_cacheSize -= oldest->second->size;
+    m_cache.erase(oldest);
+  }
+}
+
+bool CDVDSubtitlesLibass::SRenderParams::operator<(const SRenderParams& right) const
+{
+  return std::tie(frameWidth, frameHeight, videoWidth, videoHeight, sourceWidth, sourceHeight, useMargin, position) <
+         std::tie(right.frameWidth, right.frameHeight, right.videoWidth, right.videoHeight,
+                  right.sourceWidth, right.sourceHeight, right.useMargin, right.position);
+}
+
+bool CDVDSubtitlesLibass::SRenderParams::operator==(const SRenderParams& right) const
+{
+  return !(*this < right) && !(right < *this);
+}
+
+bool CDVDSubtitlesLibass::SFrameKey::operator<(const SFrameKey& right) const
+{
+  return std::tie(params, events) < std::tie(right.params, right.events);
 }
 
 ASS_Event* CDVDSubtitlesLibass::GetEvents()
@@ -10,17 +10,40 @@
 
 #include "DVDResource.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <map>
+#include <memory>
+#include <vector>
 
 #include <ass/ass.h>
 
 /** Wrapper for Libass **/
 
-class CDVDSubtitlesLibass : public IDVDResourceCounted<CDVDSubtitlesLibass>
+/*!
+ Subtitles are rendered ahead of time by a worker thread: for the points in the next
+ seconds where the set of shown events changes, the images are rendered and kept in a
+ cache keyed by the event set and the render parameters. Events with animations are
+ always rendered when needed, their images depend on the exact time.
+ */
+class CDVDSubtitlesLibass : public IDVDResourceCounted<CDVDSubtitlesLibass>, private CThread
 {
 public:
+  struct SCacheStats
+  {
+    unsigned int hits = 0;
+    unsigned int misses = 0;
+    unsigned int prerendered = 0;
+  };
+
   CDVDSubtitlesLibass();
   ~CDVDSubtitlesLibass() override;
 
+  /*!
+   \brief Render the subtitles at the given time.
+   \return the images, valid until the next call
+   */
   ASS_Image* RenderImage(int frameWidth, int frameHeight, int videoWidth, int videoHeight, int sourceWidth, int sourceHeight,
                          double pts, int useMargin = 0, double position = 0.0, int* changes = NULL);
   ASS_Event* GetEvents();
@@ -31,10 +54,75 @@ public:
   bool DecodeDemuxPkt(const char* data, int size, double start, double duration);
   bool CreateTrack(char* buf, size_t size);
 
+  SCacheStats GetCacheStats();
+
+protected:
+  void Process() override;
+
 private:
+  struct SRenderParams
+  {
+    int frameWidth = 0;
+    int frameHeight = 0;
+    int videoWidth = 0;
+    int videoHeight = 0;
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+    int useMargin = 0;
+    double position = 0.0;
+
+    bool operator<(const SRenderParams& right) const;
+    bool operator==(const SRenderParams& right) const;
+  };
+
+  struct SEvent
+  {
+    long long start;
+    long long end;
+    bool animated;
+  };
+
+  struct SFrameKey
+  {
+    SRenderParams params;
+    std::vector<int> events;
+
+    bool operator<(const SFrameKey& right) const;
+  };
+
+  //! images copied out of libass, which reuses its own on the next render
+  struct SFrame
+  {
+    std::vector<ASS_Image> images;
+    std::vector<std::unique_ptr<unsigned char[]>> bitmaps;
+    size_t size = 0;
+    unsigned int lastUsed = 0;
+  };
+
+  void ApplyParams(const SRenderParams& params);
+  std::shared_ptr<SFrame> CopyFrame(const ASS_Image* images);
+  void IndexEvents();
+  bool GetActiveEvents(long long time, std::vector<int>& events) const;
+  void AddToCache(const SFrameKey& key, const std::shared_ptr<SFrame>& frame);
+  void SetLastFrame(const std::shared_ptr<SFrame>& frame, bool animated, int* changes);
+
   ASS_Library* m_library = nullptr;
   ASS_Track* m_track = nullptr;
   ASS_Renderer* m_renderer = nullptr;
   CCriticalSection m_section;
-};
 
+  // taken after m_section, if both are needed
+  CCriticalSection m_cacheSection;
+  bool m_workerRendered = false;
+  std::shared_ptr<SFrame> m_lastFrame;
+  bool m_lastFrameLive = false;
+  std::vector<SEvent> m_events;
+  std::map<SFrameKey, std::shared_ptr<SFrame>> m_cache;
+  size_t m_cacheSize = 0;
+  unsigned int m_useCounter = 0;
+  SRenderParams m_params;
+  bool m_hasParams = false;
+  long long m_renderTime = 0;
+  SCacheStats m_stats;
+  CEvent m_wakeWorker;
+};
@@ -13,6 +13,8 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
 
 CCriticalSection createSection;
 std::map<std::string, CreateProcessControl> CProcessInfo::m_processControls;
@@ -596,6 +598,47 @@ int CProcessInfo::GetLevelVQ()
   return m_levelVQ;
 }
 
+//******************************************************************************
+// startup timing
+//******************************************************************************
+void CProcessInfo::ResetStartupTiming()
+{
+  m_startupPacketTime = 0;
+  m_startupFrameTime = 0;
+  m_startupOpenTime = XbmcThreads::SystemClockMillis();
+}
+
+void CProcessInfo::SetStartupFirstPacket()
+{
+  unsigned int expected = 0;
+  m_startupPacketTime.compare_exchange_strong(expected, XbmcThreads::SystemClockMillis());
+}
+
+void CProcessInfo::SetStartupFirstFrame()
+{
+  if (m_startupPacketTime == 0)
+    return;
+
+  unsigned int expected = 0;
+  if (m_startupFrameTime.compare_exchange_strong(expected, XbmcThreads::SystemClockMillis()))
+  {
+    int openToPacket, packetToFrame;
+    GetStartupTiming(openToPacket, packetToFrame);
+    CLog::Log(LOGDEBUG, "CProcessInfo::SetStartupFirstFrame - open->first packet: %d ms, first packet->first frame: %d ms",
+              openToPacket, packetToFrame);
+  }
+}
+
+void CProcessInfo::GetStartupTiming(int& openToPacket, int& packetToFrame)
+{
+  const unsigned int open = m_startupOpenTime;
+  const unsigned int packet = m_startupPacketTime;
+  const unsigned int frame = m_startupFrameTime;
+
+  openToPacket = (open && packet) ? static_cast<int>(packet - open) : -1;
+  packetToFrame = (packet && frame) ? static_cast<int>(frame - packet) : -1;
+}
+
 void CProcessInfo::SetGuiRender(bool gui)
 {
   CSingleLock lock(m_stateSection);
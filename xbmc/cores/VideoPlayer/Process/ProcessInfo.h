@@ -106,6 +106,17 @@ public:
   void SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max);
   int64_t GetMaxTime();
 
+  // startup timing
+  void ResetStartupTiming();
+  void SetStartupFirstPacket();
+  void SetStartupFirstFrame();
+  /*!
+   * \brief Get the latency of playback startup stages in ms, -1 if a stage was not reached yet
+   * \param openToPacket time from start of opening the input until the first demuxed packet
+   * \param packetToFrame time from the first demuxed packet until the first decoded frame
+   */
+  void GetStartupTiming(int& openToPacket, int& packetToFrame);
+
   // settings
   CVideoSettings GetVideoSettings();
   void SetVideoSettings(CVideoSettings &settings);
@@ -165,6 +176,11 @@ protected:
   int64_t m_timeMin;
   bool m_realTimeStream;
 
+  // startup timing
+  std::atomic<unsigned int> m_startupOpenTime{0};
+  std::atomic<unsigned int> m_startupPacketTime{0};
+  std::atomic<unsigned int> m_startupFrameTime{0};
+
   // settings
   CCriticalSection m_settingsSection;
   CVideoSettings m_videoSettings;
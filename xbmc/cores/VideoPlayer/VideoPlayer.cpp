@@ -51,6 +51,7 @@
 #include "settings/MediaSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "settings/lib/SettingHandle.h"
 #include "utils/log.h"
 #include "utils/StreamDetails.h"
 #include "utils/StreamUtils.h"
@@ -59,6 +60,7 @@
 #include "dialogs/GUIDialogKaiToast.h"
 #include "utils/JobManager.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "video/Bookmark.h"
 #include "video/VideoInfoTag.h"
 #include "Util.h"
@@ -603,6 +605,12 @@ CVideoPlayer::CVideoPlayer(IPlayerCallback& callback)
       m_renderManager(m_clock, this)
 {
   m_outboundEvents.reset(new CJobQueue(false, 1, CJob::PRIORITY_NORMAL));
+  CSettingsManager& settingsManager =
+      *CServiceBroker::GetSettingsComponent()->GetSettings()->GetSettingsManager();
+  m_parseCaptions.reset(
+      new CSettingHandle<CSettingBool>(settingsManager, CSettings::SETTING_SUBTITLES_PARSECAPTIONS));
+  m_useDisplayAsClock.reset(new CSettingHandle<CSettingBool>(
+      settingsManager, CSettings::SETTING_VIDEOPLAYER_USEDISPLAYASCLOCK));
   m_players_created = false;
   m_pDemuxer = nullptr;
   m_pSubtitleDemuxer = nullptr;
@@ -1194,6 +1202,7 @@ void CVideoPlayer::Prepare()
   m_offset_pts = 0;
   m_CurrentAudio.lastdts = DVD_NOPTS_VALUE;
   m_CurrentVideo.lastdts = DVD_NOPTS_VALUE;
+  m_processInfo->ResetStartupTiming();
 
   IPlayerCallback *cb = &m_callback;
   CFileItem fileItem = m_item;
@@ -1415,7 +1424,12 @@ void CVideoPlayer::Process()
 
     DemuxPacket* pPacket = NULL;
     CDemuxStream *pStream = NULL;
-    ReadPacket(pPacket, pStream);
+    {
+      TRACE_SCOPE("videoplayer", "CVideoPlayer::ReadPacket");
+      ReadPacket(pPacket, pStream);
+    }
+    TRACE_COUNTER("videoplayer", "audio queue level", m_VideoPlayerAudio->GetLevel());
+    TRACE_COUNTER("videoplayer", "video queue level", m_processInfo->GetLevelVQ());
     if (pPacket && !pStream)
     {
       /* probably a empty packet, just free it and move on */
@@ -1423,6 +1437,9 @@ void CVideoPlayer::Process()
       continue;
     }
 
+    if (pPacket)
+      m_processInfo->SetStartupFirstPacket();
+
     if (!pPacket)
     {
       // when paused, demuxer could be be returning empty
@@ -1509,7 +1526,7 @@ void CVideoPlayer::Process()
     CheckBetterStream(m_CurrentRadioRDS, pStream);
 
     // demux video stream
-    if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_SUBTITLES_PARSECAPTIONS) && CheckIsCurrent(m_CurrentVideo, pStream, pPacket))
+    if (m_parseCaptions->Get() && CheckIsCurrent(m_CurrentVideo, pStream, pPacket))
     {
       if (m_pCCDemuxer)
       {
@@ -3160,6 +3177,11 @@ void CVideoPlayer::GetGeneralInfo(std::string& strGeneralInfo)
         strBuf += StringUtils::Format(" %d msec", DVD_TIME_TO_MSEC(m_State.cache_delay));
     }
 
+    int openToPacket, packetToFrame;
+    m_processInfo->GetStartupTiming(openToPacket, packetToFrame);
+    if (openToPacket >= 0)
+      strBuf += StringUtils::Format(" startup:%d/%d msec", openToPacket, packetToFrame);
+
     strGeneralInfo = StringUtils::Format("Player: a/v:% 6.3f, %s"
                                          , dDiff
                                          , strBuf.c_str());
@@ -4641,8 +4663,7 @@ void CVideoPlayer::UpdatePlayState(double timeout)
 
     bool realtime = m_pInputStream->IsRealtime();
 
-    if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_VIDEOPLAYER_USEDISPLAYASCLOCK) &&
-        !realtime)
+    if (m_useDisplayAsClock->Get() && !realtime)
     {
       state.cantempo = true;
     }
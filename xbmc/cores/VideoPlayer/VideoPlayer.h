@@ -232,6 +232,9 @@ protected:
 
 class CProcessInfo;
 class CJobQueue;
+class CSettingBool;
+template<class TSetting>
+class CSettingHandle;
 
 class CVideoPlayer : public IPlayer, public CThread, public IVideoPlayer,
                      public IDispResource, public IRenderLoop, public IRenderMsg
@@ -501,6 +504,11 @@ protected:
   std::unordered_map<int64_t, std::shared_ptr<CDVDDemux>> m_subtitleDemuxerMap;
   CDVDDemuxCC* m_pCCDemuxer;
 
+  // read for every demuxed packet
+  std::unique_ptr<CSettingHandle<CSettingBool>> m_parseCaptions;
+  // read for every play state update, i.e. every iteration of Process()
+  std::unique_ptr<CSettingHandle<CSettingBool>> m_useDisplayAsClock;
+
   CRenderManager m_renderManager;
 
   struct SDVDInfo
@@ -17,6 +17,7 @@
 #include "system.h"
 #include "utils/log.h"
 #include "utils/MathUtils.h"
+#include "utils/TraceRecorder.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #ifdef TARGET_RASPBERRY_PI
@@ -396,7 +397,12 @@ void CVideoPlayerAudio::Process()
         continue;
       }
 
-      if (!m_pAudioCodec->AddData(*pPacket))
+      bool added;
+      {
+        TRACE_SCOPE("audio", "CDVDAudioCodec::AddData");
+        added = m_pAudioCodec->AddData(*pPacket);
+      }
+      if (!added)
       {
         m_messageQueue.PutBack(pMsg->Acquire());
         onlyPrioMsgs = true;
@@ -424,7 +430,10 @@ bool CVideoPlayerAudio::ProcessDecoderOutput(DVDAudioFrame &audioframe)
   {
     audioframe.hasDownmix = false;
 
-    m_pAudioCodec->GetData(audioframe);
+    {
+      TRACE_SCOPE("audio", "CDVDAudioCodec::GetData");
+      m_pAudioCodec->GetData(audioframe);
+    }
 
     if (audioframe.nb_frames == 0)
     {
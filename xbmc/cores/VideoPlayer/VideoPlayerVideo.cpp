@@ -17,6 +17,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/MathUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
@@ -559,7 +560,12 @@ void CVideoPlayerVideo::Process()
         codecControl |= DVD_CODEC_CTRL_ROTATE;
       m_pVideoCodec->SetCodecControl(codecControl);
 
-      if (m_pVideoCodec->AddData(*pPacket))
+      bool added;
+      {
+        TRACE_SCOPE("video", "CDVDVideoCodec::AddData");
+        added = m_pVideoCodec->AddData(*pPacket);
+      }
+      if (added)
       {
         // buffer packets so we can recover should decoder flush for some reason
         if (m_pVideoCodec->GetConvergeCount() > 0)
@@ -591,7 +597,11 @@ void CVideoPlayerVideo::Process()
 
 bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
 {
-  CDVDVideoCodec::VCReturn decoderState = m_pVideoCodec->GetPicture(&m_picture);
+  CDVDVideoCodec::VCReturn decoderState;
+  {
+    TRACE_SCOPE("video", "CDVDVideoCodec::GetPicture");
+    decoderState = m_pVideoCodec->GetPicture(&m_picture);
+  }
 
   if (decoderState == CDVDVideoCodec::VC_BUFFER)
   {
@@ -656,6 +666,8 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
   // check for a new picture
   if (decoderState == CDVDVideoCodec::VC_PICTURE)
   {
+    m_processInfo.SetStartupFirstFrame();
+
     bool hasTimestamp = true;
 
     m_picture.iDuration = frametime;
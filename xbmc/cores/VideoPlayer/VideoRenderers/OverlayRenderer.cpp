@@ -23,6 +23,7 @@
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/ColorUtils.h"
+#include "utils/StringUtils.h"
 #include "OverlayRendererUtil.h"
 #include "OverlayRendererGUI.h"
 #if defined(HAS_GL) || defined(HAS_GLES)
@@ -97,6 +98,7 @@ void CRenderer::Flush()
     Release(buffer);
 
   ReleaseCache();
+  m_hasAssStats = false;
 
   g_fontManager.Unload(m_font);
   g_fontManager.Unload(m_fontBorder);
@@ -339,6 +341,18 @@ void CRenderer::SetStereoMode(const std::string &stereomode)
   m_stereomode = stereomode;
 }
 
+std::string CRenderer::GetDebugInfo()
+{
+  CSingleLock lock(m_section);
+  if (!m_hasAssStats)
+    return "";
+
+  unsigned int total = m_assHits + m_assMisses;
+  return StringUtils::Format("subs: cached %u/%u (%.0f%%) prerendered %u",
+                             m_assHits, total, total ? 100.0 * m_assHits / total : 0.0,
+                             m_assPrerendered);
+}
+
 COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
 {
   // libass render in a target area which named as frame. the frame size may bigger than video size,
@@ -388,6 +402,11 @@ COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
   int changes = 0;
   ASS_Image* images = o->m_libass->RenderImage(targetWidth, targetHeight, videoWidth, videoHeight, sourceWidth, sourceHeight,
                                                pts, useMargin, position, &changes);
+  const CDVDSubtitlesLibass::SCacheStats stats = o->m_libass->GetCacheStats();
+  m_assHits = stats.hits;
+  m_assMisses = stats.misses;
+  m_assPrerendered = stats.prerendered;
+  m_hasAssStats = true;
 
   if(o->m_textureid)
   {
@@ -77,6 +77,11 @@ namespace OVERLAY {
     void SetVideoRect(CRect &source, CRect &dest, CRect &view);
     void SetStereoMode(const std::string &stereomode);
 
+    /*!
+     \brief Statistics of the subtitle image cache for the debug info, empty without ASS subtitles
+     */
+    std::string GetDebugInfo();
+
   protected:
 
     struct SElement
@@ -105,6 +110,11 @@ namespace OVERLAY {
     CRect m_rv, m_rs, m_rd;
     std::string m_font, m_fontBorder;
     std::string m_stereomode;
+    // subtitle image cache of the last rendered ASS subtitles
+    bool m_hasAssStats = false;
+    unsigned int m_assHits = 0;
+    unsigned int m_assMisses = 0;
+    unsigned int m_assPrerendered = 0;
   };
 
   extern const std::string SETTING_SUBTITLES_OPACITY;
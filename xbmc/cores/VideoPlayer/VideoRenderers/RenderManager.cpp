@@ -22,6 +22,7 @@
 #include "threads/SingleLock.h"
 #include "utils/MathUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
@@ -684,6 +685,7 @@ RESOLUTION CRenderManager::GetResolution()
 
 void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
 {
+  TRACE_SCOPE("render", "CRenderManager::Render");
   CSingleExit exitLock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
   {
@@ -723,6 +725,9 @@ void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
       std::string audio, video, player, vsync;
 
       m_playerPort->GetDebugInfo(audio, video, player);
+      std::string subtitles = m_overlays.GetDebugInfo();
+      if (!subtitles.empty())
+        player += ", " + subtitles;
 
       double refreshrate, clockspeed;
       int missedvblanks;
@@ -1072,6 +1077,7 @@ int CRenderManager::WaitForBuffer(volatile std::atomic_bool&bStop, int timeout)
 
 void CRenderManager::PrepareNextRender()
 {
+  TRACE_SCOPE("render", "CRenderManager::PrepareNextRender");
   if (m_queued.empty())
   {
     CLog::Log(LOGERROR, "CRenderManager::PrepareNextRender - asked to prepare with nothing available");
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/test/VideoPlayerBenchmark.h"
+#include "filesystem/File.h"
+#include "utils/Variant.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+/*
+ * Runs the headless demux/decode benchmark on the file given in KODI_BENCHMARK_VIDEO.
+ * Set KODI_BENCHMARK_REALTIME=1 to pace playback in real time and KODI_BENCHMARK_OUTPUT
+ * to write the JSON result to a file instead of stdout.
+ */
+TEST(TestVideoPlayerBenchmark, DecodeThroughput)
+{
+  const char* path = std::getenv("KODI_BENCHMARK_VIDEO");
+  if (!path)
+    GTEST_SKIP() << "KODI_BENCHMARK_VIDEO not set";
+
+  CVideoPlayerBenchmark::Options options;
+  options.path = path;
+  const char* realtime = std::getenv("KODI_BENCHMARK_REALTIME");
+  options.realtime = realtime && std::string(realtime) == "1";
+
+  CVideoPlayerBenchmark benchmark(options);
+  std::string json;
+  ASSERT_TRUE(benchmark.Run(json));
+  EXPECT_FALSE(json.empty());
+
+  const char* output = std::getenv("KODI_BENCHMARK_OUTPUT");
+  if (output)
+  {
+    XFILE::CFile file;
+    ASSERT_TRUE(file.OpenForWrite(output, true));
+    EXPECT_EQ(static_cast<ssize_t>(json.size()), file.Write(json.c_str(), json.size()));
+  }
+  else
+    std::cout << json << std::endl;
+}
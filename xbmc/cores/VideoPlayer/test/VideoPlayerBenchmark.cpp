@@ -0,0 +1,433 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoPlayerBenchmark.h"
+
+#include "FileItem.h"
+#include "cores/AudioEngine/Utils/AEStreamInfo.h"
+#include "cores/VideoPlayer/DVDCodecs/Audio/DVDAudioCodec.h"
+#include "cores/VideoPlayer/DVDCodecs/DVDFactoryCodec.h"
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoCodec.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemux.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDFactoryDemuxer.h"
+#include "cores/VideoPlayer/DVDInputStreams/DVDFactoryInputStream.h"
+#include "cores/VideoPlayer/DVDInputStreams/DVDInputStream.h"
+#include "cores/VideoPlayer/DVDMessage.h"
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+#include "cores/VideoPlayer/DVDStreamInfo.h"
+#include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
+#include "cores/VideoPlayer/Process/ProcessInfo.h"
+#include "threads/SystemClock.h"
+#include "threads/Thread.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/TimeUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+
+constexpr int DRAIN_RETRIES = 1000; // 1 ms apart
+
+int64_t ElapsedMicroseconds(int64_t start)
+{
+  return (CurrentHostCounter() - start) * 1000000 / CurrentHostFrequency();
+}
+
+/*!
+ * \brief A decoder thread fed by a message queue, its output is discarded.
+ */
+class CBenchmarkStage : public CThread
+{
+public:
+  CBenchmarkStage(const char* name, int maxDataSize, int64_t startCounter, bool realtime)
+    : CThread(name),
+      m_queue(name),
+      m_startCounter(startCounter),
+      m_realtime(realtime)
+  {
+    m_queue.SetMaxDataSize(maxDataSize);
+    m_queue.SetMaxTimeSize(8.0);
+    m_queue.Init();
+  }
+
+  ~CBenchmarkStage() override { m_queue.End(); }
+
+  CDVDMessageQueue& GetQueue() { return m_queue; }
+
+  void SampleQueue()
+  {
+    const int level = m_queue.GetLevel();
+    m_maxLevel = std::max(m_maxLevel, level);
+    m_levelSum += level;
+    m_levelSamples++;
+  }
+
+  void GetResult(CVariant& result) const
+  {
+    const double busySeconds = m_decodeTime / 1000000.0;
+    result["decoder"] = m_decoderName;
+    result["packets"] = m_packets;
+    result["frames"] = m_frames;
+    result["dropped"] = m_dropped;
+    result["decodetime_ms"] = m_decodeTime / 1000;
+    result["decodefps"] = busySeconds > 0 ? m_frames / busySeconds : 0.0;
+    result["avgpackettime_us"] = m_packets > 0 ? static_cast<double>(m_decodeTime) / m_packets : 0.0;
+    result["queue"]["maxlevel"] = m_maxLevel;
+    result["queue"]["avglevel"] = m_levelSamples > 0 ? static_cast<double>(m_levelSum) / m_levelSamples : 0.0;
+  }
+
+protected:
+  void Process() override
+  {
+    while (!m_bStop)
+    {
+      CDVDMsg* msg;
+      MsgQueueReturnCode ret = m_queue.Get(&msg, 100);
+      if (MSGQ_IS_ERROR(ret))
+        break;
+      if (ret == MSGQ_TIMEOUT)
+        continue;
+
+      if (msg->IsType(CDVDMsg::DEMUXER_PACKET))
+      {
+        DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(msg)->GetPacket();
+        const int64_t start = CurrentHostCounter();
+        Decode(*packet);
+        m_decodeTime += ElapsedMicroseconds(start);
+        m_packets++;
+      }
+      else if (msg->IsType(CDVDMsg::GENERAL_EOF))
+      {
+        const int64_t start = CurrentHostCounter();
+        Drain();
+        m_decodeTime += ElapsedMicroseconds(start);
+        msg->Release();
+        break;
+      }
+      msg->Release();
+    }
+  }
+
+  virtual void Decode(const DemuxPacket& packet) = 0;
+  virtual void Drain() = 0;
+
+  // in real time mode a frame decoded after its presentation time would have been dropped
+  void AddFrame(double pts, bool dropped)
+  {
+    m_frames++;
+    if (dropped)
+      m_dropped++;
+    else if (m_realtime && pts != DVD_NOPTS_VALUE && m_firstPts != DVD_NOPTS_VALUE &&
+             ElapsedMicroseconds(m_startCounter) > (pts - m_firstPts))
+      m_dropped++;
+
+    if (m_firstPts == DVD_NOPTS_VALUE && pts != DVD_NOPTS_VALUE)
+      m_firstPts = pts;
+  }
+
+  CDVDMessageQueue m_queue;
+  std::string m_decoderName;
+
+private:
+  int64_t m_startCounter;
+  bool m_realtime;
+  double m_firstPts = DVD_NOPTS_VALUE;
+  uint64_t m_packets = 0;
+  uint64_t m_frames = 0;
+  uint64_t m_dropped = 0;
+  int64_t m_decodeTime = 0;
+  int m_maxLevel = 0;
+  int64_t m_levelSum = 0;
+  int64_t m_levelSamples = 0;
+};
+
+class CBenchmarkVideoStage : public CBenchmarkStage
+{
+public:
+  CBenchmarkVideoStage(CDVDVideoCodec* codec, int64_t startCounter, bool realtime)
+    : CBenchmarkStage("BenchmarkVideo", 40 * 1024 * 1024, startCounter, realtime), m_codec(codec)
+  {
+    m_decoderName = m_codec->GetName();
+  }
+
+  ~CBenchmarkVideoStage() override
+  {
+    StopThread();
+    if (m_picture.videoBuffer)
+      m_picture.videoBuffer->Release();
+  }
+
+protected:
+  void Decode(const DemuxPacket& packet) override
+  {
+    // the decoder refuses new data until its pending pictures have been fetched
+    for (int retry = 0; retry < 2; retry++)
+    {
+      const bool added = m_codec->AddData(packet);
+      FetchPictures();
+      if (added)
+        break;
+    }
+  }
+
+  void Drain() override
+  {
+    m_codec->SetCodecControl(DVD_CODEC_CTRL_DRAIN);
+    // the decoder may have nothing to hand out yet on the first calls
+    for (int retry = 0; retry < DRAIN_RETRIES; retry++)
+    {
+      if (FetchPictures() != CDVDVideoCodec::VC_NONE)
+        break;
+      XbmcThreads::ThreadSleep(1);
+    }
+  }
+
+private:
+  //! fetch the pictures the decoder has ready, returns its state after the last one
+  CDVDVideoCodec::VCReturn FetchPictures()
+  {
+    while (true)
+    {
+      CDVDVideoCodec::VCReturn state = m_codec->GetPicture(&m_picture);
+      if (state != CDVDVideoCodec::VC_PICTURE)
+      {
+        if (state == CDVDVideoCodec::VC_FLUSHED || state == CDVDVideoCodec::VC_ERROR)
+          m_codec->Reset();
+        return state;
+      }
+      AddFrame(m_picture.pts, (m_picture.iFlags & DVP_FLAG_DROPPED) != 0);
+    }
+  }
+
+  std::unique_ptr<CDVDVideoCodec> m_codec;
+  VideoPicture m_picture = {};
+};
+
+class CBenchmarkAudioStage : public CBenchmarkStage
+{
+public:
+  CBenchmarkAudioStage(CDVDAudioCodec* codec, int64_t startCounter, bool realtime)
+    : CBenchmarkStage("BenchmarkAudio", 6 * 1024 * 1024, startCounter, realtime), m_codec(codec)
+  {
+    m_decoderName = m_codec->GetName();
+  }
+
+  ~CBenchmarkAudioStage() override { StopThread(); }
+
+protected:
+  void Decode(const DemuxPacket& packet) override
+  {
+    for (int retry = 0; retry < 2; retry++)
+    {
+      const bool added = m_codec->AddData(packet);
+      FetchFrames();
+      if (added)
+        break;
+    }
+  }
+
+  void Drain() override { FetchFrames(); }
+
+private:
+  void FetchFrames()
+  {
+    DVDAudioFrame frame;
+    while (true)
+    {
+      frame.nb_frames = 0;
+      frame.framesOut = 0;
+      m_codec->GetData(frame);
+      if (frame.nb_frames == 0)
+        break;
+      AddFrame(frame.hasTimestamp ? frame.pts : DVD_NOPTS_VALUE, false);
+    }
+  }
+
+  std::unique_ptr<CDVDAudioCodec> m_codec;
+};
+
+} // unnamed namespace
+
+CVideoPlayerBenchmark::CVideoPlayerBenchmark(const Options& options) : m_options(options)
+{
+}
+
+bool CVideoPlayerBenchmark::Run(std::string& json)
+{
+  CVariant result;
+  if (!Run(result))
+    return false;
+
+  return CJSONVariantWriter::Write(result, json, false);
+}
+
+bool CVideoPlayerBenchmark::Run(CVariant& result)
+{
+  const int64_t openStart = CurrentHostCounter();
+
+  CFileItem item(m_options.path, false);
+  std::shared_ptr<CDVDInputStream> input = CDVDFactoryInputStream::CreateInputStream(nullptr, item);
+  if (!input || !input->Open())
+  {
+    CLog::Log(LOGERROR, "CVideoPlayerBenchmark::Run - unable to open %s", m_options.path.c_str());
+    return false;
+  }
+
+  std::unique_ptr<CDVDDemux> demuxer(CDVDFactoryDemuxer::CreateDemuxer(input, true));
+  if (!demuxer)
+  {
+    CLog::Log(LOGERROR, "CVideoPlayerBenchmark::Run - unable to create demuxer for %s",
+              m_options.path.c_str());
+    return false;
+  }
+
+  const int64_t openTime = ElapsedMicroseconds(openStart);
+  const int64_t startCounter = CurrentHostCounter();
+
+  std::unique_ptr<CProcessInfo> processInfo(CProcessInfo::CreateInstance());
+  std::unique_ptr<CBenchmarkStage> video;
+  std::unique_ptr<CBenchmarkStage> audio;
+  int videoStream = -1;
+  int audioStream = -1;
+
+  for (CDemuxStream* stream : demuxer->GetStreams())
+  {
+    if (!stream)
+      continue;
+
+    CDVDStreamInfo hint(*stream, true);
+    if (m_options.forceSoftware)
+      hint.codecOptions = CODEC_FORCE_SOFTWARE;
+
+    if (stream->type == STREAM_VIDEO && !video && !(stream->flags & AV_DISPOSITION_ATTACHED_PIC))
+    {
+      CDVDVideoCodec* codec = CDVDFactoryCodec::CreateVideoCodec(hint, *processInfo);
+      if (codec)
+      {
+        video.reset(new CBenchmarkVideoStage(codec, startCounter, m_options.realtime));
+        videoStream = stream->uniqueId;
+        continue;
+      }
+    }
+    else if (stream->type == STREAM_AUDIO && !audio)
+    {
+      CDVDAudioCodec* codec = CDVDFactoryCodec::CreateAudioCodec(hint, *processInfo, false, true,
+                                                                 CAEStreamInfo::STREAM_TYPE_NULL);
+      if (codec)
+      {
+        audio.reset(new CBenchmarkAudioStage(codec, startCounter, m_options.realtime));
+        audioStream = stream->uniqueId;
+        continue;
+      }
+    }
+    demuxer->EnableStream(stream->demuxerId, stream->uniqueId, false);
+  }
+
+  if (!video && !audio)
+  {
+    CLog::Log(LOGERROR, "CVideoPlayerBenchmark::Run - no decodable stream in %s",
+              m_options.path.c_str());
+    return false;
+  }
+
+  if (video)
+    video->Create();
+  if (audio)
+    audio->Create();
+
+  int64_t demuxTime = 0;
+  uint64_t packets = 0;
+  double firstDts = DVD_NOPTS_VALUE;
+
+  while (true)
+  {
+    const int64_t readStart = CurrentHostCounter();
+    DemuxPacket* packet = demuxer->Read();
+    demuxTime += ElapsedMicroseconds(readStart);
+    if (!packet)
+      break;
+
+    packets++;
+    if (firstDts == DVD_NOPTS_VALUE && packet->dts != DVD_NOPTS_VALUE)
+      firstDts = packet->dts;
+
+    const double mediaTime = (packet->dts != DVD_NOPTS_VALUE && firstDts != DVD_NOPTS_VALUE)
+                               ? packet->dts - firstDts
+                               : 0.0;
+    if (m_options.maxDuration > 0 && mediaTime > DVD_MSEC_TO_TIME(m_options.maxDuration))
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(packet);
+      break;
+    }
+
+    if (m_options.realtime)
+    {
+      const int64_t ahead = static_cast<int64_t>(mediaTime) - ElapsedMicroseconds(startCounter);
+      if (ahead > 1000)
+        XbmcThreads::ThreadSleep(static_cast<unsigned int>(ahead / 1000));
+    }
+
+    CBenchmarkStage* stage = nullptr;
+    if (video && packet->iStreamId == videoStream)
+      stage = video.get();
+    else if (audio && packet->iStreamId == audioStream)
+      stage = audio.get();
+
+    if (!stage)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(packet);
+      continue;
+    }
+
+    // like CVideoPlayer, wait for the decoder when its queue is full
+    while (stage->GetQueue().IsFull())
+      XbmcThreads::ThreadSleep(1);
+
+    stage->GetQueue().Put(new CDVDMsgDemuxerPacket(packet));
+
+    if (video)
+      video->SampleQueue();
+    if (audio)
+      audio->SampleQueue();
+  }
+
+  if (video)
+    video->GetQueue().Put(new CDVDMsg(CDVDMsg::GENERAL_EOF));
+  if (audio)
+    audio->GetQueue().Put(new CDVDMsg(CDVDMsg::GENERAL_EOF));
+
+  if (video)
+    video->Join(static_cast<unsigned int>(-1));
+  if (audio)
+    audio->Join(static_cast<unsigned int>(-1));
+
+  const int64_t totalTime = ElapsedMicroseconds(startCounter);
+
+  result = CVariant(CVariant::VariantTypeObject);
+  result["file"] = m_options.path;
+  result["mode"] = m_options.realtime ? "realtime" : "throughput";
+  result["opentime_ms"] = openTime / 1000;
+  result["totaltime_ms"] = totalTime / 1000;
+  result["demux"]["packets"] = packets;
+  result["demux"]["readtime_ms"] = demuxTime / 1000;
+
+  if (video)
+  {
+    video->GetResult(result["video"]);
+    result["video"]["fps"] = totalTime > 0 ? result["video"]["frames"].asDouble() * 1000000.0 / totalTime : 0.0;
+  }
+  if (audio)
+    audio->GetResult(result["audio"]);
+
+  return true;
+}
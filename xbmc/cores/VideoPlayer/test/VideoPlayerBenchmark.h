@@ -0,0 +1,50 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+
+class CVariant;
+
+/*!
+ * \brief Headless benchmark of the VideoPlayer demux and decode pipeline.
+ *
+ * Packets are demuxed on the calling thread and handed to video and audio decoder threads
+ * through CDVDMessageQueue, just like CVideoPlayer does. Decoded pictures and audio frames are
+ * discarded instead of going to the render manager and audio engine, so neither a display nor
+ * an audio device is needed. Part of the tests only, it's not built into the application.
+ */
+class CVideoPlayerBenchmark
+{
+public:
+  struct Options
+  {
+    std::string path;
+    bool realtime = false; //!< pace demuxing by timestamps instead of running as fast as possible
+    bool forceSoftware = true; //!< do not try hardware decoders
+    unsigned int maxDuration = 0; //!< stop after this much media time in ms, 0 for the whole file
+  };
+
+  explicit CVideoPlayerBenchmark(const Options& options);
+
+  /*!
+   * \brief Run the benchmark
+   * \param result receives decoded fps, dropped frames, queue levels and per stage timings
+   * \return false if the file could not be opened or has no decodable stream
+   */
+  bool Run(CVariant& result);
+
+  /*!
+   * \brief Run the benchmark and serialize the result as JSON
+   */
+  bool Run(std::string& json);
+
+private:
+  Options m_options;
+};
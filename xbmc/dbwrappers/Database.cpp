@@ -12,8 +12,10 @@
 #include "profiles/ProfileManager.h"
 #include "settings/SettingsComponent.h"
 #include "utils/log.h"
+#include "utils/RandomIdCache.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "sqlitedataset.h"
 #include "DatabaseManager.h"
 #include "DbUrl.h"
@@ -27,9 +29,13 @@
 #include "platform/posix/ConvUtils.h"
 #endif
 
+#include <algorithm>
+#include <ctype.h>
+
 using namespace dbiplus;
 
 #define MAX_COMPRESS_COUNT 20
+#define MAX_SMARTPLAYLIST_CACHE 32
 
 void CDatabase::Filter::AppendField(const std::string &strField)
 {
@@ -340,6 +346,7 @@ bool CDatabase::ExecuteQuery(const std::string &strQuery)
       return bReturn;
     if (nullptr == m_pDS)
       return bReturn;
+    TRACE_SCOPE("database", "CDatabase::ExecuteQuery");
     m_pDS->exec(strQuery);
     bReturn = true;
   }
@@ -365,6 +372,7 @@ bool CDatabase::ResultQuery(const std::string &strQuery)
 
     std::string strPreparedQuery = PrepareSQL(strQuery.c_str());
 
+    TRACE_SCOPE("database", "CDatabase::ResultQuery");
     bReturn = m_pDS->query(strPreparedQuery);
   }
   catch (...)
@@ -743,6 +751,260 @@ bool CDatabase::BuildSQL(const std::string &strQuery, const Filter &filter, std:
   return true;
 }
 
+std::string CDatabase::GetRandomIdCondition(const std::string &mediaType, const std::string &idColumn, const std::string &from, size_t count, int &total)
+{
+  // count the same distinct ids as fetched below, so a changed count shows stale ids
+  total = static_cast<int>(strtol(GetSingleValue("SELECT COUNT(DISTINCT " + idColumn + ") FROM " + from, m_pDS).c_str(), nullptr, 10));
+  if (count == 0 || count >= static_cast<size_t>(total))
+    return "";
+
+  // the same query may be run on databases of other profiles or servers
+  const std::string idSQL = "SELECT DISTINCT " + idColumn + " FROM " + from;
+  const std::string key = StringUtils::Format("%s:%s:%s:%s", m_pDB->getHostName(), m_pDB->getDatabase(), mediaType.c_str(), idSQL.c_str());
+  const std::vector<int> ids = CRandomIdCache::GetInstance().Draw(key, total, count, [this, &idSQL](std::vector<int>& candidates) {
+    if (!m_pDS->query(idSQL))
+      return false;
+    candidates.reserve(m_pDS->num_rows());
+    for (; !m_pDS->eof(); m_pDS->next())
+      candidates.push_back(m_pDS->fv(0).get_asInt());
+    m_pDS->close();
+    return true;
+  });
+  if (ids.empty())
+    return "";
+
+  std::string idList;
+  for (int id : ids)
+    idList += StringUtils::Format("%i,", id);
+  idList.back() = ')';
+  return idColumn + " IN (" + idList;
+}
+
+bool CDatabase::CreateFullTextIndex(const std::string &index, const std::string &table, const std::string &idColumn, const std::vector<std::string> &columns)
+{
+  if (!m_sqlite)
+    return false;
+
+  const std::string columnList = StringUtils::Join(columns, ", ");
+  std::string newValues = "new." + idColumn;
+  for (const auto& column : columns)
+    newValues += ", new." + column;
+
+  try
+  {
+    // the index keeps its own copy of the columns, so rows replaced without firing the delete
+    // triggers don't leave stale words behind. Virtual tables aren't dropped with the analytics.
+    m_pDS->exec(PrepareSQL("DROP TABLE IF EXISTS %s", index.c_str()));
+    m_pDS->exec(PrepareSQL("CREATE VIRTUAL TABLE %s USING fts5(%s, tokenize='unicode61 remove_diacritics 1', prefix='2 3')",
+                           index.c_str(), columnList.c_str()));
+    m_pDS->exec(PrepareSQL("INSERT INTO %s (rowid, %s) SELECT %s, %s FROM %s",
+                           index.c_str(), columnList.c_str(), idColumn.c_str(), columnList.c_str(), table.c_str()));
+
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_insert AFTER INSERT ON %s FOR EACH ROW BEGIN "
+                           "INSERT OR REPLACE INTO %s (rowid, %s) VALUES (%s); "
+                           "END", index.c_str(), table.c_str(), index.c_str(), columnList.c_str(), newValues.c_str()));
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_update AFTER UPDATE OF %s ON %s FOR EACH ROW BEGIN "
+                           "DELETE FROM %s WHERE rowid=old.%s; "
+                           "INSERT OR REPLACE INTO %s (rowid, %s) VALUES (%s); "
+                           "END", index.c_str(), columnList.c_str(), table.c_str(), index.c_str(), idColumn.c_str(),
+                           index.c_str(), columnList.c_str(), newValues.c_str()));
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_delete AFTER DELETE ON %s FOR EACH ROW BEGIN "
+                           "DELETE FROM %s WHERE rowid=old.%s; "
+                           "END", index.c_str(), table.c_str(), index.c_str(), idColumn.c_str()));
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGWARNING, "%s - unable to create full text index %s, searching %s without it", __FUNCTION__, index.c_str(), table.c_str());
+  }
+
+  try
+  {
+    m_pDS->exec(PrepareSQL("DROP TABLE IF EXISTS %s", index.c_str()));
+  }
+  catch (...)
+  {
+  }
+  return false;
+}
+
+bool CDatabase::HasFullTextIndex(const std::string &index)
+{
+  if (!m_sqlite)
+    return false;
+
+  return !GetSingleValue(PrepareSQL("SELECT name FROM sqlite_master WHERE type='table' AND name='%s'", index.c_str()), m_pDS2).empty();
+}
+
+std::string CDatabase::GetFullTextQuery(const std::string &search, const std::vector<std::string> &columns /* = {} */)
+{
+  std::string columnFilter;
+  if (!columns.empty())
+    columnFilter = "{" + StringUtils::Join(columns, " ") + "} : ";
+
+  // every word as a quoted prefix, so that no character of it is taken as FTS5 syntax
+  std::vector<std::string> phrases;
+  for (std::string word : StringUtils::Split(search, " "))
+  {
+    StringUtils::Trim(word);
+    // the tokenizer drops punctuation, a word of punctuation only would be an empty phrase
+    if (std::none_of(word.begin(), word.end(), [](unsigned char c) { return isalnum(c) || c >= 0x80; }))
+      continue;
+    StringUtils::Replace(word, "\"", "\"\"");
+    phrases.push_back(columnFilter + "\"" + word + "\"*");
+  }
+
+  return StringUtils::Join(phrases, " AND ");
+}
+
+std::string CDatabase::GetFullTextCondition(const std::string &index, const std::string &table, const std::string &idColumn, const std::vector<std::string> &columns, const std::string &search)
+{
+  const std::string query = GetFullTextQuery(search, columns);
+  if (!query.empty() && HasFullTextIndex(index))
+    return PrepareSQL("%s.%s IN (SELECT rowid FROM %s WHERE %s MATCH '%s')",
+                      table.c_str(), idColumn.c_str(), index.c_str(), index.c_str(), query.c_str());
+
+  std::vector<std::string> conditions;
+  for (const auto& column : columns)
+    conditions.push_back(PrepareSQL("%s.%s LIKE '%%%s%%'", table.c_str(), column.c_str(), search.c_str()));
+  return "(" + StringUtils::Join(conditions, " OR ") + ")";
+}
+
+void CDatabase::CreateSmartPlaylistCache()
+{
+  // stored results are only valid for the views they were evaluated on, which may have changed.
+  // Tables aren't dropped with the analytics.
+  m_pDS->exec("DROP TABLE IF EXISTS smartplaylistcache");
+  m_pDS->exec("DROP TABLE IF EXISTS smartplaylistcacheitem");
+  m_pDS->exec("CREATE TABLE smartplaylistcache (idCache INTEGER PRIMARY KEY, strType TEXT, strWhere TEXT, iLastUsed INTEGER)");
+  m_pDS->exec("CREATE TABLE smartplaylistcacheitem (idCache INTEGER, idItem INTEGER)");
+  m_pDS->exec("CREATE UNIQUE INDEX ix_smartplaylistcacheitem ON smartplaylistcacheitem (idCache, idItem)");
+}
+
+void CDatabase::ClearSmartPlaylistCache()
+{
+  if (nullptr == m_pDB || nullptr == m_pDS)
+    return;
+
+  try
+  {
+    m_pDS->exec("DELETE FROM smartplaylistcacheitem");
+    m_pDS->exec("DELETE FROM smartplaylistcache");
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+}
+
+std::string CDatabase::GetSmartPlaylistCondition(const std::string &type, const std::string &where)
+{
+  std::string view, idColumn;
+  if (where.empty() || !GetSmartPlaylistSource(type, view, idColumn))
+    return where;
+
+  const std::string column = view + "." + idColumn;
+  int idCache = -1;
+  try
+  {
+    const int lastUsed = atoi(GetSingleValue("SELECT MAX(iLastUsed) FROM smartplaylistcache", m_pDS2).c_str()) + 1;
+    const std::string id = GetSingleValue(PrepareSQL("SELECT idCache FROM smartplaylistcache WHERE strType = '%s' AND strWhere = '%s'",
+                                                     type.c_str(), where.c_str()), m_pDS2);
+    if (!id.empty())
+    {
+      m_pDS->exec(PrepareSQL("UPDATE smartplaylistcache SET iLastUsed = %i WHERE idCache = %s", lastUsed, id.c_str()));
+      return PrepareSQL("%s IN (SELECT idItem FROM smartplaylistcacheitem WHERE idCache = %s)", column.c_str(), id.c_str());
+    }
+
+    // the type is set once all items are stored, so no one else uses the results before
+    m_pDS->exec(PrepareSQL("INSERT INTO smartplaylistcache (idCache, strType, strWhere, iLastUsed) VALUES (NULL, '', '%s', %i)",
+                           where.c_str(), lastUsed));
+    idCache = static_cast<int>(m_pDS->lastinsertid());
+    m_pDS->exec(PrepareSQL("INSERT INTO smartplaylistcacheitem (idCache, idItem) SELECT %i, %s FROM %s WHERE ",
+                           idCache, column.c_str(), view.c_str()) + where);
+    m_pDS->exec(PrepareSQL("UPDATE smartplaylistcache SET strType = '%s' WHERE idCache = %i", type.c_str(), idCache));
+
+    // every stored playlist is updated on changes of its items, keep the most recently used ones
+    // only. The one just stored is the most recent, so its condition stays valid.
+    const std::string oldest = GetSingleValue(PrepareSQL("SELECT iLastUsed FROM smartplaylistcache ORDER BY iLastUsed DESC LIMIT 1 OFFSET %i",
+                                                         MAX_SMARTPLAYLIST_CACHE - 1), m_pDS2);
+    if (!oldest.empty())
+    {
+      m_pDS->exec(PrepareSQL("DELETE FROM smartplaylistcache WHERE iLastUsed < %s", oldest.c_str()));
+      m_pDS->exec("DELETE FROM smartplaylistcacheitem WHERE idCache NOT IN (SELECT idCache FROM smartplaylistcache)");
+    }
+
+    return PrepareSQL("%s IN (SELECT idItem FROM smartplaylistcacheitem WHERE idCache = %i)", column.c_str(), idCache);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGWARNING, "%s - unable to store the results of smart playlist of %s, evaluating it on the library", __FUNCTION__, type.c_str());
+  }
+
+  try
+  {
+    if (idCache > 0)
+    {
+      m_pDS->exec(PrepareSQL("DELETE FROM smartplaylistcacheitem WHERE idCache = %i", idCache));
+      m_pDS->exec(PrepareSQL("DELETE FROM smartplaylistcache WHERE idCache = %i", idCache));
+    }
+  }
+  catch (...)
+  {
+  }
+  return where;
+}
+
+void CDatabase::UpdateSmartPlaylistItems(const std::string &type, const std::string &condition)
+{
+  std::string view, idColumn;
+  if (!GetSmartPlaylistSource(type, view, idColumn))
+    return;
+
+  std::vector<std::pair<int, std::string>> playlists;
+  try
+  {
+    if (!m_pDS2->query(PrepareSQL("SELECT idCache, strWhere FROM smartplaylistcache WHERE strType = '%s'", type.c_str())))
+      return;
+    while (!m_pDS2->eof())
+    {
+      playlists.emplace_back(m_pDS2->fv(0).get_asInt(), m_pDS2->fv(1).get_asString());
+      m_pDS2->next();
+    }
+    m_pDS2->close();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s(%s) failed", __FUNCTION__, type.c_str());
+    return;
+  }
+
+  const std::string column = view + "." + idColumn;
+  const std::string items = PrepareSQL("SELECT %s FROM %s WHERE (", column.c_str(), view.c_str()) + condition + ")";
+  for (const auto& playlist : playlists)
+  {
+    try
+    {
+      m_pDS->exec(PrepareSQL("DELETE FROM smartplaylistcacheitem WHERE idCache = %i AND idItem IN (", playlist.first) + items + ")");
+      m_pDS->exec(PrepareSQL("INSERT INTO smartplaylistcacheitem (idCache, idItem) SELECT %i, %s FROM %s WHERE (",
+                             playlist.first, column.c_str(), view.c_str()) + condition + ") AND (" + playlist.second + ")");
+    }
+    catch (...)
+    {
+      // discard it, it's rebuilt on next use
+      CLog::Log(LOGERROR, "%s - unable to update the results of smart playlist %i", __FUNCTION__, playlist.first);
+      try
+      {
+        m_pDS->exec(PrepareSQL("DELETE FROM smartplaylistcacheitem WHERE idCache = %i", playlist.first));
+        m_pDS->exec(PrepareSQL("DELETE FROM smartplaylistcache WHERE idCache = %i", playlist.first));
+      }
+      catch (...)
+      {
+      }
+    }
+  }
+}
+
 bool CDatabase::BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl)
 {
   SortDescription sorting;
@@ -187,6 +187,12 @@ public:
    */
   bool CommitInsertQueries();
 
+  /*! \brief Discard the stored results of smart playlists, e.g. after bulk changes to the library.
+   They are rebuilt from the library the next time the playlists are opened.
+   \sa GetSmartPlaylistCondition
+   */
+  void ClearSmartPlaylistCache();
+
   virtual bool GetFilter(CDbUrl &dbUrl, Filter &filter, SortDescription &sorting) { return true; }
   virtual bool BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl);
   virtual bool BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl, SortDescription &sorting);
@@ -234,6 +240,76 @@ protected:
 
   bool BuildSQL(const std::string &strQuery, const Filter &filter, std::string &strSQL);
 
+  /*! \brief Get a condition selecting random items, drawn from a cached permutation of the ids of
+   the candidates rather than sorting all of them with ORDER BY RANDOM().
+   \param mediaType the type of the items
+   \param idColumn the id column of the items, e.g. "songview.idSong"
+   \param from the tables and conditions selecting the candidates, i.e. the query after FROM
+   \param count the number of items to select
+   \param total set to the number of candidates
+   \return the condition, empty if there are no more than count candidates or drawing failed
+   */
+  std::string GetRandomIdCondition(const std::string &mediaType, const std::string &idColumn, const std::string &from, size_t count, int &total);
+
+  /*! \brief Create a full text index over columns of a table, kept up to date by triggers.
+   Only available with SQLite (FTS5), to be called from CreateAnalytics(). The index is rebuilt
+   from the table. Words are matched by prefix, ignoring case and diacritics.
+   \param index name of the index, a FTS5 table whose rowids are the ids of the table
+   \param table the indexed table
+   \param idColumn the integer primary key of the table
+   \param columns the indexed text columns of the table
+   \return false if the index could not be created, e.g. on MySQL
+   \sa GetFullTextCondition
+   */
+  bool CreateFullTextIndex(const std::string &index, const std::string &table, const std::string &idColumn, const std::vector<std::string> &columns);
+  bool HasFullTextIndex(const std::string &index);
+
+  /*! \brief Build a FTS5 query matching all words of a search string as prefixes.
+   \param search the user entered search string
+   \param columns the columns to match in, all if empty
+   \return the query, empty if the search string has no words. Words without any letter or digit
+   are skipped.
+   */
+  static std::string GetFullTextQuery(const std::string &search, const std::vector<std::string> &columns = {});
+
+  /*! \brief Get a condition selecting the rows of a table whose columns contain the search string.
+   Uses the full text index if there is one, and LIKE on the columns otherwise. Note that the index
+   matches the words of the search string as prefixes of words, while LIKE matches any substring.
+   \param index the full text index created by CreateFullTextIndex()
+   \param table the table the index was created for
+   \param idColumn the integer primary key of the table
+   \param columns the columns to search, must be indexed
+   \param search the user entered search string
+   */
+  std::string GetFullTextCondition(const std::string &index, const std::string &table, const std::string &idColumn, const std::vector<std::string> &columns, const std::string &search);
+
+  /*! \brief Create the tables storing the results of smart playlists, to be called from CreateAnalytics().
+   Results stored before are discarded.
+   \sa GetSmartPlaylistCondition
+   */
+  void CreateSmartPlaylistCache();
+
+  /*! \brief Get the view and its id column the rules of smart playlists of a type are evaluated on.
+   \return false if the results of smart playlists of the type are not stored
+   */
+  virtual bool GetSmartPlaylistSource(const std::string &type, std::string &view, std::string &idColumn) const { return false; }
+
+  /*! \brief Get a condition selecting the stored results of a smart playlist.
+   The ids of the items matching the where clause are stored on first use, so opening the playlist
+   again doesn't evaluate its rules on the whole library. Derived classes keep the stored results
+   up to date with UpdateSmartPlaylistItems() and ClearSmartPlaylistCache().
+   \param type the item type of the smart playlist
+   \param where the where clause of the smart playlist, must not depend on the current time
+   \return the condition, or the where clause itself if the results could not be stored
+   */
+  std::string GetSmartPlaylistCondition(const std::string &type, const std::string &where);
+
+  /*! \brief Evaluate the stored smart playlists of a type again for changed items.
+   \param type the item type of the smart playlists
+   \param condition selects the changed items from the view of the type, e.g. "songview.idSong = 1"
+   */
+  void UpdateSmartPlaylistItems(const std::string &type, const std::string &condition);
+
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
 
   std::unique_ptr<dbiplus::Database> m_pDB;
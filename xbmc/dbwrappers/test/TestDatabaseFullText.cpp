@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/Database.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+class CTestFullTextDatabase : public CDatabase
+{
+public:
+  using CDatabase::GetFullTextCondition;
+  using CDatabase::GetFullTextQuery;
+  using CDatabase::HasFullTextIndex;
+
+  bool m_hasIndex = false;
+
+  std::set<int> Search(const std::string& search)
+  {
+    std::set<int> ids;
+    const std::string condition =
+        GetFullTextCondition("itemsearch", "item", "idItem", {"strTitle"}, search);
+    if (!m_pDS->query("SELECT idItem FROM item WHERE " + condition))
+      return ids;
+    for (; !m_pDS->eof(); m_pDS->next())
+      ids.insert(m_pDS->fv(0).get_asInt());
+    m_pDS->close();
+    return ids;
+  }
+
+  void AddItem(int id, const std::string& title)
+  {
+    m_pDS->exec(PrepareSQL("INSERT INTO item (idItem, strTitle) VALUES (%i, '%s')", id, title.c_str()));
+  }
+
+protected:
+  void CreateTables() override
+  {
+    m_pDS->exec("CREATE TABLE item (idItem INTEGER PRIMARY KEY, strTitle TEXT)");
+  }
+  void CreateAnalytics() override
+  {
+    m_hasIndex = CreateFullTextIndex("itemsearch", "item", "idItem", {"strTitle"});
+  }
+  int GetSchemaVersion() const override { return 1; }
+  const char* GetBaseDBName() const override { return "TestFullText"; }
+};
+
+} // unnamed namespace
+
+class TestDatabaseFullText : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    XFILE::CFile::Delete("special://temp/testfulltext");
+    ASSERT_TRUE(database.Connect("testfulltext", settings, true));
+
+    database.AddItem(1, "The Matrix");
+    database.AddItem(2, "Matrix Reloaded");
+    database.AddItem(3, "Amélie");
+    database.AddItem(4, "Ocean's Eleven");
+    database.AddItem(5, "Spider-Man 2");
+    database.AddItem(6, "Say \"Anything\"");
+  }
+
+  void TearDown() override
+  {
+    database.Close();
+    XFILE::CFile::Delete("special://temp/testfulltext");
+  }
+
+  CTestFullTextDatabase database;
+};
+
+TEST_F(TestDatabaseFullText, Query)
+{
+  EXPECT_EQ("\"matrix\"*", CTestFullTextDatabase::GetFullTextQuery("matrix"));
+  EXPECT_EQ("\"the\"* AND \"mat\"*", CTestFullTextDatabase::GetFullTextQuery("  the   mat "));
+  EXPECT_EQ("{strTitle strPlot} : \"x\"*",
+            CTestFullTextDatabase::GetFullTextQuery("x", {"strTitle", "strPlot"}));
+
+  // nothing of the search string is taken as FTS5 syntax
+  EXPECT_EQ("\"say\"* AND \"\"\"anything\"\"\"*",
+            CTestFullTextDatabase::GetFullTextQuery("say \"anything\""));
+  EXPECT_EQ("\"ocean's\"*", CTestFullTextDatabase::GetFullTextQuery("ocean's"));
+  EXPECT_EQ("\"spider-man\"*", CTestFullTextDatabase::GetFullTextQuery("spider-man"));
+  EXPECT_EQ("\"a*b\"* AND \"NOT\"*", CTestFullTextDatabase::GetFullTextQuery("a*b NOT"));
+
+  // words without letters or digits would be empty phrases
+  EXPECT_EQ("", CTestFullTextDatabase::GetFullTextQuery(""));
+  EXPECT_EQ("", CTestFullTextDatabase::GetFullTextQuery("   "));
+  EXPECT_EQ("", CTestFullTextDatabase::GetFullTextQuery("* - \"\""));
+  EXPECT_EQ("\"man\"*", CTestFullTextDatabase::GetFullTextQuery("- man *"));
+}
+
+TEST_F(TestDatabaseFullText, Condition)
+{
+  if (!database.m_hasIndex)
+    GTEST_SKIP() << "sqlite built without FTS5";
+  ASSERT_TRUE(database.HasFullTextIndex("itemsearch"));
+
+  EXPECT_EQ(std::set<int>({1, 2}), database.Search("matrix"));
+  EXPECT_EQ(std::set<int>({1, 2}), database.Search("MAT"));
+  EXPECT_EQ(std::set<int>({1}), database.Search("the matrix"));
+  EXPECT_EQ(std::set<int>({3}), database.Search("amelie"));
+  EXPECT_EQ(std::set<int>({4}), database.Search("ocean's"));
+  EXPECT_EQ(std::set<int>({5}), database.Search("spider-man"));
+  EXPECT_EQ(std::set<int>({6}), database.Search("\"anything\""));
+
+  // words are matched by prefix, not as substrings like with LIKE
+  EXPECT_TRUE(database.Search("atrix").empty());
+
+  // FTS5 operators and quotes are matched literally rather than failing the query
+  EXPECT_TRUE(database.Search("matrix NOT reloaded").empty());
+  EXPECT_TRUE(database.Search("matrix OR amelie").empty());
+  EXPECT_EQ(std::set<int>({1, 2}), database.Search("matrix*"));
+  EXPECT_EQ(std::set<int>({1, 2}), database.Search("-matrix"));
+  EXPECT_EQ(std::set<int>({4}), database.Search("'"));
+
+  // the index follows changes of the table
+  database.AddItem(7, "The Matrix Revolutions");
+  EXPECT_EQ(std::set<int>({1, 2, 7}), database.Search("matrix"));
+}
+
+TEST_F(TestDatabaseFullText, EmptySearch)
+{
+  // without any words the search falls back to LIKE
+  EXPECT_EQ(6u, database.Search("").size());
+  EXPECT_TRUE(database.Search(" * ").empty());
+
+  // a word of punctuation only doesn't prevent the other words from matching
+  if (database.m_hasIndex)
+    EXPECT_EQ(std::set<int>({5}), database.Search("- man *"));
+}
@@ -15,6 +15,7 @@
 
 #include "CircularCache.h"
 #include "threads/SingleLock.h"
+#include "utils/TraceRecorder.h"
 #include "utils/log.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -461,6 +462,7 @@ int CFileCache::Stat(const CURL& url, struct __stat64* buffer)
 
 ssize_t CFileCache::Read(void* lpBuf, size_t uiBufSize)
 {
+  TRACE_SCOPE("file", "CFileCache::Read");
   CSingleLock lock(m_sync);
   if (!m_pCache)
   {
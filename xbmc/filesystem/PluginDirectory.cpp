@@ -8,6 +8,7 @@
 
 #include "PluginDirectory.h"
 
+#include "PluginDirectoryCache.h"
 #include "Application.h"
 #include "FileItem.h"
 #include "ServiceBroker.h"
@@ -131,6 +132,7 @@ bool CPluginDirectory::StartScript(const std::string& strPath, bool retrievingDi
   // reset our wait event, and grab a new handle
   m_fetchComplete.Reset();
   int handle = CScriptInvocationManager::GetInstance().GetReusablePluginHandle(m_addon->LibPath());
+  const bool reused = handle >= 0;
 
   if (handle < 0)
     handle = getNewHandle(this);
@@ -145,6 +147,7 @@ bool CPluginDirectory::StartScript(const std::string& strPath, bool retrievingDi
   m_cancelled = false;
   m_success = false;
   m_totalItems = 0;
+  m_cacheLifetime = 0;
 
   // setup our parameters to send the script
   std::string strHandle = StringUtils::Format("%i", handle);
@@ -166,12 +169,27 @@ bool CPluginDirectory::StartScript(const std::string& strPath, bool retrievingDi
   if (m_addon->ExtraInfo().find("reuselanguageinvoker") != m_addon->ExtraInfo().end())
     reuseLanguageInvoker = m_addon->ExtraInfo().at("reuselanguageinvoker") == "true";
 
+  const unsigned int startTime = XbmcThreads::SystemClockMillis();
   int id = CScriptInvocationManager::GetInstance().ExecuteAsync(file, m_addon, argv,
                                                                 reuseLanguageInvoker, handle);
   if (id >= 0)
   { // wait for our script to finish
     std::string scriptName = m_addon->Name();
     success = WaitOnScriptResult(file, id, scriptName, retrievingDir);
+
+    if (reuseLanguageInvoker)
+    {
+      const unsigned int elapsed = XbmcThreads::SystemClockMillis() - startTime;
+      CScriptInvocationManager::GetInstance().AddPluginInvocationTime(reused, elapsed);
+      const CScriptInvocationManager::InvokerPoolStats stats =
+          CScriptInvocationManager::GetInstance().GetInvokerPoolStats();
+      CLog::Log(LOGDEBUG,
+                "%s - plugin %s took %u ms on a %s invoker (pool: %u hits avg %u ms, %u misses avg %u ms)",
+                __FUNCTION__, scriptName.c_str(), elapsed, reused ? "pooled" : "new", stats.hits,
+                stats.hits ? static_cast<unsigned int>(stats.hitTimeMs / stats.hits) : 0,
+                stats.misses,
+                stats.misses ? static_cast<unsigned int>(stats.missTimeMs / stats.misses) : 0);
+    }
   }
   else
     CLog::Log(LOGERROR, "Unable to run plugin %s", m_addon->Name().c_str());
@@ -442,7 +460,23 @@ void CPluginDirectory::AddSortMethod(int handle, SORT_METHOD sortMethod, const s
 bool CPluginDirectory::GetDirectory(const CURL& url, CFileItemList& items)
 {
   const std::string pathToUrl(url.Get());
+
+  CPluginDirectoryCache& cache = CPluginDirectoryCache::GetInstance();
+  const CPluginDirectoryCache::State state =
+      cache.Get(pathToUrl, items, (m_flags & DIR_FLAG_ALLOW_STALE) != 0);
+  if (state != CPluginDirectoryCache::State::MISSING)
+  {
+    CLog::Log(LOGDEBUG, "%s - using %s cached listing of %s", __FUNCTION__,
+              state == CPluginDirectoryCache::State::STALE ? "stale" : "fresh",
+              CURL::GetRedacted(pathToUrl).c_str());
+    // let the caller know it should fetch a fresh listing
+    items.SetProperty("plugin.stale", state == CPluginDirectoryCache::State::STALE);
+    return true;
+  }
+
   bool success = StartScript(pathToUrl, true, false);
+  if (success && m_cacheLifetime > 0)
+    cache.Set(pathToUrl, *m_listItems, m_cacheLifetime, m_listItems->CacheToDiscIfSlow());
 
   // append the items to the list
   items.Assign(*m_listItems, true); // true to keep the current items
@@ -450,6 +484,19 @@ bool CPluginDirectory::GetDirectory(const CURL& url, CFileItemList& items)
   return success;
 }
 
+void CPluginDirectory::InvalidateCache(const std::string& strPath, const std::string& addonId)
+{
+  const std::string host = CURL(strPath).GetHostName();
+  if (host != addonId || !CServiceBroker::GetAddonMgr().IsAddonInstalled(host))
+  {
+    CLog::Log(LOGWARNING, "%s - %s may not drop the cached listings of %s", __FUNCTION__,
+              addonId.c_str(), CURL::GetRedacted(strPath).c_str());
+    return;
+  }
+
+  CPluginDirectoryCache::GetInstance().Invalidate(strPath);
+}
+
 bool CPluginDirectory::RunScriptWithParams(const std::string& strPath, bool resume)
 {
   CURL url(strPath);
@@ -597,6 +644,14 @@ void CPluginDirectory::SetProperty(int handle, const std::string &strProperty, c
     dir->m_listItems->SetProperty(strProperty, strValue);
 }
 
+void CPluginDirectory::SetCacheLifetime(int handle, int lifetime)
+{
+  CSingleLock lock(m_handleLock);
+  CPluginDirectory *dir = dirFromHandle(handle);
+  if (dir)
+    dir->m_cacheLifetime = lifetime;
+}
+
 void CPluginDirectory::CancelDirectory()
 {
   m_cancelled = true;
@@ -67,6 +67,13 @@ public:
   static void SetProperty(int handle, const std::string &strProperty, const std::string &strValue);
   static void SetResolvedUrl(int handle, bool success, const CFileItem* resultItem);
   static void SetLabel2(int handle, const std::string& ident);
+  static void SetCacheLifetime(int handle, int lifetime);
+
+  /*! \brief Drop the cached listing of a plugin url, see CPluginDirectoryCache::Invalidate.
+  \param strPath plugin url, the root of a plugin drops all its listings.
+  \param addonId the calling add-on, only its own listings may be dropped.
+  */
+  static void InvalidateCache(const std::string& strPath, const std::string& addonId);
 
 private:
   ADDON::AddonPtr m_addon;
@@ -89,6 +96,7 @@ private:
   std::atomic<bool> m_cancelled;
   bool          m_success = false;      // set by script in EndOfDirectory
   int    m_totalItems = 0;   // set by script in AddDirectoryItem
+  int    m_cacheLifetime = 0; // set by script in SetCacheLifetime
 
   class CScriptObserver : public CThread
   {
@@ -0,0 +1,311 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PluginDirectoryCache.h"
+
+#include "FileItem.h"
+#include "URL.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace XFILE;
+
+constexpr time_t CPluginDirectoryCache::STALE_LIFETIME;
+constexpr size_t CPluginDirectoryCache::MAX_ENTRIES;
+constexpr size_t CPluginDirectoryCache::MAX_DISK_ENTRIES;
+
+namespace
+{
+// bounds the markers of urls without a listing on disk
+constexpr size_t MAX_NOT_ON_DISK = 1024;
+}
+
+CPluginDirectoryCache& CPluginDirectoryCache::GetInstance()
+{
+  static CPluginDirectoryCache cache;
+  return cache;
+}
+
+CPluginDirectoryCache::State CPluginDirectoryCache::Get(const std::string& url,
+                                                        CFileItemList& items,
+                                                        bool allowStale)
+{
+  Entry entry;
+  {
+    CSingleLock lock(m_section);
+    auto it = m_entries.find(url);
+    if (it != m_entries.end())
+      entry = it->second;
+    else if (m_notOnDisk.find(url) != m_notOnDisk.end())
+    {
+      m_misses++;
+      return State::MISSING;
+    }
+  }
+
+  if (!entry.items)
+  {
+    if (!Load(url, entry))
+    {
+      CSingleLock lock(m_section);
+      m_misses++;
+      // unless it has been set meanwhile
+      if (m_entries.find(url) == m_entries.end())
+      {
+        if (m_notOnDisk.size() >= MAX_NOT_ON_DISK)
+          m_notOnDisk.clear();
+        m_notOnDisk.insert(url);
+      }
+      return State::MISSING;
+    }
+    Insert(url, entry);
+  }
+
+  const time_t now = time(nullptr);
+  const bool stale = now >= entry.expires;
+
+  CSingleLock lock(m_section);
+  if (stale && (!allowStale || now >= entry.expires + STALE_LIFETIME))
+  {
+    m_misses++;
+    return State::MISSING;
+  }
+
+  if (stale)
+    m_staleHits++;
+  else
+    m_hits++;
+  lock.Leave();
+
+  // items are changed by their users, e.g. when loading thumbs
+  CFileItemList cached;
+  cached.Copy(*entry.items);
+  items.Assign(cached, true);
+
+  return stale ? State::STALE : State::FRESH;
+}
+
+void CPluginDirectoryCache::Set(const std::string& url,
+                                const CFileItemList& items,
+                                int lifetime,
+                                bool toDisk)
+{
+  if (lifetime <= 0)
+    return;
+
+  Entry entry;
+  entry.items = std::make_shared<CFileItemList>();
+  entry.items->Copy(items);
+  entry.expires = time(nullptr) + lifetime;
+  Insert(url, entry);
+
+  if (toDisk)
+  {
+    {
+      CSingleLock lock(m_section);
+      m_notOnDisk.erase(url);
+    }
+    Save(url, entry);
+    TrimDisk(CURL(url).GetHostName());
+  }
+  else
+    CFile::Delete(GetCacheFile(url));
+}
+
+void CPluginDirectoryCache::Insert(const std::string& url, const Entry& entry)
+{
+  CSingleLock lock(m_section);
+  m_entries[url] = entry;
+
+  // drop the listings expiring first
+  while (m_entries.size() > MAX_ENTRIES)
+  {
+    auto oldest = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+      if (it->second.expires < oldest->second.expires)
+        oldest = it;
+    }
+    m_entries.erase(oldest);
+  }
+}
+
+void CPluginDirectoryCache::Invalidate(const std::string& url)
+{
+  const CURL curl(url);
+  const std::string addonId = curl.GetHostName();
+  if (!IsValidAddonId(addonId))
+  {
+    CLog::Log(LOGWARNING, "CPluginDirectoryCache::{} - not a plugin url {}", __FUNCTION__,
+              CURL::GetRedacted(url));
+    return;
+  }
+
+  if (curl.GetFileName().empty() && curl.GetOptions().empty())
+  {
+    CLog::Log(LOGDEBUG, "CPluginDirectoryCache::{} - dropping all listings of {}", __FUNCTION__,
+              addonId);
+    {
+      CSingleLock lock(m_section);
+      for (auto it = m_entries.begin(); it != m_entries.end();)
+      {
+        if (CURL(it->first).GetHostName() == addonId)
+          it = m_entries.erase(it);
+        else
+          ++it;
+      }
+    }
+    CDirectory::RemoveRecursive(GetCachePath(addonId));
+    return;
+  }
+
+  {
+    CSingleLock lock(m_section);
+    m_entries.erase(url);
+  }
+  CFile::Delete(GetCacheFile(url));
+}
+
+void CPluginDirectoryCache::Clear()
+{
+  CSingleLock lock(m_section);
+  m_entries.clear();
+  m_notOnDisk.clear();
+}
+
+unsigned int CPluginDirectoryCache::GetHits() const
+{
+  CSingleLock lock(m_section);
+  return m_hits;
+}
+
+unsigned int CPluginDirectoryCache::GetStaleHits() const
+{
+  CSingleLock lock(m_section);
+  return m_staleHits;
+}
+
+unsigned int CPluginDirectoryCache::GetMisses() const
+{
+  CSingleLock lock(m_section);
+  return m_misses;
+}
+
+bool CPluginDirectoryCache::IsValidAddonId(const std::string& addonId)
+{
+  // the id names a directory of the cache, it must not lead out of it
+  if (addonId.empty() || addonId == "." || addonId == "..")
+    return false;
+
+  return std::all_of(addonId.begin(), addonId.end(), [](char c) {
+    return StringUtils::isasciialphanum(c) || c == '.' || c == '_' || c == '-';
+  });
+}
+
+std::string CPluginDirectoryCache::GetCachePath(const std::string& addonId)
+{
+  return URIUtils::AddFileToFolder("special://temp/plugin_cache/", addonId + "/");
+}
+
+std::string CPluginDirectoryCache::GetCacheFile(const std::string& url)
+{
+  return GetCachePath(CURL(url).GetHostName()) +
+         StringUtils::Format("{:08x}.fi", Crc32::Compute(url));
+}
+
+bool CPluginDirectoryCache::Load(const std::string& url, Entry& entry)
+{
+  const std::string path = GetCacheFile(url);
+  CFile file;
+  if (!file.Open(path))
+    return false;
+
+  bool remove = false;
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+    std::string cachedUrl;
+    int64_t expires;
+    ar >> cachedUrl;
+    ar >> expires;
+    // another url with the same hash, its listing is still valid
+    if (cachedUrl != url)
+      return false;
+
+    if (time(nullptr) >= static_cast<time_t>(expires) + STALE_LIFETIME)
+      remove = true;
+    else
+    {
+      std::shared_ptr<CFileItemList> items = std::make_shared<CFileItemList>();
+      ar >> *items;
+      entry.items = items;
+      entry.expires = static_cast<time_t>(expires);
+    }
+    ar.Close();
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "CPluginDirectoryCache::{} - corrupt archive {}", __FUNCTION__, path);
+    remove = true;
+  }
+
+  if (remove)
+  {
+    file.Close();
+    CFile::Delete(path);
+    return false;
+  }
+  return entry.items != nullptr;
+}
+
+void CPluginDirectoryCache::Save(const std::string& url, const Entry& entry)
+{
+  const std::string path = GetCachePath(CURL(url).GetHostName());
+  if (!CDirectory::Exists(path) && !CDirectory::Create(path))
+    return;
+
+  CFile file;
+  if (!file.OpenForWrite(GetCacheFile(url), true))
+    return;
+
+  CArchive ar(&file, CArchive::store);
+  ar << url;
+  ar << static_cast<int64_t>(entry.expires);
+  ar << *entry.items;
+  ar.Close();
+}
+
+void CPluginDirectoryCache::TrimDisk(const std::string& addonId)
+{
+  CFileItemList files;
+  if (!CDirectory::GetDirectory(GetCachePath(addonId), files, ".fi",
+                                DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE) ||
+      static_cast<size_t>(files.Size()) <= MAX_DISK_ENTRIES)
+    return;
+
+  std::vector<CFileItemPtr> sorted(files.begin(), files.end());
+  std::sort(sorted.begin(), sorted.end(), [](const CFileItemPtr& a, const CFileItemPtr& b) {
+    return a->m_dateTime < b->m_dateTime;
+  });
+
+  const size_t excess = sorted.size() - MAX_DISK_ENTRIES;
+  CLog::Log(LOGDEBUG, "CPluginDirectoryCache::{} - dropping {} listings of {} from disk",
+            __FUNCTION__, excess, addonId);
+  for (size_t i = 0; i < excess; i++)
+    CFile::Delete(sorted[i]->GetPath());
+}
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+class CFileItemList;
+
+namespace XFILE
+{
+
+/*!
+ \brief Listings of plugins which declared a cache lifetime for them.
+
+ Listings are keyed by the full plugin url including its options. They're kept in memory and,
+ unless the plugin disabled caching to disc, on disk so that they survive a restart. Once their
+ lifetime is over they're stale and are only handed out to callers accepting that, e.g. widgets
+ showing them while a fresh listing is fetched. Listings on disk are deleted when they're found
+ past STALE_LIFETIME, and at most MAX_DISK_ENTRIES are kept per plugin.
+ */
+class CPluginDirectoryCache
+{
+public:
+  enum class State
+  {
+    MISSING,
+    FRESH,
+    STALE
+  };
+
+  static CPluginDirectoryCache& GetInstance();
+
+  /*!
+   \brief Get the cached listing of url, appended to items.
+   \param allowStale whether a listing past its lifetime may be returned
+   \return FRESH or STALE if items have been filled in, MISSING otherwise
+   */
+  State Get(const std::string& url, CFileItemList& items, bool allowStale);
+
+  /*!
+   \brief Cache the listing of url.
+   \param lifetime seconds the listing is fresh, nothing is cached if not positive
+   \param toDisk whether to also keep it on disk
+   */
+  void Set(const std::string& url, const CFileItemList& items, int lifetime, bool toDisk);
+
+  /*!
+   \brief Drop the cached listing of url. Given the root of a plugin, e.g. plugin://plugin.video.foo/,
+   all its listings are dropped. Urls whose host is not a well formed add-on id are ignored.
+   */
+  void Invalidate(const std::string& url);
+
+  void Clear();
+
+  unsigned int GetHits() const;
+  unsigned int GetStaleHits() const;
+  unsigned int GetMisses() const;
+
+  // how long after their lifetime stale listings are kept
+  static constexpr time_t STALE_LIFETIME = 24 * 60 * 60;
+  static constexpr size_t MAX_ENTRIES = 64;
+  // listings kept on disk per plugin, the least recently written are dropped beyond it
+  static constexpr size_t MAX_DISK_ENTRIES = 256;
+
+private:
+  CPluginDirectoryCache() = default;
+  CPluginDirectoryCache(const CPluginDirectoryCache&) = delete;
+  CPluginDirectoryCache& operator=(const CPluginDirectoryCache&) = delete;
+
+  struct Entry
+  {
+    std::shared_ptr<CFileItemList> items;
+    time_t expires = 0;
+  };
+
+  void Insert(const std::string& url, const Entry& entry);
+
+  static bool IsValidAddonId(const std::string& addonId);
+  static std::string GetCachePath(const std::string& addonId);
+  static std::string GetCacheFile(const std::string& url);
+  static bool Load(const std::string& url, Entry& entry);
+  static void Save(const std::string& url, const Entry& entry);
+  static void TrimDisk(const std::string& addonId);
+
+  mutable CCriticalSection m_section;
+  std::map<std::string, Entry> m_entries;
+  std::set<std::string> m_notOnDisk; // urls without a listing on disk, e.g. of plugins never caching
+  unsigned int m_hits = 0;
+  unsigned int m_staleHits = 0;
+  unsigned int m_misses = 0;
+};
+
+}
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "filesystem/File.h"
+#include "filesystem/PluginDirectoryCache.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+
+void FillListing(CFileItemList& items, const std::string& path, int count)
+{
+  items.SetPath(path);
+  items.SetContent("movies");
+  for (int i = 0; i < count; i++)
+  {
+    CFileItemPtr item = std::make_shared<CFileItem>("item " + std::to_string(i));
+    item->SetPath(path + "?item=" + std::to_string(i));
+    items.Add(item);
+  }
+}
+
+} // unnamed namespace
+
+class TestPluginDirectoryCache : public testing::Test
+{
+protected:
+  TestPluginDirectoryCache()
+  {
+    CPluginDirectoryCache::GetInstance().Invalidate("plugin://plugin.test.cache/");
+  }
+  ~TestPluginDirectoryCache() override
+  {
+    CPluginDirectoryCache::GetInstance().Invalidate("plugin://plugin.test.cache/");
+  }
+};
+
+TEST_F(TestPluginDirectoryCache, Fresh)
+{
+  CPluginDirectoryCache& cache = CPluginDirectoryCache::GetInstance();
+  const std::string url = "plugin://plugin.test.cache/?mode=fresh";
+
+  CFileItemList items;
+  EXPECT_EQ(CPluginDirectoryCache::State::MISSING, cache.Get(url, items, true));
+  EXPECT_TRUE(items.IsEmpty());
+
+  CFileItemList listing;
+  FillListing(listing, url, 3);
+  cache.Set(url, listing, 60, false);
+
+  EXPECT_EQ(CPluginDirectoryCache::State::FRESH, cache.Get(url, items, false));
+  ASSERT_EQ(3, items.Size());
+  EXPECT_EQ("item 1", items[1]->GetLabel());
+  EXPECT_EQ("movies", items.GetContent());
+
+  // the cached items are not shared with the caller
+  items[1]->SetLabel("changed");
+  CFileItemList again;
+  EXPECT_EQ(CPluginDirectoryCache::State::FRESH, cache.Get(url, again, false));
+  EXPECT_EQ("item 1", again[1]->GetLabel());
+
+  // nothing is cached without a lifetime
+  cache.Set("plugin://plugin.test.cache/?mode=none", listing, 0, false);
+  CFileItemList none;
+  EXPECT_EQ(CPluginDirectoryCache::State::MISSING,
+            cache.Get("plugin://plugin.test.cache/?mode=none", none, true));
+}
+
+TEST_F(TestPluginDirectoryCache, Stale)
+{
+  CPluginDirectoryCache& cache = CPluginDirectoryCache::GetInstance();
+  const std::string url = "plugin://plugin.test.cache/?mode=stale";
+
+  CFileItemList listing;
+  FillListing(listing, url, 2);
+  cache.Set(url, listing, 1, false);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+
+  CFileItemList items;
+  EXPECT_EQ(CPluginDirectoryCache::State::MISSING, cache.Get(url, items, false));
+  EXPECT_TRUE(items.IsEmpty());
+  EXPECT_EQ(CPluginDirectoryCache::State::STALE, cache.Get(url, items, true));
+  EXPECT_EQ(2, items.Size());
+}
+
+TEST_F(TestPluginDirectoryCache, Invalidate)
+{
+  CPluginDirectoryCache& cache = CPluginDirectoryCache::GetInstance();
+  const std::string first = "plugin://plugin.test.cache/?mode=first";
+  const std::string second = "plugin://plugin.test.cache/?mode=second";
+
+  CFileItemList listing;
+  FillListing(listing, first, 1);
+  cache.Set(first, listing, 60, false);
+  cache.Set(second, listing, 60, false);
+
+  cache.Invalidate(first);
+  CFileItemList items;
+  EXPECT_EQ(CPluginDirectoryCache::State::MISSING, cache.Get(first, items, true));
+  EXPECT_EQ(CPluginDirectoryCache::State::FRESH, cache.Get(second, items, true));
+
+  cache.Invalidate("plugin://plugin.test.cache/");
+  items.Clear();
+  EXPECT_EQ(CPluginDirectoryCache::State::MISSING, cache.Get(second, items, true));
+}
+
+TEST_F(TestPluginDirectoryCache, Disk)
+{
+  CPluginDirectoryCache& cache = CPluginDirectoryCache::GetInstance();
+  const std::string url = "plugin://plugin.test.cache/?mode=disk";
+
+  CFileItemList listing;
+  FillListing(listing, url, 4);
+  cache.Set(url, listing, 60, true);
+
+  // as after a restart
+  cache.Clear();
+  CFileItemList items;
+  EXPECT_EQ(CPluginDirectoryCache::State::FRESH, cache.Get(url, items, false));
+  ASSERT_EQ(4, items.Size());
+  EXPECT_EQ(url + "?item=3", items[3]->GetPath());
+}
+
+TEST_F(TestPluginDirectoryCache, InvalidateOutsideCache)
+{
+  CPluginDirectoryCache& cache = CPluginDirectoryCache::GetInstance();
+  const std::string url = "plugin://plugin.test.cache/?mode=outside";
+  const std::string guard = "special://temp/plugin_cache_guard.txt";
+
+  CFileItemList listing;
+  FillListing(listing, url, 1);
+  cache.Set(url, listing, 60, true);
+
+  XFILE::CFile file;
+  ASSERT_TRUE(file.OpenForWrite(guard, true));
+  file.Close();
+
+  // would name special://temp/ itself
+  cache.Invalidate("plugin://../");
+  cache.Invalidate("plugin://./");
+  EXPECT_TRUE(XFILE::CFile::Exists(guard));
+
+  cache.Clear();
+  CFileItemList items;
+  EXPECT_EQ(CPluginDirectoryCache::State::FRESH, cache.Get(url, items, false));
+
+  XFILE::CFile::Delete(guard);
+}
@@ -11,6 +11,7 @@
 #include "guilib/Texture.h"
 
 #include <algorithm>
+#include <chrono>
 
 extern "C"
 {
@@ -64,6 +65,55 @@ struct ThumbDataManagement
   }
 };
 
+namespace
+{
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*!
+ \brief Read the dimensions from the frame header of a baseline or progressive JPEG.
+ Other JPEG flavours (lossless, arithmetic coding) can't be decoded at a reduced size.
+ */
+bool GetJpegSize(const unsigned char* buffer, size_t size, unsigned int& width, unsigned int& height)
+{
+  size_t pos = 2; // skip SOI
+  while (pos + 4 <= size)
+  {
+    if (buffer[pos] != 0xFF)
+      return false;
+
+    const unsigned char marker = buffer[pos + 1];
+    if (marker == 0xFF)
+    { // fill byte
+      pos++;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8))
+    { // markers without a segment
+      pos += 2;
+      continue;
+    }
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+    { // start of frame: length, precision, height, width
+      if (marker > 0xC2 || pos + 9 > size)
+        return false;
+      height = (buffer[pos + 5] << 8) | buffer[pos + 6];
+      width = (buffer[pos + 7] << 8) | buffer[pos + 8];
+      return width > 0 && height > 0;
+    }
+    if (marker == 0xD9 || marker == 0xDA)
+      return false; // end of image or start of scan before the frame header
+
+    pos += 2 + ((buffer[pos + 2] << 8) | buffer[pos + 3]);
+  }
+  return false;
+}
+
+} // unnamed namespace
+
 // valid positions are including 0 (start of buffer)
 // and bufferSize -1 last data point
 static inline size_t Clamp(int64_t newPosition, size_t bufferSize)
@@ -138,7 +188,10 @@ CFFmpegImage::~CFFmpegImage()
 bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSize,
                                       unsigned int width, unsigned int height)
 {
+  const auto start = std::chrono::steady_clock::now();
 
+  m_maxWidth = width;
+  m_maxHeight = height;
   if (!Initialize(buffer, bufSize))
   {
     //log
@@ -148,6 +201,7 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
   av_frame_free(&m_pFrame);
   m_pFrame = ExtractFrame();
 
+  m_decodeTime = MillisecondsSince(start);
   return !(m_pFrame == nullptr);
 }
 
@@ -249,6 +303,10 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
     return false;
   }
 
+  // let the decoder skip what would be scaled away anyway, e.g. JPEG in the DCT domain
+  if (codec && codec->max_lowres > 0)
+    m_codec_ctx->lowres = GetLowres(codec->max_lowres, buffer, bufSize);
+
   if (avcodec_open2(m_codec_ctx, codec, NULL) < 0)
   {
     avformat_close_input(&m_fctx);
@@ -260,6 +318,47 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
   return true;
 }
 
+int CFFmpegImage::GetLowres(int maxLowres, unsigned char* buffer, size_t bufSize)
+{
+  m_sourceWidth = m_sourceHeight = 0;
+  if (m_maxWidth == 0 || m_maxHeight == 0 || !GetJpegSize(buffer, bufSize, m_sourceWidth, m_sourceHeight))
+    return 0;
+
+  unsigned int scaledWidth, scaledHeight;
+  GetScaledSize(m_sourceWidth, m_sourceHeight, m_maxWidth, m_maxHeight, scaledWidth, scaledHeight);
+
+  // largest reduction (by 2^lowres, rounded up) not going below the scaled size
+  int lowres = 0;
+  while (lowres < maxLowres)
+  {
+    const unsigned int factor = 1u << (lowres + 1);
+    if ((m_sourceWidth + factor - 1) / factor < scaledWidth ||
+        (m_sourceHeight + factor - 1) / factor < scaledHeight)
+      break;
+    lowres++;
+  }
+  return lowres;
+}
+
+void CFFmpegImage::GetScaledSize(unsigned int width, unsigned int height, unsigned int maxWidth,
+                                 unsigned int maxHeight, unsigned int &scaledWidth, unsigned int &scaledHeight)
+{
+  // assumption quadratic maximums e.g. 2048x2048
+  float ratio = width / (float)height;
+  scaledHeight = height;
+  scaledWidth = width;
+  if (scaledHeight > maxHeight)
+  {
+    scaledHeight = maxHeight;
+    scaledWidth = (unsigned int)(scaledHeight * ratio + 0.5f);
+  }
+  if (scaledWidth > maxWidth)
+  {
+    scaledWidth = maxWidth;
+    scaledHeight = (unsigned int)(scaledWidth / ratio + 0.5f);
+  }
+}
+
 AVFrame* CFFmpegImage::ExtractFrame()
 {
   if (!m_fctx || !m_fctx->streams[0])
@@ -293,8 +392,8 @@ AVFrame* CFFmpegImage::ExtractFrame()
   frame->pkt_duration = av_rescale_q(frame->pkt_duration, m_fctx->streams[0]->time_base, AVRational{ 1, 1000 });
   m_height = frame->height;
   m_width = frame->width;
-  m_originalWidth = m_width;
-  m_originalHeight = m_height;
+  m_originalWidth = m_codec_ctx->lowres ? m_sourceWidth : m_width;
+  m_originalHeight = m_codec_ctx->lowres ? m_sourceHeight : m_height;
 
   const AVPixFmtDescriptor* pixDescriptor = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
   if (pixDescriptor && ((pixDescriptor->flags & (AV_PIX_FMT_FLAG_ALPHA | AV_PIX_FMT_FLAG_PAL)) != 0))
@@ -363,7 +462,17 @@ bool CFFmpegImage::Decode(unsigned char * const pixels, unsigned int width, unsi
     return false;
   }
 
-  return DecodeFrame(m_pFrame, width, height, pitch, pixels);
+  const unsigned int decodedWidth = m_width;
+  const unsigned int decodedHeight = m_height;
+  const auto start = std::chrono::steady_clock::now();
+  if (!DecodeFrame(m_pFrame, width, height, pitch, pixels))
+    return false;
+
+  CLog::Log(LOGDEBUG, LOGFFMPEG,
+            "CFFmpegImage::Decode: decoded {}x{} of {}x{} (lowres {}) in {:.1f} ms, scaled to {}x{} in {:.1f} ms",
+            decodedWidth, decodedHeight, m_originalWidth, m_originalHeight, m_codec_ctx->lowres,
+            m_decodeTime, m_width, m_height, MillisecondsSince(start));
+  return true;
 }
 
 int CFFmpegImage::EncodeFFmpegFrame(AVCodecContext *avctx, AVPacket *pkt, int *got_packet, AVFrame *frame)
@@ -466,22 +575,10 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
   AVColorRange range = frame->color_range;
   AVPixelFormat pixFormat = ConvertFormats(frame);
 
-  // assumption quadratic maximums e.g. 2048x2048
-  float ratio = m_width / (float)m_height;
-  unsigned int nHeight = m_originalHeight;
-  unsigned int nWidth = m_originalWidth;
-  if (nHeight > height)
-  {
-    nHeight = height;
-    nWidth = (unsigned int)(nHeight * ratio + 0.5f);
-  }
-  if (nWidth > width)
-  {
-    nWidth = width;
-    nHeight = (unsigned int)(nWidth / ratio + 0.5f);
-  }
+  unsigned int nWidth, nHeight;
+  GetScaledSize(frame->width, frame->height, width, height, nWidth, nHeight);
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
+  struct SwsContext* context = sws_getContext(frame->width, frame->height, pixFormat,
     nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
 
   if (range == AVCOL_RANGE_JPEG)
@@ -494,7 +591,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
   }
 
-  sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
+  sws_scale(context, frame->data, frame->linesize, 0, frame->height,
     pictureRGB->data, pictureRGB->linesize);
   sws_freeContext(context);
 
@@ -80,6 +80,9 @@ private:
   static int EncodeFFmpegFrame(AVCodecContext *avctx, AVPacket *pkt, int *got_packet, AVFrame *frame);
   static int DecodeFFmpegFrame(AVCodecContext *avctx, AVFrame *frame, int *got_frame, AVPacket *pkt);
   static AVPixelFormat ConvertFormats(AVFrame* frame);
+  static void GetScaledSize(unsigned int width, unsigned int height, unsigned int maxWidth,
+                            unsigned int maxHeight, unsigned int &scaledWidth, unsigned int &scaledHeight);
+  int GetLowres(int maxLowres, unsigned char* buffer, size_t bufSize);
   std::string m_strMimeType;
   void CleanupLocalOutputBuffer();
 
@@ -92,4 +95,12 @@ private:
 
   AVFrame* m_pFrame;
   uint8_t* m_outputBuffer;
+
+  // size the image will be scaled to fit into, allows decoding at a reduced size
+  unsigned int m_maxWidth = 0;
+  unsigned int m_maxHeight = 0;
+  // size of the source image, if decoded at a reduced size
+  unsigned int m_sourceWidth = 0;
+  unsigned int m_sourceHeight = 0;
+  double m_decodeTime = 0.0;
 };
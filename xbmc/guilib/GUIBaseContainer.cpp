@@ -162,7 +162,7 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
   {
     if (!item->GetFocusedLayout())
     {
-      item->SetFocusedLayout(CGUIListItemLayoutPtr(new CGUIListItemLayout(*m_focusedLayout, this)));
+      item->SetFocusedLayout(m_focusedLayoutPool.Get(*m_focusedLayout, this));
     }
     if (item->GetFocusedLayout())
     {
@@ -187,11 +187,7 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
     if (item->GetFocusedLayout())
       item->GetFocusedLayout()->SetFocusedItem(0);  // focus is not set
     if (!item->GetLayout())
-    {
-      CGUIListItemLayoutPtr layout(new CGUIListItemLayout(*m_layout));
-      layout->SetParentControl(this);
-      item->SetLayout(std::move(layout));
-    }
+      item->SetLayout(m_layoutPool.Get(*m_layout, this));
     if (item->GetFocusedLayout())
       item->GetFocusedLayout()->Process(item.get(), m_parentID, currentTime, dirtyregions);
     if (item->GetLayout())
@@ -901,6 +897,8 @@ void CGUIBaseContainer::FreeResources(bool immediately)
     }
   }
   m_scroller.Stop();
+  m_layoutPool.Clear();
+  m_focusedLayoutPool.Clear();
 }
 
 void CGUIBaseContainer::UpdateLayout(bool updateAllItems)
@@ -909,6 +907,8 @@ void CGUIBaseContainer::UpdateLayout(bool updateAllItems)
   { // free memory of items
     for (iItems it = m_items.begin(); it != m_items.end(); ++it)
       (*it)->FreeMemory();
+    m_layoutPool.Clear();
+    m_focusedLayoutPool.Clear();
   }
   // and recalculate the layout
   CalculateLayout();
@@ -1032,6 +1032,10 @@ void CGUIBaseContainer::CalculateLayout()
   if (oldLayout == m_layout && oldFocusedLayout == m_focusedLayout)
     return; // nothing has changed, so don't update stuff
 
+  // copies of the previous layouts can't be reused
+  m_layoutPool.Clear();
+  m_focusedLayoutPool.Clear();
+
   m_itemsPerPage = std::max((int)((Size() - m_focusedLayout->Size(m_orientation)) / m_layout->Size(m_orientation)) + 1, 1);
 
   // ensure that the scroll offset is a multiple of our size
@@ -1173,6 +1177,9 @@ int CGUIBaseContainer::CorrectOffset(int offset, int cursor) const
 void CGUIBaseContainer::Reset()
 {
   m_wasReset = true;
+  // the new items can reuse the layouts of the old ones
+  for (auto& item : m_items)
+    ReleaseLayouts(*item);
   m_items.clear();
   m_lastItem.reset();
   ResetAutoScrolling();
@@ -1223,15 +1230,54 @@ void CGUIBaseContainer::FreeMemory(int keepStart, int keepEnd)
   if (keepStart < keepEnd)
   { // remove before keepStart and after keepEnd
     for (int i = 0; i < keepStart && i < (int)m_items.size(); ++i)
-      m_items[i]->FreeMemory();
+      ReleaseLayouts(*m_items[i]);
     for (int i = std::max(keepEnd + 1, 0); i < (int)m_items.size(); ++i)
-      m_items[i]->FreeMemory();
+      ReleaseLayouts(*m_items[i]);
   }
   else
   { // wrapping
     for (int i = std::max(keepEnd + 1, 0); i < keepStart && i < (int)m_items.size(); ++i)
-      m_items[i]->FreeMemory();
+      ReleaseLayouts(*m_items[i]);
+  }
+}
+
+void CGUIBaseContainer::ReleaseLayouts(CGUIListItem &item)
+{
+  m_layoutPool.Release(item.TakeLayout(), m_layout);
+  m_focusedLayoutPool.Release(item.TakeFocusedLayout(), m_focusedLayout);
+}
+
+CGUIBaseContainer::CLayoutPool::~CLayoutPool() = default;
+
+CGUIListItemLayoutPtr CGUIBaseContainer::CLayoutPool::Get(const CGUIListItemLayout &from, CGUIControl *control)
+{
+  if (!m_layouts.empty() && m_layouts.back()->IsCopyOf(from))
+  {
+    CGUIListItemLayoutPtr layout = std::move(m_layouts.back());
+    m_layouts.pop_back();
+    layout->SetParentControl(control);
+    return layout;
   }
+  return CGUIListItemLayoutPtr(new CGUIListItemLayout(from, control));
+}
+
+void CGUIBaseContainer::CLayoutPool::Release(CGUIListItemLayoutPtr layout, const CGUIListItemLayout *current)
+{
+  if (!layout)
+    return;
+
+  if (current && layout->IsCopyOf(*current))
+  {
+    layout->Recycle();
+    m_layouts.push_back(std::move(layout));
+  }
+  else
+    layout->FreeResources();
+}
+
+void CGUIBaseContainer::CLayoutPool::Clear()
+{
+  m_layouts.clear();
 }
 
 bool CGUIBaseContainer::InsideLayout(const CGUIListItemLayout *layout, const CPoint &point) const
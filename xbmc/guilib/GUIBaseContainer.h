@@ -14,6 +14,7 @@
 */
 
 #include "GUIAction.h"
+#include "GUIListItem.h"
 #include "IGUIContainer.h"
 #include "utils/Stopwatch.h"
 
@@ -208,7 +209,27 @@ protected:
   unsigned int m_lastRenderTime;
 
 private:
+  /*! \brief Layouts released by items that went out of view, reused for the items coming
+   into view instead of copying the template controls for each of them.
+   */
+  class CLayoutPool
+  {
+  public:
+    CLayoutPool() = default;
+    CLayoutPool(const CLayoutPool &) {} // copies start empty, the layouts belong to their container
+    CLayoutPool &operator=(const CLayoutPool &) = delete;
+    ~CLayoutPool();
+
+    CGUIListItemLayoutPtr Get(const CGUIListItemLayout &from, CGUIControl *control);
+    void Release(CGUIListItemLayoutPtr layout, const CGUIListItemLayout *current);
+    void Clear();
+
+  private:
+    std::vector<CGUIListItemLayoutPtr> m_layouts;
+  };
+
   bool OnContextMenu();
+  void ReleaseLayouts(CGUIListItem &item);
 
   int m_cursor;
   int m_offset;
@@ -230,6 +251,9 @@ private:
   // early inertial scroll cancellation
   bool m_waitForScrollEnd = false;
   float m_lastScrollValue = 0.0f;
+
+  CLayoutPool m_layoutPool;
+  CLayoutPool m_focusedLayoutPool;
 };
 
 
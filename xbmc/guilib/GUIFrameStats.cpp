@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFrameStats.h"
+
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <chrono>
+
+void CGUIFrameStats::Add(Phase phase, int64_t duration)
+{
+  m_durations[phase][m_count[phase] % FRAMES] = duration;
+  m_count[phase]++;
+}
+
+CGUIFrameStats::PhaseStats CGUIFrameStats::Get(Phase phase) const
+{
+  PhaseStats stats;
+  const unsigned int count = m_count[phase];
+  if (count == 0)
+    return stats;
+
+  const unsigned int frames = std::min(count, FRAMES);
+  int64_t total = 0;
+  int64_t max = 0;
+  for (unsigned int i = 0; i < frames; i++)
+  {
+    total += m_durations[phase][i];
+    max = std::max(max, m_durations[phase][i]);
+  }
+
+  stats.last = m_durations[phase][(count - 1) % FRAMES] / 1000000.0;
+  stats.average = total / 1000000.0 / frames;
+  stats.max = max / 1000000.0;
+  return stats;
+}
+
+std::string CGUIFrameStats::GetSummary() const
+{
+  const PhaseStats process = Get(PHASE_PROCESS);
+  const PhaseStats render = Get(PHASE_RENDER);
+  return StringUtils::Format("GUI: process {:.2f} ms (max {:.2f}) - render {:.2f} ms (max {:.2f})",
+                             process.average, process.max, render.average, render.max);
+}
+
+void CGUIFrameStats::Reset()
+{
+  for (unsigned int phase = 0; phase < PHASE_COUNT; phase++)
+  {
+    std::fill(std::begin(m_durations[phase]), std::end(m_durations[phase]), 0);
+    m_count[phase] = 0;
+  }
+}
+
+int64_t CGUIFrameStats::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
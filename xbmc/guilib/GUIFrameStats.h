@@ -0,0 +1,61 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+/*!
+ \ingroup winman
+ \brief Durations of the phases of the last GUI frames.
+
+ Filled by the window manager, which times processing (animations, visibility,
+ info labels, container layout) and rendering of all windows and dialogs
+ separately. Only to be used from the rendering thread.
+ */
+class CGUIFrameStats
+{
+public:
+  enum Phase
+  {
+    PHASE_PROCESS = 0,
+    PHASE_RENDER,
+    PHASE_COUNT
+  };
+
+  //! Durations in ms
+  struct PhaseStats
+  {
+    double last = 0.0;
+    double average = 0.0;
+    double max = 0.0;
+  };
+
+  //! Number of frames the average and maximum are taken over
+  static constexpr unsigned int FRAMES = 120;
+
+  /*! \brief Record the duration of a phase of the current frame in ns.
+   */
+  void Add(Phase phase, int64_t duration);
+
+  PhaseStats Get(Phase phase) const;
+
+  /*! \brief One line summary, e.g. for the debug info overlay.
+   */
+  std::string GetSummary() const;
+
+  void Reset();
+
+  //! Monotonic time in ns
+  static int64_t Now();
+
+private:
+  int64_t m_durations[PHASE_COUNT][FRAMES] = {};
+  unsigned int m_count[PHASE_COUNT] = {};
+};
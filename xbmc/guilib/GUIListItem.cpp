@@ -333,6 +333,11 @@ CGUIListItemLayout *CGUIListItem::GetLayout()
   return m_layout.get();
 }
 
+CGUIListItemLayoutPtr CGUIListItem::TakeLayout()
+{
+  return std::move(m_layout);
+}
+
 void CGUIListItem::SetFocusedLayout(CGUIListItemLayoutPtr layout)
 {
   m_focusedLayout = std::move(layout);
@@ -343,6 +348,11 @@ CGUIListItemLayout *CGUIListItem::GetFocusedLayout()
   return m_focusedLayout.get();
 }
 
+CGUIListItemLayoutPtr CGUIListItem::TakeFocusedLayout()
+{
+  return std::move(m_focusedLayout);
+}
+
 void CGUIListItem::SetInvalid()
 {
   if (m_layout) m_layout->SetInvalid();
@@ -127,9 +127,11 @@ public:
 
   void SetLayout(CGUIListItemLayoutPtr layout);
   CGUIListItemLayout *GetLayout();
+  CGUIListItemLayoutPtr TakeLayout();
 
   void SetFocusedLayout(CGUIListItemLayoutPtr layout);
   CGUIListItemLayout *GetFocusedLayout();
+  CGUIListItemLayoutPtr TakeFocusedLayout();
 
   void FreeIcons();
   void FreeMemory(bool immediately = false);
@@ -35,9 +35,18 @@ CGUIListItemLayout::CGUIListItemLayout(const CGUIListItemLayout &from, CGUIContr
   m_focused = from.m_focused;
   m_condition = from.m_condition;
   m_invalidated = true;
+  m_source = &from;
   m_group.SetParentControl(control);
 }
 
+void CGUIListItemLayout::Recycle()
+{
+  m_group.FreeResources();
+  m_group.ResetAnimations();
+  m_group.SetFocusedItem(0);
+  m_invalidated = true;
+}
+
 bool CGUIListItemLayout::IsAnimating(ANIMATION_TYPE animType)
 {
   return m_group.IsAnimating(animType);
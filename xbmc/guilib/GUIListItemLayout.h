@@ -33,6 +33,15 @@ public:
   void FreeResources(bool immediately = false);
   void SetParentControl(CGUIControl *control) { m_group.SetParentControl(control); };
 
+  /*! \brief Whether this layout is a copy of the given one, see CGUIListItemLayout(from, control) */
+  bool IsCopyOf(const CGUIListItemLayout &layout) const { return m_source == &layout; };
+
+  /*! \brief Prepare the layout for showing another item.
+   Frees the resources and resets animations and focus, the controls are kept and
+   updated from the next item on the next call to Process().
+   */
+  void Recycle();
+
 //#ifdef GUILIB_PYTHON_COMPATIBILITY
   void CreateListControlLayouts(float width, float height, bool focused, const CLabelInfo &labelInfo, const CLabelInfo &labelInfo2, const CTextureInfo &texture, const CTextureInfo &textureFocus, float texHeight, float iconWidth, float iconHeight, const std::string &nofocusCondition, const std::string &focusCondition);
 //#endif
@@ -57,6 +66,7 @@ protected:
   float m_height;
   bool m_focused;
   bool m_invalidated;
+  const CGUIListItemLayout *m_source = nullptr;
 
   INFO::InfoPtr m_condition;
   KODI::GUILIB::GUIINFO::CGUIInfoBool m_isPlaying;
@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "settings/lib/SettingHandle.h"
 #include "threads/SingleLock.h"
 #include "utils/Color.h"
 #include "utils/RssManager.h"
@@ -35,6 +36,9 @@ CGUIRSSControl::CGUIRSSControl(int parentID, int controlID, float posX, float po
   m_stopped = false;
   m_urlset = 1;
   ControlType = GUICONTROL_RSS;
+  m_enabled.reset(new CSettingHandle<CSettingBool>(
+      *CServiceBroker::GetSettingsComponent()->GetSettings()->GetSettingsManager(),
+      CSettings::SETTING_LOOKANDFEEL_ENABLERSSFEEDS));
 }
 
 CGUIRSSControl::CGUIRSSControl(const CGUIRSSControl &from)
@@ -54,6 +58,9 @@ CGUIRSSControl::CGUIRSSControl(const CGUIRSSControl &from)
   m_stopped = from.m_stopped;
   m_urlset = 1;
   ControlType = GUICONTROL_RSS;
+  m_enabled.reset(new CSettingHandle<CSettingBool>(
+      *CServiceBroker::GetSettingsComponent()->GetSettings()->GetSettingsManager(),
+      CSettings::SETTING_LOOKANDFEEL_ENABLERSSFEEDS));
 }
 
 CGUIRSSControl::~CGUIRSSControl(void)
@@ -91,7 +98,7 @@ bool CGUIRSSControl::UpdateColors()
 void CGUIRSSControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   bool dirty = false;
-  if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_LOOKANDFEEL_ENABLERSSFEEDS) && CRssManager::GetInstance().IsActive())
+  if (m_enabled->Get() && CRssManager::GetInstance().IsActive())
   {
     CSingleLock lock(m_criticalSection);
     // Create RSS background/worker thread if needed
@@ -152,7 +159,7 @@ void CGUIRSSControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyre
 void CGUIRSSControl::Render()
 {
   // only render the control if they are enabled
-  if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_LOOKANDFEEL_ENABLERSSFEEDS) && CRssManager::GetInstance().IsActive())
+  if (m_enabled->Get() && CRssManager::GetInstance().IsActive())
   {
 
     if (m_label.font)
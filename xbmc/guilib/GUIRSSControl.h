@@ -17,9 +17,13 @@
 #include "GUILabel.h"
 #include "utils/IRssObserver.h"
 
+#include <memory>
 #include <vector>
 
 class CRssReader;
+class CSettingBool;
+template<class TSetting>
+class CSettingHandle;
 
 /*!
 \ingroup controls
@@ -68,5 +72,8 @@ protected:
   bool m_dirty;
   bool m_stopped;
   int  m_urlset;
+
+  // read for every frame
+  std::unique_ptr<CSettingHandle<CSettingBool>> m_enabled;
 };
 
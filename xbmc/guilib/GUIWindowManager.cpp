@@ -24,6 +24,7 @@
 #include "input/Key.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 
 #include "windows/GUIWindowHome.h"
 #include "events/windows/GUIWindowEventLog.h"
@@ -1091,7 +1092,9 @@ bool RenderOrderSortFunction(CGUIWindow *first, CGUIWindow *second)
 void CGUIWindowManager::Process(unsigned int currentTime)
 {
   assert(g_application.IsCurrentThread());
+  TRACE_SCOPE("gui", "CGUIWindowManager::Process");
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  const int64_t start = CGUIFrameStats::Now();
 
   m_dirtyregions.clear();
 
@@ -1109,6 +1112,8 @@ void CGUIWindowManager::Process(unsigned int currentTime)
 
   for (auto& itr : m_dirtyregions)
     m_tracker.MarkDirtyRegion(itr);
+
+  m_frameStats.Add(CGUIFrameStats::PHASE_PROCESS, CGUIFrameStats::Now() - start);
 }
 
 void CGUIWindowManager::MarkDirty()
@@ -1172,9 +1177,12 @@ void CGUIWindowManager::RenderEx() const
 bool CGUIWindowManager::Render()
 {
   assert(g_application.IsCurrentThread());
+  TRACE_SCOPE("gui", "CGUIWindowManager::Render");
   CSingleExit lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  const int64_t start = CGUIFrameStats::Now();
 
   CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
+  TRACE_COUNTER("gui", "dirty regions", static_cast<int64_t>(dirtyRegions.size()));
 
   bool hasRendered = false;
   // If we visualize the regions we will always render the entire viewport
@@ -1215,6 +1223,10 @@ bool CGUIWindowManager::Render()
       CGUITexture::DrawQuad(i, 0x4c00ff00);
   }
 
+  // frames with nothing to render would only dilute the statistics
+  if (hasRendered)
+    m_frameStats.Add(CGUIFrameStats::PHASE_RENDER, CGUIFrameStats::Now() - start);
+
   return hasRendered;
 }
 
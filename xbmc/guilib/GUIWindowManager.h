@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DirtyRegionTracker.h"
+#include "GUIFrameStats.h"
 #include "GUIWindow.h"
 #include "IMsgTargetCallback.h"
 #include "IWindowManagerCallback.h"
@@ -109,6 +110,11 @@ public:
    */
   void FrameMove();
 
+  /*! \brief Durations of the process and render phases of the last frames.
+   Should only be used from the application thread.
+   */
+  const CGUIFrameStats& GetFrameStats() const { return m_frameStats; }
+
   /*! \brief Return whether the window manager is initialized.
    The window manager is initialized on skin load - if the skin isn't yet loaded,
    no windows should be able to be initialized.
@@ -267,4 +273,5 @@ private:
 
   CDirtyRegionList m_dirtyregions;
   CDirtyRegionTracker m_tracker;
+  CGUIFrameStats m_frameStats;
 };
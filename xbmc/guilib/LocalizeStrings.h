@@ -59,8 +59,8 @@ protected:
   typedef std::map<uint32_t, LocStr>::const_iterator ciStrings;
   typedef std::map<uint32_t, LocStr>::iterator       iStrings;
 
-  mutable CSharedSection m_stringsMutex;
-  CSharedSection m_addonStringsMutex;
+  mutable CSharedSection m_stringsMutex{"CLocalizeStrings"};
+  CSharedSection m_addonStringsMutex{"CLocalizeStrings.addons"};
 };
 
 /*!
@@ -17,17 +17,39 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#ifdef HAS_LOCK_PROFILING
+#include "threads/LockProfiler.h"
+#endif
 #include "utils/FileOperationJob.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <stdlib.h>
 
 using namespace KODI::MESSAGING;
 
+/*! \brief Log the most contended locks.
+ *  \param params The parameters.
+ *  \details params[0] = Number of locks and call sites to list (optional).
+ */
+static int DumpLockProfile(const std::vector<std::string>& params)
+{
+#ifdef HAS_LOCK_PROFILING
+  const int count = params.empty() ? 20 : atoi(params[0].c_str());
+  CLog::Log(LOGINFO, "Lock profile:\n{}",
+            XbmcThreads::CLockProfiler::GetInstance().GetReport(std::max(count, 1)));
+#else
+  CLog::Log(LOGERROR, "DumpLockProfile - lock profiling is not compiled in");
+#endif
+
+  return 0;
+}
+
 /*! \brief Extract an archive.
  *  \param params The parameters
  *  \details params[0] = The archive URL.
@@ -108,6 +130,55 @@ static int SetVolume(const std::vector<std::string>& params)
   return 0;
 }
 
+/*! \brief Reset the lock statistics and start recording them.
+ *  \param params (ignored)
+ */
+static int StartLockProfiling(const std::vector<std::string>& params)
+{
+#ifdef HAS_LOCK_PROFILING
+  XbmcThreads::CLockProfiler::GetInstance().Start();
+#else
+  CLog::Log(LOGERROR, "StartLockProfiling - lock profiling is not compiled in");
+#endif
+
+  return 0;
+}
+
+/*! \brief Stop recording lock statistics.
+ *  \param params (ignored)
+ */
+static int StopLockProfiling(const std::vector<std::string>& params)
+{
+#ifdef HAS_LOCK_PROFILING
+  XbmcThreads::CLockProfiler::GetInstance().Stop();
+#endif
+
+  return 0;
+}
+
+/*! \brief Start recording trace events.
+ *  \param params (ignored)
+ */
+static int StartTrace(const std::vector<std::string>& params)
+{
+  CTraceRecorder::GetInstance().Start();
+
+  return 0;
+}
+
+/*! \brief Stop recording trace events and write them to a file.
+ *  \param params The parameters.
+ *  \details params[0] = The file to write (optional).
+ *                       If not given, writes to special://temp/trace.json.
+ */
+static int StopTrace(const std::vector<std::string>& params)
+{
+  const std::string path = params.empty() ? "special://temp/trace.json" : params[0];
+  CTraceRecorder::GetInstance().Stop(path);
+
+  return 0;
+}
+
 /*! \brief Toggle debug info.
  *  \param params (ignored)
  */
@@ -153,6 +224,14 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 ///     Function,
 ///     Description }
 ///   \table_row2_l{
+///     <b>`DumpLockProfile([count])`</b>
+///     ,
+///     Logs the locks and call sites with the longest total wait time\, together
+///     with their wait and hold times. Only available in builds with lock profiling
+///     (ENABLE_LOCK_PROFILING).
+///     @param[in] count                 Number of locks and call sites to list (optional\, default 20).
+///   }
+///   \table_row2_l{
 ///     <b>`Extract(url [\, dest])`</b>
 ///     ,
 ///     Extracts a specified archive to an optionally specified 'absolute' path.
@@ -182,6 +261,31 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 ///     @param[in] showvolumebar         Add "showVolumeBar" to show volume bar (optional).
 ///   }
 ///   \table_row2_l{
+///     <b>`StartLockProfiling`</b>
+///     ,
+///     Resets the lock statistics and starts recording them. Only available in builds
+///     with lock profiling (ENABLE_LOCK_PROFILING).
+///   }
+///   \table_row2_l{
+///     <b>`StopLockProfiling`</b>
+///     ,
+///     Stops recording lock statistics\, they can still be logged with DumpLockProfile.
+///   }
+///   \table_row2_l{
+///     <b>`StartTrace`</b>
+///     ,
+///     Starts recording trace events of Kodi's hot paths (GUI\, jobs\, database\,
+///     file cache and playback).
+///   }
+///   \table_row2_l{
+///     <b>`StopTrace([file])`</b>
+///     ,
+///     Stops recording trace events and writes them in Chrome's trace event format\,
+///     to be loaded in chrome://tracing or ui.perfetto.dev.
+///     @param[in] file                  The file to write (optional).
+///             @note If not given\, writes to special://temp/trace.json.
+///   }
+///   \table_row2_l{
 ///     <b>`ToggleDebug`</b>
 ///     ,
 ///     Toggles debug mode on/off
@@ -204,10 +308,15 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 CBuiltins::CommandMap CApplicationBuiltins::GetOperations() const
 {
   return {
+           {"dumplockprofile", {"Log the most contended locks", 0, DumpLockProfile}},
            {"extract", {"Extracts the specified archive", 1, Extract}},
            {"mute", {"Mute the player", 0, Mute}},
            {"notifyall", {"Notify all connected clients", 2, NotifyAll}},
            {"setvolume", {"Set the current volume", 1, SetVolume}},
+           {"startlockprofiling", {"Start recording lock statistics", 0, StartLockProfiling}},
+           {"stoplockprofiling", {"Stop recording lock statistics", 0, StopLockProfiling}},
+           {"starttrace", {"Start recording trace events", 0, StartTrace}},
+           {"stoptrace", {"Stop recording trace events and write them to a file", 0, StopTrace}},
            {"toggledebug", {"Enables/disables debug mode", 0, ToggleDebug}},
            {"toggledpms", {"Toggle DPMS mode manually", 0, ToggleDPMS}},
            {"wakeonlan", {"Sends the wake-up packet to the broadcast address for the specified MAC address", 1, WakeOnLAN}}
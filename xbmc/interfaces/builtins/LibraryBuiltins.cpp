@@ -18,6 +18,7 @@
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
 #include "messaging/helpers/DialogHelper.h"
+#include "music/MusicDatabase.h"
 #include "music/MusicLibraryQueue.h"
 #include "settings/LibExportSettings.h"
 #include "settings/Settings.h"
@@ -286,6 +287,35 @@ static int UpdateLibrary(const std::vector<std::string>& params)
   return 0;
 }
 
+/*! \brief Rebuild the stored results of smart playlists.
+ *  \param params The parameters.
+ *  \details params[0] = "video" or "music" (optional, both if omitted).
+ */
+static int RefreshSmartPlaylists(const std::vector<std::string>& params)
+{
+  // the results are rebuilt from the library when the playlists are opened next
+  if (params.empty() || StringUtils::EqualsNoCase(params[0], "video"))
+  {
+    CVideoDatabase videodatabase;
+    if (videodatabase.Open())
+    {
+      videodatabase.ClearSmartPlaylistCache();
+      videodatabase.Close();
+    }
+  }
+  if (params.empty() || StringUtils::EqualsNoCase(params[0], "music"))
+  {
+    CMusicDatabase musicdatabase;
+    if (musicdatabase.Open())
+    {
+      musicdatabase.ClearSmartPlaylistCache();
+      musicdatabase.Close();
+    }
+  }
+
+  return 0;
+}
+
 /*! \brief Open a video library search.
  *  \param params (ignored)
  */
@@ -343,6 +373,12 @@ static int SearchVideoLibrary(const std::vector<std::string>& params)
 ///     @param[in] actorthumbs           Add "actorthumbs" to include other actor thumbs.
 ///   }
 ///   \table_row2_l{
+///     <b>`refreshsmartplaylists([type])`</b>
+///     ,
+///     Rebuild the stored results of smart playlists from the library
+///     @param[in] type                  "video" or "music"\, both if omitted.
+///   }
+///   \table_row2_l{
 ///     <b>`updatelibrary([type\, suppressDialogs])`</b>
 ///     ,
 ///     Update the selected library (music or video)
@@ -363,6 +399,7 @@ CBuiltins::CommandMap CLibraryBuiltins::GetOperations() const
           {"cleanlibrary",        {"Clean the video/music library", 1, CleanLibrary}},
           {"exportlibrary",       {"Export the video/music library", 1, ExportLibrary}},
           {"exportlibrary2",      {"Export the video/music library", 1, ExportLibrary2}},
+          {"refreshsmartplaylists", {"Rebuild the stored results of smart playlists", 0, RefreshSmartPlaylists}},
           {"updatelibrary",       {"Update the selected library (music or video)", 1, UpdateLibrary}},
           {"videolibrary.search", {"Brings up a search dialog which will search the library", 0, SearchVideoLibrary}}
          };
@@ -13,6 +13,7 @@
 #include "interfaces/generic/ILanguageInvoker.h"
 #include "interfaces/generic/LanguageInvokerThread.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/XTimeUtils.h"
@@ -24,6 +25,16 @@
 
 using namespace XFILE;
 
+namespace
+{
+// every idle invoker keeps an interpreter with all modules imported by its script loaded,
+// these limit the memory held by them
+constexpr unsigned int POOL_MAX_IDLE = 4;
+constexpr unsigned int POOL_MAX_IDLE_PER_SCRIPT = 2;
+constexpr unsigned int POOL_IDLE_TIMEOUT_MS = 5 * 60 * 1000;
+constexpr unsigned int POOL_RESERVATION_TIMEOUT_MS = 30 * 1000;
+}
+
 CScriptInvocationManager::~CScriptInvocationManager()
 {
   Uninitialize();
@@ -38,6 +49,8 @@ CScriptInvocationManager& CScriptInvocationManager::GetInstance()
 void CScriptInvocationManager::Process()
 {
   CSingleLock lock(m_critSection);
+  TrimInvokerPool();
+
   // go through all active threads and find and remove all which are done
   std::vector<LanguageInvokerThread> tempList;
   for (LanguageInvokerThreadMap::iterator it = m_scripts.begin(); it != m_scripts.end(); )
@@ -74,8 +87,8 @@ void CScriptInvocationManager::Uninitialize()
   // execute Process() once more to handle the remaining scripts
   Process();
 
-  // it is safe to relese early, thread must be in m_scripts too
-  m_lastInvokerThread = nullptr;
+  // it is safe to relese early, threads must be in m_scripts too
+  m_invokerPool.clear();
 
   // make sure all scripts are done
   std::vector<LanguageInvokerThread> tempList;
@@ -177,36 +190,120 @@ bool CScriptInvocationManager::HasLanguageInvoker(const std::string &script) con
   return it != m_invocationHandlers.end() && it->second != NULL;
 }
 
+void CScriptInvocationManager::ReleasePluginHandle(int pluginHandle)
+{
+  if (pluginHandle < 0)
+    return;
+
+  CSingleLock lock(m_critSection);
+  for (auto& pooled : m_invokerPool)
+  {
+    if (pooled.pluginHandle == pluginHandle)
+      pooled.reserved = false;
+  }
+}
+
 int CScriptInvocationManager::GetReusablePluginHandle(const std::string& script)
 {
   CSingleLock lock(m_critSection);
 
-  if (m_lastInvokerThread)
+  // most recently used first, it's the most likely to still have its data cached
+  for (auto it = m_invokerPool.rbegin(); it != m_invokerPool.rend(); ++it)
   {
-    if (m_lastInvokerThread->Reuseable(script))
-      return m_lastPluginHandle;
-    m_lastInvokerThread->Release();
-    m_lastInvokerThread = nullptr;
+    if (!it->reserved && it->thread->Reuseable(script))
+    {
+      it->reserved = true;
+      it->lastUsed = XbmcThreads::SystemClockMillis();
+      m_poolStats.hits++;
+      return it->pluginHandle;
+    }
   }
   return -1;
 }
 
-LanguageInvokerPtr CScriptInvocationManager::GetLanguageInvoker(const std::string& script)
+CScriptInvocationManager::InvokerPoolStats CScriptInvocationManager::GetInvokerPoolStats() const
 {
   CSingleLock lock(m_critSection);
+  return m_poolStats;
+}
 
-  if (m_lastInvokerThread)
+void CScriptInvocationManager::AddPluginInvocationTime(bool reused, unsigned int timeMs)
+{
+  CSingleLock lock(m_critSection);
+  if (reused)
+    m_poolStats.hitTimeMs += timeMs;
+  else
+    m_poolStats.missTimeMs += timeMs;
+}
+
+void CScriptInvocationManager::TrimInvokerPool()
+{
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+  std::map<std::string, unsigned int> idlePerScript;
+  unsigned int idle = 0;
+
+  // forget invokers which have finished for good, release the ones idle for too long
+  for (auto it = m_invokerPool.begin(); it != m_invokerPool.end(); )
   {
-    if (m_lastInvokerThread->Reuseable(script))
+    // a reservation which was never followed by ExecuteAsync()
+    if (it->reserved && now - it->lastUsed >= POOL_RESERVATION_TIMEOUT_MS)
     {
-      CLog::Log(LOGDEBUG, "%s - Reusing LanguageInvokerThread %d for script %s", __FUNCTION__,
-                m_lastInvokerThread->GetId(), script.c_str());
-      m_lastInvokerThread->GetInvoker()->Reset();
-      return m_lastInvokerThread->GetInvoker();
+      CLog::Log(LOGWARNING, "%s - Releasing stale reservation of LanguageInvokerThread %d for script %s",
+                __FUNCTION__, it->thread->GetId(), it->script.c_str());
+      it->reserved = false;
+    }
+
+    const LanguageInvokerThread invokerThread = getInvokerThread(it->thread->GetId());
+    const bool isIdle = !it->reserved && it->thread->Reuseable(it->script);
+    if (invokerThread.thread == nullptr || invokerThread.done)
+      it = m_invokerPool.erase(it);
+    else if (isIdle && now - it->lastUsed >= POOL_IDLE_TIMEOUT_MS)
+    {
+      CLog::Log(LOGDEBUG, "%s - Releasing LanguageInvokerThread %d for script %s, idle for %u ms",
+                __FUNCTION__, it->thread->GetId(), it->script.c_str(), now - it->lastUsed);
+      it->thread->Release();
+      m_poolStats.expired++;
+      it = m_invokerPool.erase(it);
+    }
+    else
+    {
+      if (isIdle)
+      {
+        idle++;
+        idlePerScript[it->script]++;
+      }
+      ++it;
+    }
+  }
+
+  // release the least recently used idle invokers beyond the limits
+  for (auto it = m_invokerPool.begin(); it != m_invokerPool.end() && idle > 0; )
+  {
+    if (it->reserved || !it->thread->Reuseable(it->script))
+    {
+      ++it;
+      continue;
     }
-    m_lastInvokerThread->Release();
-    m_lastInvokerThread = nullptr;
+
+    unsigned int& scriptIdle = idlePerScript[it->script];
+    if (idle > POOL_MAX_IDLE || scriptIdle > POOL_MAX_IDLE_PER_SCRIPT)
+    {
+      CLog::Log(LOGDEBUG, "%s - Releasing LanguageInvokerThread %d for script %s, pool is full",
+                __FUNCTION__, it->thread->GetId(), it->script.c_str());
+      it->thread->Release();
+      m_poolStats.evicted++;
+      idle--;
+      scriptIdle--;
+      it = m_invokerPool.erase(it);
+    }
+    else
+      ++it;
   }
+}
+
+LanguageInvokerPtr CScriptInvocationManager::GetLanguageInvoker(const std::string& script)
+{
+  CSingleLock lock(m_critSection);
 
   std::string extension = URIUtils::GetExtension(script);
   StringUtils::ToLower(extension);
@@ -226,14 +323,48 @@ int CScriptInvocationManager::ExecuteAsync(
     int pluginHandle /* = -1 */)
 {
   if (script.empty())
+  {
+    ReleasePluginHandle(pluginHandle);
     return -1;
+  }
 
   if (!CFile::Exists(script, false))
   {
     CLog::Log(LOGERROR, "%s - Not executing non-existing script %s", __FUNCTION__, script.c_str());
+    ReleasePluginHandle(pluginHandle);
     return -1;
   }
 
+  if (reuseable && pluginHandle >= 0)
+  {
+    CSingleLock lock(m_critSection);
+    for (auto it = m_invokerPool.begin(); it != m_invokerPool.end(); ++it)
+    {
+      if (!it->reserved || it->pluginHandle != pluginHandle || it->script != script)
+        continue;
+
+      CLog::Log(LOGDEBUG, "%s - Reusing LanguageInvokerThread %d for script %s", __FUNCTION__,
+                it->thread->GetId(), script.c_str());
+      it->lastUsed = XbmcThreads::SystemClockMillis();
+      m_invokerPool.splice(m_invokerPool.end(), m_invokerPool, it);
+
+      // After we leave the lock, the pool entry can be released -> copy!
+      // The entry stays reserved until the script has been handed to the thread.
+      CLanguageInvokerThreadPtr invokerThread = m_invokerPool.back().thread;
+      invokerThread->GetInvoker()->Reset();
+      if (addon != NULL)
+        invokerThread->SetAddon(addon);
+      lock.Leave();
+      invokerThread->Execute(script, arguments);
+      ReleasePluginHandle(pluginHandle);
+
+      return invokerThread->GetId();
+    }
+  }
+
+  // the reserved invoker is gone, run the script on a new one
+  ReleasePluginHandle(pluginHandle);
+
   LanguageInvokerPtr invoker = GetLanguageInvoker(script);
   return ExecuteAsync(script, invoker, addon, arguments, reuseable, pluginHandle);
 }
@@ -257,35 +388,27 @@ int CScriptInvocationManager::ExecuteAsync(
 
   CSingleLock lock(m_critSection);
 
-  if (m_lastInvokerThread && m_lastInvokerThread->GetInvoker() == languageInvoker)
-  {
-    if (addon != NULL)
-      m_lastInvokerThread->SetAddon(addon);
-
-    // After we leave the lock, m_lastInvokerThread can be released -> copy!
-    CLanguageInvokerThreadPtr invokerThread = m_lastInvokerThread;
-    lock.Leave();
-    invokerThread->Execute(script, arguments);
-
-    return invokerThread->GetId();
-  }
-
-  m_lastInvokerThread =
+  CLanguageInvokerThreadPtr invokerThread =
       CLanguageInvokerThreadPtr(new CLanguageInvokerThread(languageInvoker, this, reuseable));
-  if (m_lastInvokerThread == NULL)
+  if (invokerThread == NULL)
     return -1;
 
   if (addon != NULL)
-    m_lastInvokerThread->SetAddon(addon);
+    invokerThread->SetAddon(addon);
 
-  m_lastInvokerThread->SetId(m_nextId++);
-  m_lastPluginHandle = pluginHandle;
+  invokerThread->SetId(m_nextId++);
+
+  LanguageInvokerThread thread = {invokerThread, script, false};
+  m_scripts.insert(std::make_pair(invokerThread->GetId(), thread));
+  m_scriptPaths.insert(std::make_pair(script, invokerThread->GetId()));
+
+  if (reuseable)
+  {
+    PooledInvoker pooled = {invokerThread, script, pluginHandle, false, XbmcThreads::SystemClockMillis()};
+    m_invokerPool.push_back(pooled);
+    m_poolStats.misses++;
+  }
 
-  LanguageInvokerThread thread = {m_lastInvokerThread, script, false};
-  m_scripts.insert(std::make_pair(m_lastInvokerThread->GetId(), thread));
-  m_scriptPaths.insert(std::make_pair(script, m_lastInvokerThread->GetId()));
-  // After we leave the lock, m_lastInvokerThread can be released -> copy!
-  CLanguageInvokerThreadPtr invokerThread = m_lastInvokerThread;
   lock.Leave();
   invokerThread->Execute(script, arguments);
 
@@ -12,6 +12,7 @@
 #include "interfaces/generic/ILanguageInvoker.h"
 #include "threads/CriticalSection.h"
 
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -35,10 +36,33 @@ public:
   LanguageInvokerPtr GetLanguageInvoker(const std::string& script);
 
   /*!
-  * \brief Returns addon_handle if last reusable invoker is ready to use.
+  * \brief Statistics of the pool of reusable invokers.
+  */
+  struct InvokerPoolStats
+  {
+    unsigned int hits = 0; ///< executions on an idle invoker taken from the pool
+    unsigned int misses = 0; ///< reusable executions which had to start a new invoker
+    unsigned int expired = 0; ///< idle invokers released after the idle timeout
+    unsigned int evicted = 0; ///< idle invokers released to stay within the pool limits
+    uint64_t hitTimeMs = 0; ///< total duration of plugin invocations on a pooled invoker
+    uint64_t missTimeMs = 0; ///< total duration of plugin invocations on a new invoker
+  };
+
+  /*!
+  * \brief Returns addon_handle of an idle reusable invoker of the given script
+  * and reserves it for the next ExecuteAsync() with that handle, -1 if there is none.
+  * The reservation ends once ExecuteAsync() has handed over the script or failed.
   */
   int GetReusablePluginHandle(const std::string& script);
 
+  InvokerPoolStats GetInvokerPoolStats() const;
+
+  /*!
+  * \brief Accounts the duration of a plugin invocation to the pool statistics.
+  * \param reused Whether the invocation ran on a pooled invoker
+  */
+  void AddPluginInvocationTime(bool reused, unsigned int timeMs);
+
   /*!
    * \brief Executes the given script asynchronously in a separate thread.
    *
@@ -137,12 +161,23 @@ private:
   typedef std::map<int, LanguageInvokerThread> LanguageInvokerThreadMap;
   typedef std::map<std::string, ILanguageInvocationHandler*> LanguageInvocationHandlerMap;
 
+  // reusable invoker, its interpreter stays loaded between executions
+  typedef struct {
+    CLanguageInvokerThreadPtr thread;
+    std::string script;
+    int pluginHandle;
+    bool reserved; // handed out by GetReusablePluginHandle()
+    unsigned int lastUsed;
+  } PooledInvoker;
+
   LanguageInvokerThread getInvokerThread(int scriptId) const;
+  void ReleasePluginHandle(int pluginHandle);
+  void TrimInvokerPool();
 
   LanguageInvocationHandlerMap m_invocationHandlers;
   LanguageInvokerThreadMap m_scripts;
-  CLanguageInvokerThreadPtr m_lastInvokerThread;
-  int m_lastPluginHandle = -1;
+  std::list<PooledInvoker> m_invokerPool; // least recently used first
+  InvokerPoolStats m_poolStats;
 
   std::map<std::string, int> m_scriptPaths;
   int m_nextId = 0;
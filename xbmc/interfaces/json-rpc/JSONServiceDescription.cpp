@@ -236,7 +236,9 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 
 // XBMC operations
   { "XBMC.GetInfoLabels",                           CXBMCOperations::GetInfoLabels },
-  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans }
+  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans },
+  { "XBMC.StartTrace",                              CXBMCOperations::StartTrace },
+  { "XBMC.StopTrace",                               CXBMCOperations::StopTrace }
 };
 
 JSONSchemaTypeDefinition::JSONSchemaTypeDefinition()
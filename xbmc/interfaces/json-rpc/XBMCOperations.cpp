@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "messaging/ApplicationMessenger.h"
 #include "powermanagement/PowerManager.h"
+#include "utils/TraceRecorder.h"
 #include "utils/Variant.h"
 
 using namespace JSONRPC;
@@ -85,3 +86,15 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::StartTrace(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  CTraceRecorder::GetInstance().Start();
+  return ACK;
+}
+
+JSONRPC_STATUS CXBMCOperations::StopTrace(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  // clients don't get to choose the file, that would let them write anywhere
+  return CTraceRecorder::GetInstance().Stop("special://temp/trace.json") ? ACK : FailedToExecute;
+}
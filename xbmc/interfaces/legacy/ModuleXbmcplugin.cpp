@@ -9,6 +9,7 @@
 #include "ModuleXbmcplugin.h"
 
 #include "FileItem.h"
+#include "LanguageHook.h"
 #include "filesystem/PluginDirectory.h"
 
 namespace XBMCAddon
@@ -113,5 +114,17 @@ namespace XBMCAddon
       XFILE::CPluginDirectory::SetProperty(handle, key, value);
     }
 
+    void setCacheLifetime(int handle, int seconds)
+    {
+      XFILE::CPluginDirectory::SetCacheLifetime(handle, seconds);
+    }
+
+    void invalidateCache(const String& url)
+    {
+      LanguageHook* languageHook = LanguageHook::GetLanguageHook();
+      const String addonId = languageHook ? languageHook->GetAddonId() : emptyString;
+      XFILE::CPluginDirectory::InvalidateCache(url, addonId);
+    }
+
   }
 }
@@ -431,11 +431,70 @@ namespace XBMCAddon
     /// ~~~~~~~~~~~~~
     ///
     setProperty(...);
-    ///@}
 #else
     void setProperty(int handle, const char* key, const String& value);
 #endif
 
+#ifdef DOXYGEN_SHOULD_USE_THIS
+    ///
+    /// \ingroup python_xbmcplugin
+    /// @brief \python_func{ xbmcplugin.setCacheLifetime(handle, seconds) }
+    ///-------------------------------------------------------------------------
+    /// Keeps the listing of this call cached for the given number of seconds.
+    /// Until then, browsing the same url again shows the cached listing without
+    /// running the plugin. Afterwards widgets may still show it while a fresh
+    /// listing is fetched.
+    ///
+    /// @param handle      integer - handle the plugin was started with.
+    /// @param seconds     integer - seconds the listing stays fresh, 0 to not cache it.
+    ///
+    /// @note The listing is also kept on disk unless endOfDirectory() was
+    /// called with cacheToDisc=False.
+    ///
+    ///
+    /// ------------------------------------------------------------------------
+    /// @python_v19 New function added.
+    ///
+    /// **Example:**
+    /// ~~~~~~~~~~~~~{.py}
+    /// ..
+    /// xbmcplugin.setCacheLifetime(int(sys.argv[1]), 3600)
+    /// ..
+    /// ~~~~~~~~~~~~~
+    ///
+    setCacheLifetime(...);
+#else
+    void setCacheLifetime(int handle, int seconds);
+#endif
+
+#ifdef DOXYGEN_SHOULD_USE_THIS
+    ///
+    /// \ingroup python_xbmcplugin
+    /// @brief \python_func{ xbmcplugin.invalidateCache(url) }
+    ///-------------------------------------------------------------------------
+    /// Drops a listing cached with setCacheLifetime().
+    ///
+    /// @param url         string - plugin url of the listing. The root url of
+    ///                    a plugin drops all its listings. Only listings of
+    ///                    the calling plugin can be dropped.
+    ///
+    ///
+    /// ------------------------------------------------------------------------
+    /// @python_v19 New function added.
+    ///
+    /// **Example:**
+    /// ~~~~~~~~~~~~~{.py}
+    /// ..
+    /// xbmcplugin.invalidateCache('plugin://plugin.video.foo/')
+    /// ..
+    /// ~~~~~~~~~~~~~
+    ///
+    invalidateCache(...);
+    ///@}
+#else
+    void invalidateCache(const String& url);
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     SWIG_CONSTANT(int, SORT_METHOD_NONE);
     SWIG_CONSTANT(int, SORT_METHOD_LABEL);
@@ -47,11 +47,12 @@ using namespace PVR;
 class CDirectoryJob : public CJob
 {
 public:
-  CDirectoryJob(const std::string &url, SortDescription sort, int limit, int parentID)
+  CDirectoryJob(const std::string &url, SortDescription sort, int limit, int parentID, bool allowStale)
     : m_url(url),
       m_sort(sort),
       m_limit(limit),
-      m_parentID(parentID)
+      m_parentID(parentID),
+      m_allowStale(allowStale)
   { }
   ~CDirectoryJob() override = default;
 
@@ -70,8 +71,10 @@ public:
   bool DoWork() override
   {
     CFileItemList items;
-    if (CDirectory::GetDirectory(m_url, items, "", DIR_FLAG_DEFAULTS))
+    if (CDirectory::GetDirectory(m_url, items, "", m_allowStale ? DIR_FLAG_ALLOW_STALE : DIR_FLAG_DEFAULTS))
     {
+      m_stale = items.GetProperty("plugin.stale").asBoolean();
+
       // sort the items if necessary
       if (m_sort.sortBy != SortByNone)
         items.Sort(m_sort);
@@ -134,6 +137,7 @@ public:
 
   const std::vector<CGUIStaticItemPtr> &GetItems() const { return m_items; }
   const std::string &GetTarget() const { return m_target; }
+  bool IsStale() const { return m_stale; }
   std::vector<InfoTagType> GetItemTypes(std::vector<InfoTagType> &itemTypes) const
   {
     itemTypes.clear();
@@ -147,6 +151,8 @@ private:
   SortDescription m_sort;
   unsigned int m_limit;
   int m_parentID;
+  bool m_allowStale;
+  bool m_stale = false;
   std::vector<CGUIStaticItemPtr> m_items;
   std::map<InfoTagType, std::shared_ptr<CThumbLoader> > m_thumbloaders;
 };
@@ -155,6 +161,7 @@ CDirectoryProvider::CDirectoryProvider(const TiXmlElement *element, int parentID
  : IListProvider(parentID),
    m_updateState(OK),
    m_isAnnounced(false),
+   m_isStale(false),
    m_jobID(0),
    m_currentLimit(0)
 {
@@ -206,12 +213,16 @@ bool CDirectoryProvider::Update(bool forceRefresh)
 
   m_updateState = OK;
 
-  if (fireJob)
+  // show a stale plugin listing right away and fetch a fresh one behind it
+  const bool refetch = m_isStale && !fireJob && !m_jobID;
+  m_isStale = false;
+
+  if (fireJob || refetch)
   {
     CLog::Log(LOGDEBUG, "CDirectoryProvider[%s]: refreshing..", m_currentUrl.c_str());
     if (m_jobID)
       CJobManager::GetInstance().CancelJob(m_jobID);
-    m_jobID = CJobManager::GetInstance().AddJob(new CDirectoryJob(m_currentUrl, m_currentSort, m_currentLimit, m_parentID), this);
+    m_jobID = CJobManager::GetInstance().AddJob(new CDirectoryJob(m_currentUrl, m_currentSort, m_currentLimit, m_parentID, !refetch), this);
   }
 
   if (!changed)
@@ -332,6 +343,7 @@ void CDirectoryProvider::Reset()
   if (m_jobID)
     CJobManager::GetInstance().CancelJob(m_jobID);
   m_jobID = 0;
+  m_isStale = false;
   m_items.clear();
   m_currentTarget.clear();
   m_currentUrl.clear();
@@ -360,6 +372,7 @@ void CDirectoryProvider::OnJobComplete(unsigned int jobID, bool success, CJob *j
     m_items = static_cast<CDirectoryJob*>(job)->GetItems();
     m_currentTarget = static_cast<CDirectoryJob*>(job)->GetTarget();
     static_cast<CDirectoryJob*>(job)->GetItemTypes(m_itemTypes);
+    m_isStale = static_cast<CDirectoryJob*>(job)->IsStale();
     if (m_updateState == OK)
       m_updateState = DONE;
   }
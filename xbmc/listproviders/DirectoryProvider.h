@@ -67,6 +67,7 @@ public:
 private:
   UpdateState      m_updateState;
   bool             m_isAnnounced;
+  bool             m_isStale;         ///< \brief items are a stale plugin listing, a fresh one is to be fetched
   unsigned int     m_jobID;
   KODI::GUILIB::GUIINFO::CGUIInfoLabel m_url;
   KODI::GUILIB::GUIINFO::CGUIInfoLabel m_target;
@@ -55,6 +55,7 @@
 #include "utils/LegacyPathTranslation.h"
 #include "utils/MathUtils.h"
 #include "utils/Random.h"
+#include "utils/RandomIdCache.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/XMLUtils.h"
@@ -288,6 +289,15 @@ void CMusicDatabase::CreateAnalytics()
               "  DELETE FROM source_path WHERE source_path.idSource = old.idSource;"
               "  DELETE FROM album_source WHERE album_source.idSource = old.idSource;"
               " END");
+
+  // SQLite only, searches fall back to LIKE without them
+  CLog::Log(LOGINFO, "create full text indexes");
+  CreateFullTextIndex("artistsearch", "artist", "idArtist", {"strArtist"});
+  CreateFullTextIndex("albumsearch", "album", "idAlbum", {"strAlbum"});
+  CreateFullTextIndex("songsearch", "song", "idSong", {"strTitle"});
+
+  // results of smart playlists, stored when they are first opened
+  CreateSmartPlaylistCache();
   
   // we create views last to ensure all indexes are rolled in
   CreateViews();
@@ -755,6 +765,8 @@ int CMusicDatabase::AddSong(const int idAlbum,
                              strComment.c_str(), strMood.c_str(), replayGain.Get().c_str());
       m_pDS->exec(strSQL);
       idSong = (int)m_pDS->lastinsertid();
+      // the candidates of random draws changed, even if not their number
+      CRandomIdCache::GetInstance().Clear();
     }
     else
     {
@@ -884,6 +896,7 @@ bool CMusicDatabase::UpdateSong(CSong& song, bool bArtists /*= true*/)
     // and use COMPOSERSORT tag data to provide sort names for artists that are composers
     AddSongContributors(song.idSong, song.GetContributors(), song.GetComposerSort());
   }
+  UpdateSmartPlaylistsForSong(song.idSong);
 
   return true;
 }
@@ -2658,7 +2671,12 @@ bool CMusicDatabase::SearchArtists(const std::string& search, CFileItemList &art
 
     std::string strVariousArtists = g_localizeStrings.Get(340).c_str();
     std::string strSQL;
-    if (search.size() >= MIN_FULL_SEARCH_LENGTH)
+    const std::string query = GetFullTextQuery(search);
+    if (!query.empty() && HasFullTextIndex("artistsearch"))
+      strSQL=PrepareSQL("SELECT artist.* FROM artistsearch JOIN artist ON artist.idArtist = artistsearch.rowid "
+                        "WHERE artistsearch MATCH '%s' AND strArtist <> '%s' ORDER BY artistsearch.rank",
+                        query.c_str(), strVariousArtists.c_str());
+    else if (search.size() >= MIN_FULL_SEARCH_LENGTH)
       strSQL=PrepareSQL("select * from artist "
                                 "where (strArtist like '%s%%' or strArtist like '%% %s%%') and strArtist <> '%s' "
                                 , search.c_str(), search.c_str(), strVariousArtists.c_str() );
@@ -3141,6 +3159,7 @@ void CMusicDatabase::IncrementPlayCount(const CFileItem& item)
 
     std::string sql=PrepareSQL("UPDATE song SET iTimesPlayed=iTimesPlayed+1, lastplayed=CURRENT_TIMESTAMP where idSong=%i", idSong);
     m_pDS->exec(sql);
+    UpdateSmartPlaylistsForSong(idSong);
   }
   catch (...)
   {
@@ -3231,7 +3250,11 @@ bool CMusicDatabase::SearchSongs(const std::string& search, CFileItemList &items
       return false;
 
     std::string strSQL;
-    if (search.size() >= MIN_FULL_SEARCH_LENGTH)
+    const std::string query = GetFullTextQuery(search);
+    if (!query.empty() && HasFullTextIndex("songsearch"))
+      strSQL=PrepareSQL("SELECT songview.* FROM songsearch JOIN songview ON songview.idSong = songsearch.rowid "
+                        "WHERE songsearch MATCH '%s' ORDER BY songsearch.rank LIMIT 1000", query.c_str());
+    else if (search.size() >= MIN_FULL_SEARCH_LENGTH)
       strSQL=PrepareSQL("select * from songview where strTitle like '%s%%' or strTitle like '%% %s%%' limit 1000", search.c_str(), search.c_str());
     else
       strSQL=PrepareSQL("select * from songview where strTitle like '%s%%' limit 1000", search.c_str());
@@ -3269,7 +3292,11 @@ bool CMusicDatabase::SearchAlbums(const std::string& search, CFileItemList &albu
       return false;
 
     std::string strSQL;
-    if (search.size() >= MIN_FULL_SEARCH_LENGTH)
+    const std::string query = GetFullTextQuery(search);
+    if (!query.empty() && HasFullTextIndex("albumsearch"))
+      strSQL=PrepareSQL("SELECT albumview.* FROM albumsearch JOIN albumview ON albumview.idAlbum = albumsearch.rowid "
+                        "WHERE albumsearch MATCH '%s' ORDER BY albumsearch.rank", query.c_str());
+    else if (search.size() >= MIN_FULL_SEARCH_LENGTH)
       strSQL=PrepareSQL("select * from albumview where strAlbum like '%s%%' or strAlbum like '%% %s%%'", search.c_str(), search.c_str());
     else
       strSQL=PrepareSQL("select * from albumview where strAlbum like '%s%%'", search.c_str());
@@ -3346,6 +3373,7 @@ bool CMusicDatabase::CleanupSongsByIds(const std::string &strSongIds)
       strSQL = "delete from song where idSong in " + strSongsToDelete;
       m_pDS->exec(strSQL);
       m_pDS->close();
+      CRandomIdCache::GetInstance().Clear();
     }
     return true;
   }
@@ -5095,12 +5123,29 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
     strValue = GetSingleValue("SELECT COUNT(1) FROM songview " + strSQLExtra, m_pDS);
     total = static_cast<int>(strtol(strValue.c_str(), NULL, 10));
 
+    // Pick a random selection of songs from a cached permutation of the matching song ids
+    // rather than sort all matching songs with ORDER BY RANDOM() and apply the limit
+    bool sampled = false;
+    if (extFilter.limit.empty() && sortDescription.sortBy == SortByRandom &&
+        sortDescription.limitStart == 0 && sortDescription.limitEnd > 0 &&
+        sortDescription.limitEnd < total)
+    {
+      int candidates;
+      const std::string condition = GetRandomIdCondition(
+          MediaTypeSong, "songview.idSong", "songview " + strSQLExtra, sortDescription.limitEnd, candidates);
+      if (!condition.empty())
+      {
+        extFilter.AppendWhere(condition);
+        sampled = true;
+      }
+    }
+
     if (extended)
       extFilter.AppendGroup("songview.idSong");
 
     // Apply any limiting directly in SQL and so sort as well
-    bool limitedInSQL =
-        extFilter.limit.empty() && (sortDescription.limitStart > 0 || sortDescription.limitEnd > 0);
+    bool limitedInSQL = !sampled && extFilter.limit.empty() &&
+                        (sortDescription.limitStart > 0 || sortDescription.limitEnd > 0);
     if (limitedInSQL)
     {
       extFilter.limit =
@@ -7956,7 +8001,31 @@ void CMusicDatabase::UpdateTables(int version)
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 75;
+  return 77;
+}
+
+bool CMusicDatabase::GetSmartPlaylistSource(const std::string &type, std::string &view, std::string &idColumn) const
+{
+  if (type == "songs")
+  {
+    view = "songview";
+    idColumn = "idSong";
+  }
+  else if (type == "albums")
+  {
+    view = "albumview";
+    idColumn = "idAlbum";
+  }
+  else
+    return false;
+
+  return true;
+}
+
+void CMusicDatabase::UpdateSmartPlaylistsForSong(int idSong)
+{
+  UpdateSmartPlaylistItems("songs", PrepareSQL("songview.idSong = %i", idSong));
+  UpdateSmartPlaylistItems("albums", PrepareSQL("albumview.idAlbum IN (SELECT idAlbum FROM song WHERE idSong = %i)", idSong));
 }
 
 int CMusicDatabase::GetMusicNeedsTagScan()
@@ -8014,6 +8083,8 @@ void CMusicDatabase::SetLibraryLastUpdated()
 {
   CDateTime dateUpdated = CDateTime::GetCurrentDateTime();
   m_pDS->exec(PrepareSQL("UPDATE versiontagscan SET lastscanned = '%s'", dateUpdated.GetAsDBDateTime().c_str()));
+  CRandomIdCache::GetInstance().Clear();
+  ClearSmartPlaylistCache();
 }
 
 
@@ -8029,7 +8100,6 @@ unsigned int CMusicDatabase::GetRandomSongIDs(const Filter &filter, std::vector<
     std::string strSQL = "SELECT idSong FROM songview ";
     if (!CDatabase::BuildSQL(strSQL, filter, strSQL))
       return false;
-    strSQL += PrepareSQL(" ORDER BY RANDOM()");
 
     if (!m_pDS->query(strSQL)) return 0;
     songIDs.clear();
@@ -9646,6 +9716,7 @@ bool CMusicDatabase::RemoveSongsFromPath(const std::string &path1, MAPSONGS& son
       // and delete all songs, and anything linked to them
       sql = "delete from song where idSong in (" + StringUtils::Join(songIds, ",") + ")";
       m_pDS->exec(sql);
+      CRandomIdCache::GetInstance().Clear();
     }
     // and remove the path as well (it'll be re-added later on with the new hash if it's non-empty)
     sql = "delete from path" + where;
@@ -9726,6 +9797,7 @@ bool CMusicDatabase::SetSongUserrating(int idSong, int userrating)
 
     std::string sql = PrepareSQL("UPDATE song SET userrating='%i' WHERE idSong = %i", userrating, idSong);
     m_pDS->exec(sql);
+    UpdateSmartPlaylistsForSong(idSong);
     return true;
   }
   catch (...)
@@ -9748,6 +9820,8 @@ bool CMusicDatabase::SetAlbumUserrating(const int idAlbum, int userrating)
 
     std::string sql = PrepareSQL("UPDATE album SET iUserrating='%i' WHERE idAlbum = %i", userrating, idAlbum);
     m_pDS->exec(sql);
+    UpdateSmartPlaylistItems("albums", PrepareSQL("albumview.idAlbum = %i", idAlbum));
+    UpdateSmartPlaylistItems("songs", PrepareSQL("songview.idAlbum = %i", idAlbum));
     return true;
   }
   catch (...)
@@ -9772,6 +9846,7 @@ bool CMusicDatabase::SetSongVotes(const std::string &filePath, int votes)
 
     std::string sql = PrepareSQL("UPDATE song SET votes='%i' WHERE idSong = %i", votes, songID);
     m_pDS->exec(sql);
+    UpdateSmartPlaylistsForSong(songID);
     return true;
   }
   catch (...)
@@ -11427,6 +11502,10 @@ bool CMusicDatabase::GetFilter(CDbUrl &musicUrl, Filter &filter, SortDescription
     if (xsp.GetType() == type ||
         (xsp.GetGroup().find(type) != std::string::npos && !xsp.IsGroupMixed()))
     {
+      // use the stored results unless the rules match other items as time goes by
+      playlists.clear();
+      if (xsp.GetType() == type && !xsp.IsTimeDependent(playlists))
+        xspWhere = GetSmartPlaylistCondition(type, xspWhere);
       filter.AppendWhere(xspWhere);
 
       if (xsp.GetLimit() > 0)
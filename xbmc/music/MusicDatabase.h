@@ -504,9 +504,10 @@ public:
   /////////////////////////////////////////////////
   // Party Mode
   /////////////////////////////////////////////////
-  /*! \brief Gets song IDs in random order that match the filter criteria
+  /*! \brief Gets the IDs of the songs that match the filter criteria to pick randomly from
   \param filter the criteria to apply in the query
-  \param songIDs a vector of <1, id> pairs suited to party mode use
+  \param songIDs a vector of <1, id> pairs suited to party mode use, in no particular order so
+  pick them with KODI::UTILS::RandomSample
   \return count of song ids found.
   */
   unsigned int GetRandomSongIDs(const Filter &filter, std::vector<std::pair<int, int> > &songIDs);
@@ -687,6 +688,7 @@ protected:
   int GetSchemaVersion() const override;
 
   const char *GetBaseDBName() const override { return "MyMusic"; };
+  bool GetSmartPlaylistSource(const std::string &type, std::string &view, std::string &idColumn) const override;
 
 private:
   /*! \brief (Re)Create the generic database views for songs and albums
@@ -695,6 +697,10 @@ private:
 
   void SplitPath(const std::string& strFileNameAndPath, std::string& strPath, std::string& strFileName);
 
+  /*! \brief Evaluate the stored smart playlists again for a changed song and its album
+   */
+  void UpdateSmartPlaylistsForSong(int idSong);
+
   CSong GetSongFromDataset();
   CSong GetSongFromDataset(const dbiplus::sql_record* const record, int offset = 0);
   CArtist GetArtistFromDataset(dbiplus::Dataset* pDS, int offset = 0, bool needThumb = true);
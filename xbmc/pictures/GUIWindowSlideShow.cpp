@@ -8,6 +8,8 @@
 
 #include "GUIWindowSlideShow.h"
 
+#include "SlideShowPrefetcher.h"
+
 #include "Application.h"
 #include "FileItem.h"
 #include "GUIDialogPictureInfo.h"
@@ -30,6 +32,7 @@
 #include "pictures/GUIViewStatePictures.h"
 #include "pictures/PictureThumbLoader.h"
 #include "rendering/RenderSystem.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/DisplaySettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -40,6 +43,7 @@
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <random>
 
 using namespace XFILE;
@@ -71,6 +75,7 @@ CBackgroundPicLoader::CBackgroundPicLoader()
   , m_maxHeight{0}
   , m_isLoading{false}
   , m_pCallback{nullptr}
+  , m_prefetcher{nullptr}
 {
 }
 
@@ -79,9 +84,10 @@ CBackgroundPicLoader::~CBackgroundPicLoader()
   StopThread();
 }
 
-void CBackgroundPicLoader::Create(CGUIWindowSlideShow *pCallback)
+void CBackgroundPicLoader::Create(CGUIWindowSlideShow *pCallback, CSlideShowPrefetcher *prefetcher)
 {
   m_pCallback = pCallback;
+  m_prefetcher = prefetcher;
   m_isLoading = false;
   CThread::Create(false);
 }
@@ -97,7 +103,11 @@ void CBackgroundPicLoader::Process()
       if (m_pCallback)
       {
         unsigned int start = XbmcThreads::SystemClockMillis();
-        CBaseTexture* texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
+        CBaseTexture* texture = nullptr;
+        if (m_prefetcher)
+          texture = m_prefetcher->Take(m_strFileName, m_maxWidth, m_maxHeight, m_bStop);
+        if (!texture && !m_bStop)
+          texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
         totalTime += XbmcThreads::SystemClockMillis() - start;
         count++;
         // tell our parent
@@ -146,6 +156,8 @@ CGUIWindowSlideShow::CGUIWindowSlideShow(void)
   Reset();
 }
 
+CGUIWindowSlideShow::~CGUIWindowSlideShow() = default;
+
 void CGUIWindowSlideShow::AnnouncePlayerPlay(const CFileItemPtr& item)
 {
   CVariant param;
@@ -223,6 +235,8 @@ void CGUIWindowSlideShow::Reset()
   m_iCurrentPic = 0;
   m_iDirection = 1;
   m_iLastFailedNextSlide = -1;
+  m_iPrefetchSlide = -1;
+  m_iNavigationSlide = -1;
   m_slides.clear();
   AnnouncePlaylistClear();
   m_Resolution = CServiceBroker::GetWinSystem()->GetGfxContext().GetVideoResolution();
@@ -251,6 +265,13 @@ void CGUIWindowSlideShow::OnDeinitWindow(int nextWindowID)
       m_pBackgroundLoader->StopThread();
       m_pBackgroundLoader.reset();
     }
+    m_prefetcher.reset();
+    m_iPrefetchSlide = -1;
+    if (m_navigationCount > 0)
+      CLog::Log(LOGDEBUG, "Time to display %u selected slides: average %u ms, max %u ms",
+                m_navigationCount, m_navigationTotal / m_navigationCount, m_navigationMax);
+    m_navigationCount = m_navigationTotal = m_navigationMax = 0;
+    m_iNavigationSlide = -1;
     // and close the images.
     m_Image[0].Close();
     m_Image[1].Close();
@@ -276,6 +297,7 @@ void CGUIWindowSlideShow::Add(const CFileItem *picture)
   AnnouncePlaylistAdd(item, m_slides.size());
 
   m_slides.emplace_back(std::move(item));
+  m_iPrefetchSlide = -1;
 }
 
 void CGUIWindowSlideShow::ShowNext()
@@ -289,6 +311,7 @@ void CGUIWindowSlideShow::ShowNext()
   m_fZoom        = 1.0f;
   m_fRotate      = 0.0f;
   m_bLoadNextPic = true;
+  StartNavigation(m_iNextSlide);
 }
 
 void CGUIWindowSlideShow::ShowPrevious()
@@ -302,6 +325,7 @@ void CGUIWindowSlideShow::ShowPrevious()
   m_fZoom        = 1.0f;
   m_fRotate      = 0.0f;
   m_bLoadNextPic = true;
+  StartNavigation(m_iNextSlide);
 }
 
 void CGUIWindowSlideShow::Select(const std::string& strPicture)
@@ -323,6 +347,7 @@ void CGUIWindowSlideShow::Select(const std::string& strPicture)
         m_iNextSlide = i;
         m_bLoadNextPic = true;
       }
+      StartNavigation(i);
       return ;
     }
   }
@@ -388,8 +413,12 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
   // Create our background loader if necessary
   if (!m_pBackgroundLoader)
   {
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    if (advancedSettings->m_slideshowPrefetchAhead > 0 || advancedSettings->m_slideshowPrefetchBehind > 0)
+      m_prefetcher.reset(new CSlideShowPrefetcher(2, static_cast<size_t>(advancedSettings->m_slideshowPrefetchMemory) * 1024 * 1024));
+    m_iPrefetchSlide = -1;
     m_pBackgroundLoader.reset(new CBackgroundPicLoader());
-    m_pBackgroundLoader->Create(this);
+    m_pBackgroundLoader->Create(this, m_prefetcher.get());
   }
 
   bool bSlideShow = m_bSlideShow && !m_bPause && !m_bPlayingVideo;
@@ -456,6 +485,15 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
     }
   }
 
+  if (m_prefetcher)
+  {
+    int maxWidth, maxHeight;
+    GetCheckedSize((float)res.iWidth * m_fZoom,
+                   (float)res.iHeight * m_fZoom,
+                   maxWidth, maxHeight);
+    UpdatePrefetch(maxWidth, maxHeight);
+  }
+
   if (m_bErrorMessage)
   { // hack, just mark it all
     regions.push_back(CDirtyRegion(CRect(0.0f, 0.0f, (float)CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth(), (float)CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight())));
@@ -613,8 +651,20 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
       return;
 
   if (m_Image[m_iCurrentPic].IsLoaded())
+  {
     CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPicturesInfoProvider().SetCurrentSlide(m_slides.at(m_iCurrentSlide).get());
 
+    if (m_iNavigationSlide == m_iCurrentSlide && m_Image[m_iCurrentPic].SlideNumber() == m_iCurrentSlide)
+    {
+      const unsigned int elapsed = XbmcThreads::SystemClockMillis() - m_navigationStart;
+      CLog::Log(LOGDEBUG, "Slide %d shown %u ms after it was selected", m_iCurrentSlide, elapsed);
+      m_navigationCount++;
+      m_navigationTotal += elapsed;
+      m_navigationMax = std::max(m_navigationMax, elapsed);
+      m_iNavigationSlide = -1;
+    }
+  }
+
   RenderPause();
   if (m_slides.at(m_iCurrentSlide)->IsVideo() &&
       g_application.GetAppPlayer().IsRenderingGuiLayer())
@@ -691,6 +741,47 @@ int CGUIWindowSlideShow::GetNextSlide()
   return m_iCurrentSlide;
 }
 
+void CGUIWindowSlideShow::UpdatePrefetch(int maxWidth, int maxHeight)
+{
+  // while the slideshow runs on its own the previous pictures are rarely shown again
+  const bool behind = !m_bSlideShow || m_bPause;
+  if (m_iPrefetchSlide == m_iCurrentSlide && m_iPrefetchDirection == m_iDirection &&
+      m_bPrefetchBehind == behind)
+    return;
+  m_iPrefetchSlide = m_iCurrentSlide;
+  m_iPrefetchDirection = m_iDirection;
+  m_bPrefetchBehind = behind;
+
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const int slides = m_slides.size();
+  const int step = m_iDirection >= 0 ? 1 : -1;
+  std::vector<std::string> paths;
+  auto addSlides = [&](int direction, int count) {
+    for (int slide = (m_iCurrentSlide + direction + slides) % slides;
+         count > 0 && slide != m_iCurrentSlide; slide = (slide + direction + slides) % slides)
+    {
+      const CFileItemPtr& item = m_slides.at(slide);
+      if (item->IsVideo() || item->HasProperty("unplayable"))
+        continue;
+      const std::string path = GetPicturePath(item.get());
+      if (std::find(paths.begin(), paths.end(), path) == paths.end())
+        paths.push_back(path);
+      count--;
+    }
+  };
+  addSlides(step, advancedSettings->m_slideshowPrefetchAhead);
+  if (behind)
+    addSlides(-step, advancedSettings->m_slideshowPrefetchBehind);
+
+  m_prefetcher->Prefetch(paths, maxWidth, maxHeight);
+}
+
+void CGUIWindowSlideShow::StartNavigation(int slide)
+{
+  m_iNavigationSlide = slide;
+  m_navigationStart = XbmcThreads::SystemClockMillis();
+}
+
 EVENT_RESULT CGUIWindowSlideShow::OnMouseEvent(const CPoint &point, const CMouseEvent &event)
 {
   if (event.m_id == ACTION_GESTURE_NOTIFY)
@@ -1182,6 +1273,7 @@ void CGUIWindowSlideShow::Shuffle()
   KODI::UTILS::RandomShuffle(m_slides.begin(), m_slides.end());
   m_iCurrentSlide = 0;
   m_iNextSlide = GetNextSlide();
+  m_iPrefetchSlide = -1;
   m_bShuffled = true;
 
   AnnouncePropertyChanged("shuffled", true);
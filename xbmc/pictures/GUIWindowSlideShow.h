@@ -18,6 +18,7 @@
 #include <set>
 
 class CFileItemList;
+class CSlideShowPrefetcher;
 class CVariant;
 
 class CGUIWindowSlideShow;
@@ -28,7 +29,7 @@ public:
   CBackgroundPicLoader();
   ~CBackgroundPicLoader() override;
 
-  void Create(CGUIWindowSlideShow *pCallback);
+  void Create(CGUIWindowSlideShow *pCallback, CSlideShowPrefetcher *prefetcher);
   void LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight);
   bool IsLoading() { return m_isLoading;};
   int SlideNumber() const { return m_iSlideNumber; }
@@ -46,13 +47,14 @@ private:
   bool m_isLoading;
 
   CGUIWindowSlideShow *m_pCallback;
+  CSlideShowPrefetcher *m_prefetcher;
 };
 
 class CGUIWindowSlideShow : public CGUIDialog
 {
 public:
   CGUIWindowSlideShow(void);
-  ~CGUIWindowSlideShow() override = default;
+  ~CGUIWindowSlideShow() override;
 
   bool OnMessage(CGUIMessage& message) override;
   EVENT_RESULT OnMouseEvent(const CPoint &point, const CMouseEvent &event) override;
@@ -113,6 +115,8 @@ private:
   void GetCheckedSize(float width, float height, int &maxWidth, int &maxHeight);
   std::string GetPicturePath(CFileItem *item);
   int  GetNextSlide();
+  void UpdatePrefetch(int maxWidth, int maxHeight);
+  void StartNavigation(int slide);
 
   void AnnouncePlayerPlay(const CFileItemPtr& item);
   void AnnouncePlayerPause(const CFileItemPtr& item);
@@ -142,10 +146,22 @@ private:
   CSlideShowPic m_Image[2];
 
   int m_iCurrentPic;
+  // pictures around the current slide, loaded ahead of the background loader
+  std::unique_ptr<CSlideShowPrefetcher> m_prefetcher;
+  int m_iPrefetchSlide = -1;
+  int m_iPrefetchDirection = 0;
+  bool m_bPrefetchBehind = false;
   // background loader
   std::unique_ptr<CBackgroundPicLoader> m_pBackgroundLoader;
   int m_iLastFailedNextSlide;
   bool m_bLoadNextPic;
   RESOLUTION m_Resolution;
   CPoint m_firstGesturePoint;
+
+  // time from the user asking for a slide until it's shown
+  int m_iNavigationSlide = -1;
+  unsigned int m_navigationStart = 0;
+  unsigned int m_navigationCount = 0;
+  unsigned int m_navigationTotal = 0;
+  unsigned int m_navigationMax = 0;
 };
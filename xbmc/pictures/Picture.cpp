@@ -7,6 +7,7 @@
  */
 
 #include <algorithm>
+#include <new>
 
 #include "Picture.h"
 #include "URL.h"
@@ -433,91 +434,55 @@ bool CPicture::Rotate180CCW(uint32_t *&pixels, unsigned int &width, unsigned int
 
 bool CPicture::Rotate90CCW(uint32_t *&pixels, unsigned int &width, unsigned int &height)
 {
-  uint32_t *dest = new uint32_t[width * height * 4];
-  if (dest)
-  {
-    unsigned int d_height = width, d_width = height;
-    for (unsigned int y = 0; y < d_height; y++)
-    {
-      const uint32_t *src = pixels + (d_height - 1 - y); // y-th col from right, starting at top
-      uint32_t *dst = dest + d_width * y;                // y-th row from top, starting at left
-      for (unsigned int x = 0; x < d_width; x++)
-      {
-        *dst++ = *src;
-        src += width;
-      }
-    }
-    delete[] pixels;
-    pixels = dest;
-    std::swap(width, height);
-    return true;
-  }
-  return false;
+  // dest row y is the y-th col from right, starting at top
+  return TransposeImage(pixels, width, height, true, false);
 }
 
 bool CPicture::Rotate270CCW(uint32_t *&pixels, unsigned int &width, unsigned int &height)
 {
-  uint32_t *dest = new uint32_t[width * height * 4];
-  if (!dest)
-    return false;
-
-  unsigned int d_height = width, d_width = height;
-  for (unsigned int y = 0; y < d_height; y++)
-  {
-    const uint32_t *src = pixels + width * (d_width - 1) + y; // y-th col from left, starting at bottom
-    uint32_t *dst = dest + d_width * y;                       // y-th row from top, starting at left
-    for (unsigned int x = 0; x < d_width; x++)
-    {
-      *dst++ = *src;
-      src -= width;
-    }
-  }
-
-  delete[] pixels;
-  pixels = dest;
-  std::swap(width, height);
-  return true;
+  // dest row y is the y-th col from left, starting at bottom
+  return TransposeImage(pixels, width, height, false, true);
 }
 
 bool CPicture::Transpose(uint32_t *&pixels, unsigned int &width, unsigned int &height)
 {
-  uint32_t *dest = new uint32_t[width * height * 4];
-  if (!dest)
-    return false;
-
-  unsigned int d_height = width, d_width = height;
-  for (unsigned int y = 0; y < d_height; y++)
-  {
-    const uint32_t *src = pixels + y;   // y-th col from left, starting at top
-    uint32_t *dst = dest + d_width * y; // y-th row from top, starting at left
-    for (unsigned int x = 0; x < d_width; x++)
-    {
-      *dst++ = *src;
-      src += width;
-    }
-  }
-
-  delete[] pixels;
-  pixels = dest;
-  std::swap(width, height);
-  return true;
+  // dest row y is the y-th col from left, starting at top
+  return TransposeImage(pixels, width, height, false, false);
 }
 
 bool CPicture::TransposeOffAxis(uint32_t *&pixels, unsigned int &width, unsigned int &height)
 {
-  uint32_t *dest = new uint32_t[width * height * 4];
+  // dest row y is the y-th col from right, starting at bottom
+  return TransposeImage(pixels, width, height, true, true);
+}
+
+bool CPicture::TransposeImage(uint32_t *&pixels, unsigned int &width, unsigned int &height,
+                              bool fromRight, bool fromBottom)
+{
+  uint32_t *dest = new (std::nothrow) uint32_t[width * height];
   if (!dest)
     return false;
 
-  unsigned int d_height = width, d_width = height;
-  for (unsigned int y = 0; y < d_height; y++)
+  // walk in tiles so that both the source columns and the dest rows stay in cache,
+  // going through the source column by column touches a new cache line for every pixel
+  const unsigned int tile = 32;
+  const unsigned int d_height = width, d_width = height;
+  for (unsigned int ty = 0; ty < d_height; ty += tile)
   {
-    const uint32_t *src = pixels + width * (d_width - 1) + (d_height - 1 - y); // y-th col from right, starting at bottom
-    uint32_t *dst = dest + d_width * y;                                        // y-th row, starting at left
-    for (unsigned int x = 0; x < d_width; x++)
+    const unsigned int ty_end = std::min(ty + tile, d_height);
+    for (unsigned int tx = 0; tx < d_width; tx += tile)
     {
-      *dst++ = *src;
-      src -= width;
+      const unsigned int tx_end = std::min(tx + tile, d_width);
+      for (unsigned int y = ty; y < ty_end; y++)
+      {
+        const unsigned int col = fromRight ? width - 1 - y : y;
+        uint32_t *dst = dest + d_width * y + tx;
+        for (unsigned int x = tx; x < tx_end; x++)
+        {
+          const unsigned int row = fromBottom ? height - 1 - x : x;
+          *dst++ = pixels[width * row + col];
+        }
+      }
     }
   }
 
@@ -48,12 +48,20 @@ public:
     uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
     CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
 
+  /*! \brief Apply an EXIF orientation to an image
+   \param pixels [in/out] the image, may be replaced by a newly allocated one
+   \param width [in/out] width of the image
+   \param height [in/out] height of the image
+   \param orientation the EXIF orientation minus 1, i.e. 1 to 7
+   \return true if successful, false otherwise
+   */
+  static bool OrientateImage(uint32_t *&pixels, unsigned int &width, unsigned int &height, int orientation);
+
 private:
   static void GetScale(unsigned int width, unsigned int height, unsigned int &out_width, unsigned int &out_height);
   static bool ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned int in_height, unsigned int in_pitch,
                          uint8_t *out_pixels, unsigned int out_width, unsigned int out_height, unsigned int out_pitch,
                          CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
-  static bool OrientateImage(uint32_t *&pixels, unsigned int &width, unsigned int &height, int orientation);
 
   static bool FlipHorizontal(uint32_t *&pixels, unsigned int &width, unsigned int &height);
   static bool FlipVertical(uint32_t *&pixels, unsigned int &width, unsigned int &height);
@@ -62,6 +70,8 @@ private:
   static bool Rotate180CCW(uint32_t *&pixels, unsigned int &width, unsigned int &height);
   static bool Transpose(uint32_t *&pixels, unsigned int &width, unsigned int &height);
   static bool TransposeOffAxis(uint32_t *&pixels, unsigned int &width, unsigned int &height);
+  static bool TransposeImage(uint32_t *&pixels, unsigned int &width, unsigned int &height,
+                             bool fromRight, bool fromBottom);
 };
 
 //this class calls CreateThumbnailFromSurface in a CJob, so a png file can be written without halting the render thread
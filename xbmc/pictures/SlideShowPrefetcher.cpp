@@ -0,0 +1,271 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SlideShowPrefetcher.h"
+
+#include "guilib/Texture.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+const char* const kJobTypeSlideShowPrefetch = "slideshowprefetch";
+// how long to wait for a picture still loading before the slideshow loads it itself
+constexpr unsigned int TAKE_TIMEOUT = 5000; // ms
+}
+
+class CSlideShowPrefetcher::CLoadJob : public CJob
+{
+public:
+  CLoadJob(const std::string& path, int maxWidth, int maxHeight)
+    : m_path(path), m_maxWidth(maxWidth), m_maxHeight(maxHeight)
+  {
+  }
+
+  ~CLoadJob() override { delete m_texture; }
+
+  bool DoWork() override
+  {
+    if (m_abandoned)
+    {
+      m_skipped = true;
+      return false;
+    }
+    m_texture = CTexture::LoadFromFile(m_path, m_maxWidth, m_maxHeight);
+    return m_texture != nullptr;
+  }
+
+  const char* GetType() const override { return kJobTypeSlideShowPrefetch; }
+
+  bool operator==(const CJob* job) const override
+  {
+    if (strcmp(job->GetType(), GetType()) != 0)
+      return false;
+    const CLoadJob* loadJob = static_cast<const CLoadJob*>(job);
+    return loadJob->m_path == m_path && loadJob->m_maxWidth == m_maxWidth &&
+           loadJob->m_maxHeight == m_maxHeight;
+  }
+
+  const std::string m_path;
+  const int m_maxWidth;
+  const int m_maxHeight;
+  CBaseTexture* m_texture = nullptr;
+  std::atomic<bool> m_abandoned{false}; //!< the picture is no longer wanted
+  bool m_skipped = false; //!< abandoned before it started loading
+};
+
+CSlideShowPrefetcher::CSlideShowPrefetcher(unsigned int parallelLoads, size_t memoryBudget)
+  : CJobQueue(false, parallelLoads, CJob::PRIORITY_NORMAL), m_memoryBudget(memoryBudget)
+{
+}
+
+CSlideShowPrefetcher::~CSlideShowPrefetcher()
+{
+  CancelJobs();
+  if (m_hits + m_misses > 0)
+    CLog::Log(LOGDEBUG, "CSlideShowPrefetcher: {} of {} pictures were prefetched", m_hits,
+              m_hits + m_misses);
+}
+
+void CSlideShowPrefetcher::Prefetch(const std::vector<std::string>& paths, int maxWidth, int maxHeight)
+{
+  CSingleLock lock(m_section);
+
+  // textures of another size are of no use, e.g. after a resolution change
+  const bool sizeChanged = maxWidth != m_maxWidth || maxHeight != m_maxHeight;
+  m_maxWidth = maxWidth;
+  m_maxHeight = maxHeight;
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (sizeChanged || std::find(paths.begin(), paths.end(), it->first) == paths.end())
+    {
+      Release(it->second);
+      it = m_entries.erase(it);
+    }
+    else
+      ++it;
+  }
+
+  for (size_t i = 0; i < paths.size(); i++)
+  {
+    auto it = m_entries.find(paths[i]);
+    if (it != m_entries.end())
+    {
+      it->second.priority = i;
+      continue;
+    }
+
+    // don't start loads which would have to be dropped anyway
+    if (m_memoryUsed >= m_memoryBudget)
+      break;
+
+    Entry& entry = m_entries[paths[i]];
+    entry.priority = i;
+
+    // the picture came back while its abandoned load is still queued or running, a new job
+    // would be rejected as a duplicate of it
+    CLoadJob* job = FindJob(paths[i], maxWidth, maxHeight);
+    if (job)
+    {
+      job->m_abandoned = false;
+      entry.job = job;
+      continue;
+    }
+
+    job = new CLoadJob(paths[i], maxWidth, maxHeight);
+    if (!AddJob(job))
+    {
+      // retried on the next call
+      m_entries.erase(paths[i]);
+      continue;
+    }
+    entry.job = job;
+    m_jobs.insert(std::make_pair(paths[i], job));
+  }
+  Trim();
+}
+
+CBaseTexture* CSlideShowPrefetcher::Take(const std::string& path, int maxWidth, int maxHeight,
+                                         const std::atomic<bool>& abort)
+{
+  XbmcThreads::EndTime timeout(TAKE_TIMEOUT);
+  while (!abort)
+  {
+    {
+      CSingleLock lock(m_section);
+      auto it = m_entries.find(path);
+      if (it == m_entries.end() || it->second.taken || maxWidth != m_maxWidth ||
+          maxHeight != m_maxHeight)
+      {
+        m_misses++;
+        return nullptr;
+      }
+
+      Entry& entry = it->second;
+      if (!entry.job)
+      {
+        // keep the entry so the picture isn't loaded again while it's still wanted
+        entry.taken = true;
+        if (!entry.texture)
+        {
+          m_misses++;
+          return nullptr;
+        }
+        m_hits++;
+        m_memoryUsed -= entry.texture->GetPitch() * entry.texture->GetRows();
+        return entry.texture.release();
+      }
+      if (timeout.IsTimePast())
+      {
+        CLog::Log(LOGDEBUG, "CSlideShowPrefetcher::{} - gave up waiting for {}", __FUNCTION__,
+                  path);
+        Release(entry);
+        entry.taken = true;
+        m_misses++;
+        return nullptr;
+      }
+      m_loaded.Reset();
+    }
+    m_loaded.WaitMSec(100);
+  }
+  return nullptr;
+}
+
+void CSlideShowPrefetcher::OnJobComplete(unsigned int jobID, bool success, CJob* job)
+{
+  if (strcmp(job->GetType(), kJobTypeSlideShowPrefetch) == 0)
+  {
+    CLoadJob* loadJob = static_cast<CLoadJob*>(job);
+    CSingleLock lock(m_section);
+    auto range = m_jobs.equal_range(loadJob->m_path);
+    for (auto jobIt = range.first; jobIt != range.second; ++jobIt)
+    {
+      if (jobIt->second == loadJob)
+      {
+        m_jobs.erase(jobIt);
+        break;
+      }
+    }
+
+    auto it = m_entries.find(loadJob->m_path);
+    if (it != m_entries.end() && it->second.job == loadJob)
+    {
+      Entry& entry = it->second;
+      entry.job = nullptr;
+      // skipped before it was wanted again, load it on the next call
+      if (loadJob->m_skipped && !entry.taken)
+        m_entries.erase(it);
+      else if (success)
+      {
+        entry.texture.reset(loadJob->m_texture);
+        loadJob->m_texture = nullptr;
+        m_memoryUsed += entry.texture->GetPitch() * entry.texture->GetRows();
+        Trim();
+      }
+      m_loaded.Set();
+    }
+  }
+  CJobQueue::OnJobComplete(jobID, success, job);
+}
+
+CSlideShowPrefetcher::CLoadJob* CSlideShowPrefetcher::FindJob(const std::string& path,
+                                                              int maxWidth,
+                                                              int maxHeight) const
+{
+  auto range = m_jobs.equal_range(path);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second->m_maxWidth == maxWidth && it->second->m_maxHeight == maxHeight)
+      return it->second;
+  }
+  return nullptr;
+}
+
+void CSlideShowPrefetcher::Release(Entry& entry)
+{
+  if (entry.job)
+  {
+    // the job isn't cancelled, as a running job would no longer count against the parallel
+    // loads and the jobs queued behind it wouldn't be started. it skips the load if it hasn't
+    // started yet, its texture is dropped on completion. it's adopted again if the picture is
+    // wanted again before it completes.
+    entry.job->m_abandoned = true;
+    entry.job = nullptr;
+  }
+  if (entry.texture)
+  {
+    m_memoryUsed -= entry.texture->GetPitch() * entry.texture->GetRows();
+    entry.texture.reset();
+  }
+}
+
+void CSlideShowPrefetcher::Trim()
+{
+  // drop the least important textures, but keep at least one
+  while (m_memoryUsed > m_memoryBudget)
+  {
+    Entry* drop = nullptr;
+    unsigned int loaded = 0;
+    for (auto& it : m_entries)
+    {
+      if (!it.second.texture)
+        continue;
+      loaded++;
+      if (!drop || it.second.priority > drop->priority)
+        drop = &it.second;
+    }
+    if (loaded <= 1)
+      break;
+    Release(*drop);
+  }
+}
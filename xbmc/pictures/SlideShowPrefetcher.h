@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CBaseTexture;
+
+/*!
+ \brief Loads the pictures around the current slide of the slideshow in the background.
+
+ The slideshow tells which pictures it's likely to show next, the prefetcher loads
+ them in parallel jobs and keeps the textures until the slideshow takes them over.
+ Loads of pictures which are no longer wanted, e.g. after jumping to another slide,
+ are abandoned. Loaded textures are kept within a memory budget.
+ */
+class CSlideShowPrefetcher : public CJobQueue
+{
+public:
+  /*!
+   \param parallelLoads number of pictures to load at once
+   \param memoryBudget maximum size in bytes of the textures kept
+   */
+  CSlideShowPrefetcher(unsigned int parallelLoads, size_t memoryBudget);
+  ~CSlideShowPrefetcher() override;
+
+  /*!
+   \brief Set the pictures to prefetch, the most important first.
+   Loads of pictures not in the list are abandoned and their textures released.
+   \param paths the pictures to prefetch
+   \param maxWidth maximum width of the textures, as passed to CTexture::LoadFromFile()
+   \param maxHeight maximum height of the textures
+   */
+  void Prefetch(const std::vector<std::string>& paths, int maxWidth, int maxHeight);
+
+  /*!
+   \brief Take over a prefetched picture, waiting a few seconds at most for it if it's still
+   loading.
+   \param path the picture
+   \param maxWidth maximum width of the texture
+   \param maxHeight maximum height of the texture
+   \param abort stops waiting when set
+   \return the texture, owned by the caller, or nullptr if the picture hasn't been prefetched
+   (with this size), failed to load, is still loading or had to be released because of the
+   memory budget
+   */
+  CBaseTexture* Take(const std::string& path, int maxWidth, int maxHeight, const std::atomic<bool>& abort);
+
+  // implementation of IJobCallback
+  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+
+private:
+  class CLoadJob;
+
+  struct Entry
+  {
+    CLoadJob* job = nullptr; //!< owned by the job queue, set while loading
+    std::unique_ptr<CBaseTexture> texture;
+    size_t priority = 0;
+    bool taken = false;
+  };
+
+  CLoadJob* FindJob(const std::string& path, int maxWidth, int maxHeight) const;
+  void Release(Entry& entry);
+  void Trim();
+
+  CCriticalSection m_section;
+  CEvent m_loaded{true};
+  std::map<std::string, Entry> m_entries;
+  std::multimap<std::string, CLoadJob*> m_jobs; //!< queued and running jobs, also abandoned ones
+  int m_maxWidth = 0;
+  int m_maxHeight = 0;
+  const size_t m_memoryBudget;
+  size_t m_memoryUsed = 0;
+  unsigned int m_hits = 0;
+  unsigned int m_misses = 0;
+};
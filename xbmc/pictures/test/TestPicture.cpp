@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/FFmpegImage.h"
+#include "guilib/TextureFormats.h"
+#include "pictures/Picture.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// source pixel for each dest pixel, straight from the EXIF orientation definitions
+uint32_t ExpectedPixel(unsigned int width, unsigned int height, int orientation, unsigned int x, unsigned int y)
+{
+  unsigned int col = x, row = y;
+  switch (orientation)
+  {
+    case 1: col = width - 1 - x; break;
+    case 2: col = width - 1 - x; row = height - 1 - y; break;
+    case 3: row = height - 1 - y; break;
+    case 4: col = y; row = x; break;
+    case 5: col = y; row = height - 1 - x; break;
+    case 6: col = width - 1 - y; row = height - 1 - x; break;
+    case 7: col = width - 1 - y; row = x; break;
+  }
+  return row * width + col;
+}
+
+} // unnamed namespace
+
+TEST(TestPicture, OrientateImage)
+{
+  // not a multiple of the tile size to cover the partial tiles
+  const unsigned int width = 37;
+  const unsigned int height = 70;
+
+  for (int orientation = 1; orientation <= 7; orientation++)
+  {
+    uint32_t *pixels = new uint32_t[width * height];
+    for (unsigned int i = 0; i < width * height; i++)
+      pixels[i] = i;
+
+    unsigned int outWidth = width;
+    unsigned int outHeight = height;
+    ASSERT_TRUE(CPicture::OrientateImage(pixels, outWidth, outHeight, orientation));
+    if (orientation >= 4)
+    {
+      EXPECT_EQ(height, outWidth);
+      EXPECT_EQ(width, outHeight);
+    }
+    else
+    {
+      EXPECT_EQ(width, outWidth);
+      EXPECT_EQ(height, outHeight);
+    }
+
+    unsigned int mismatches = 0;
+    for (unsigned int y = 0; y < outHeight; y++)
+      for (unsigned int x = 0; x < outWidth; x++)
+        if (pixels[y * outWidth + x] != ExpectedPixel(width, height, orientation, x, y))
+          mismatches++;
+    EXPECT_EQ(0u, mismatches) << "orientation " << orientation;
+
+    delete[] pixels;
+  }
+}
+
+/*
+ * Decodes all images in the directory given in KODI_BENCHMARK_PICTURES at full size and
+ * at thumbnail size (KODI_BENCHMARK_THUMBSIZE, default 720) and prints the times per image.
+ */
+TEST(TestPicture, DecodeBenchmark)
+{
+  const char* path = std::getenv("KODI_BENCHMARK_PICTURES");
+  if (!path)
+    GTEST_SKIP() << "KODI_BENCHMARK_PICTURES not set";
+  const char* thumbSize = std::getenv("KODI_BENCHMARK_THUMBSIZE");
+  const unsigned int size = thumbSize ? std::strtoul(thumbSize, nullptr, 10) : 720;
+
+  CFileItemList items;
+  ASSERT_TRUE(XFILE::CDirectory::GetDirectory(path, items, ".jpg|.jpeg|.png|.webp",
+                                              XFILE::DIR_FLAG_NO_FILE_DIRS));
+
+  double totalFull = 0.0;
+  double totalThumb = 0.0;
+  for (const auto& item : items)
+  {
+    if (item->m_bIsFolder)
+      continue;
+
+    XFILE::CFile file;
+    XFILE::auto_buffer buffer;
+    if (file.LoadFile(item->GetPath(), buffer) <= 0)
+      continue;
+
+    double times[2];
+    unsigned int decodedWidth = 0;
+    unsigned int decodedHeight = 0;
+    unsigned int originalWidth = 0;
+    unsigned int originalHeight = 0;
+    const unsigned int sizes[2] = {16384, size};
+    for (int i = 0; i < 2; i++)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      CFFmpegImage image(item->GetMimeType());
+      ASSERT_TRUE(image.LoadImageFromMemory(reinterpret_cast<unsigned char*>(buffer.get()),
+                                            buffer.size(), sizes[i], sizes[i]));
+      std::vector<unsigned char> pixels(image.Width() * image.Height() * 4);
+      ASSERT_TRUE(image.Decode(pixels.data(), image.Width(), image.Height(), image.Width() * 4,
+                               XB_FMT_A8R8G8B8));
+      uint32_t* oriented = nullptr;
+      if (image.Orientation() > 1)
+      {
+        unsigned int width = image.Width();
+        unsigned int height = image.Height();
+        oriented = new uint32_t[width * height];
+        std::memcpy(oriented, pixels.data(), width * height * 4);
+        CPicture::OrientateImage(oriented, width, height, image.Orientation() - 1);
+      }
+      times[i] = MillisecondsSince(start);
+      delete[] oriented;
+
+      decodedWidth = image.Width();
+      decodedHeight = image.Height();
+      originalWidth = image.originalWidth();
+      originalHeight = image.originalHeight();
+    }
+
+    totalFull += times[0];
+    totalThumb += times[1];
+    std::cout << StringUtils::Format("{}: {}x{} full {:.1f} ms, {}x{} in {:.1f} ms\n",
+                                     URIUtils::GetFileName(item->GetPath()), originalWidth,
+                                     originalHeight, times[0], decodedWidth, decodedHeight,
+                                     times[1]);
+  }
+  std::cout << StringUtils::Format("total: full {:.1f} ms, thumbnails {:.1f} ms\n", totalFull,
+                                   totalThumb);
+}
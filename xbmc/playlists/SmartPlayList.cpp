@@ -1148,6 +1148,38 @@ void CSmartPlaylistRuleCombination::GetVirtualFolders(const std::string& strType
   }
 }
 
+bool CSmartPlaylistRuleCombination::IsTimeDependent(const std::string& strType, std::set<std::string> &referencedPlaylists) const
+{
+  for (const auto& combination : m_combinations)
+  {
+    std::shared_ptr<CSmartPlaylistRuleCombination> combo = std::static_pointer_cast<CSmartPlaylistRuleCombination>(combination);
+    if (combo && combo->IsTimeDependent(strType, referencedPlaylists))
+      return true;
+  }
+
+  for (const auto& rule : m_rules)
+  {
+    if (rule->m_operator == CDatabaseQueryRule::OPERATOR_IN_THE_LAST ||
+        rule->m_operator == CDatabaseQueryRule::OPERATOR_NOT_IN_THE_LAST)
+      return true;
+
+    // same playlists as in GetWhereClause()
+    if (rule->m_field != FieldPlaylist)
+      continue;
+
+    std::string playlistFile = CSmartPlaylistDirectory::GetPlaylistByName(rule->m_parameter.at(0), strType);
+    if (playlistFile.empty() || referencedPlaylists.find(playlistFile) != referencedPlaylists.end())
+      continue;
+
+    referencedPlaylists.insert(playlistFile);
+    CSmartPlaylist playlist;
+    if (playlist.Load(playlistFile) && playlist.IsTimeDependent(referencedPlaylists))
+      return true;
+  }
+
+  return false;
+}
+
 void CSmartPlaylistRuleCombination::AddRule(const CSmartPlaylistRule &rule)
 {
   std::shared_ptr<CSmartPlaylistRule> ptr(new CSmartPlaylistRule(rule));
@@ -1526,6 +1558,11 @@ void CSmartPlaylist::GetVirtualFolders(std::vector<std::string> &virtualFolders)
   m_ruleCombination.GetVirtualFolders(GetType(), virtualFolders);
 }
 
+bool CSmartPlaylist::IsTimeDependent(std::set<std::string> &referencedPlaylists) const
+{
+  return m_ruleCombination.IsTimeDependent(GetType(), referencedPlaylists);
+}
+
 std::string CSmartPlaylist::GetSaveLocation() const
 {
   if (m_playlistType == "mixed")
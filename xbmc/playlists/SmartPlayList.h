@@ -83,6 +83,8 @@ public:
                              std::set<std::string> &referencedPlaylists) const;
   void GetVirtualFolders(const std::string& strType,
                          std::vector<std::string> &virtualFolders) const;
+  bool IsTimeDependent(const std::string& strType,
+                       std::set<std::string> &referencedPlaylists) const;
 
   void AddRule(const CSmartPlaylistRule &rule);
 };
@@ -144,6 +146,13 @@ public:
   std::string GetWhereClause(const CDatabase &db, std::set<std::string> &referencedPlaylists) const;
   void GetVirtualFolders(std::vector<std::string> &virtualFolders) const;
 
+  /*! \brief whether the playlist matches different items over time without changes to the library,
+   e.g. items played in the last week. Playlists included by the rules are taken into account.
+
+   \param referencedPlaylists a set of playlists to know when we reach a cycle
+   */
+  bool IsTimeDependent(std::set<std::string> &referencedPlaylists) const;
+
   std::string GetSaveLocation() const;
 
   static void GetAvailableFields(const std::string &type, std::vector<std::string> &fieldList);
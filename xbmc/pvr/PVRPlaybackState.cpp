@@ -324,9 +324,9 @@ std::shared_ptr<CPVRChannelGroup> CPVRPlaybackState::GetPlayingGroup(bool bRadio
 CDateTime CPVRPlaybackState::GetPlaybackTime() const
 {
   // start time valid?
-  time_t startTime = CServiceBroker::GetDataCacheCore().GetStartTime();
-  if (startTime > 0)
-    return CDateTime(startTime + CServiceBroker::GetDataCacheCore().GetPlayTime() / 1000);
+  const PlayerStateSnapshot state = CServiceBroker::GetDataCacheCore().GetPlayerStateSnapshot();
+  if (state.startTime > 0)
+    return CDateTime(state.startTime + state.time / 1000);
   else
     return CDateTime::GetUTCDateTime();
 }
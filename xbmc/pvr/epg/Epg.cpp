@@ -27,6 +27,11 @@
 
 using namespace PVR;
 
+namespace
+{
+std::atomic<unsigned int> g_lastTagsVersion{0};
+} // unnamed namespace
+
 CPVREpg::CPVREpg(int iEpgID,
                  const std::string& strName,
                  const std::string& strScraperName,
@@ -37,6 +42,7 @@ CPVREpg::CPVREpg(int iEpgID,
     m_channelData(new CPVREpgChannelData),
     m_tags(m_iEpgID, m_channelData, database)
 {
+  TagsChanged();
 }
 
 CPVREpg::CPVREpg(int iEpgID,
@@ -51,6 +57,7 @@ CPVREpg::CPVREpg(int iEpgID,
     m_channelData(channelData),
     m_tags(m_iEpgID, m_channelData, database)
 {
+  TagsChanged();
 }
 
 CPVREpg::~CPVREpg()
@@ -72,6 +79,7 @@ void CPVREpg::Clear()
 {
   CSingleLock lock(m_critSection);
   m_tags.Clear();
+  TagsChanged();
 }
 
 void CPVREpg::Cleanup(int iPastDays)
@@ -80,10 +88,11 @@ void CPVREpg::Cleanup(int iPastDays)
   Cleanup(cleanupTime);
 }
 
-void CPVREpg::Cleanup(const CDateTime& time)
+void CPVREpg::Cleanup(const CDateTime& time, bool bQueueWrite /* = false */)
 {
   CSingleLock lock(m_critSection);
-  m_tags.Cleanup(time);
+  m_tags.Cleanup(time, bQueueWrite);
+  TagsChanged();
 }
 
 std::shared_ptr<CPVREpgInfoTag> CPVREpg::GetTagNow(bool bUpdateIfNeeded /* = true */) const
@@ -146,7 +155,10 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpg::GetTagBetween(const CDateTime& beginTim
       tag = tmpEpg->GetTagBetween(beginTime, endTime, false);
 
     if (tag)
+    {
       m_tags.UpdateEntry(tag);
+      TagsChanged();
+    }
   }
 
   return tag;
@@ -168,6 +180,7 @@ bool CPVREpg::UpdateEntries(const CPVREpg& epg)
 
   /* copy over tags */
   m_tags.UpdateEntries(epg.m_tags);
+  TagsChanged();
 
   /* update the last scan time of this table */
   m_lastScanTime = CDateTime::GetUTCDateTime();
@@ -200,7 +213,11 @@ bool CPVREpg::UpdateEntry(const EPG_TAG* data, int iClientId)
   const std::shared_ptr<CPVREpgInfoTag> tag =
       std::make_shared<CPVREpgInfoTag>(*data, iClientId, m_channelData, m_iEpgID);
 
-  return !IsTagExpired(tag) && m_tags.UpdateEntry(tag);
+  if (IsTagExpired(tag) || !m_tags.UpdateEntry(tag))
+    return false;
+
+  TagsChanged();
+  return true;
 }
 
 bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, EPG_EVENT_STATE newState)
@@ -239,7 +256,10 @@ bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, EPG_EVENT_
   }
 
   if (bRet && bNotify)
+  {
+    TagsChanged();
     m_events.Publish(PVREvent::EpgItemUpdate);
+  }
 
   return bRet;
 }
@@ -329,9 +349,7 @@ bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database, bool bQu
     iNewEpgID = database->Persist(iEpgID, name, scraper, iEpgID > 0);
 
   if (bLastScanTimeNeedsSave)
-    database->PersistLastEpgScanTime(iNewEpgID, lastScanTime, bQueueWrite);
-
-  bool bRet = bQueueWrite || database->CommitInsertQueries();
+    database->PersistLastEpgScanTime(iNewEpgID, lastScanTime, true);
 
   database->Unlock();
 
@@ -343,10 +361,11 @@ bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database, bool bQu
     m_tags.SetEpgID(iNewEpgID);
   }
 
+  // write the table and its tags in one transaction
   if (bTagsNeedSave)
-    m_tags.Persist(!bQueueWrite);
+    m_tags.Persist(false);
 
-  return bRet;
+  return bQueueWrite || database->CommitInsertQueries();
 }
 
 bool CPVREpg::Delete(const std::shared_ptr<CPVREpgDatabase>& database)
@@ -502,6 +521,12 @@ void CPVREpg::SetChannelData(const std::shared_ptr<CPVREpgChannelData>& data)
   CSingleLock lock(m_critSection);
   m_channelData = data;
   m_tags.SetChannelData(data);
+  TagsChanged();
+}
+
+void CPVREpg::TagsChanged()
+{
+  m_iTagsVersion = ++g_lastTagsVersion;
 }
 
 int CPVREpg::ChannelID() const
@@ -14,6 +14,7 @@
 #include "threads/CriticalSection.h"
 #include "utils/EventStream.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -113,8 +114,9 @@ namespace PVR
     /*!
      * @brief Remove all entries from this EPG that finished before the given time.
      * @param time Delete entries with an end time before this time in UTC.
+     * @param bQueueWrite Don't delete them from the database immediately but queue the query if true.
      */
-    void Cleanup(const CDateTime& time);
+    void Cleanup(const CDateTime& time, bool bQueueWrite = false);
 
     /*!
      * @brief Remove all entries from this EPG.
@@ -255,6 +257,12 @@ namespace PVR
      */
     bool IsValid() const;
 
+    /*!
+     * @brief Get a version number for the tags of this EPG.
+     * @return A number that changes whenever tags of this EPG are added, changed or removed. Unique across all EPGs.
+     */
+    unsigned int GetTagsVersion() const { return m_iTagsVersion; }
+
     /*!
      * @brief Query the events available for CEventStream
      */
@@ -291,6 +299,11 @@ namespace PVR
      */
     bool UpdateEntries(const CPVREpg& epg);
 
+    /*!
+     * @brief Assign a new tags version, to be called whenever the tags of this EPG change.
+     */
+    void TagsChanged();
+
     /*!
      * @brief Remove all entries from this EPG that finished before the given amount of days.
      * @param iPastDays Delete entries with an end time before the given amount of days from now on.
@@ -307,6 +320,7 @@ namespace PVR
     bool m_bUpdateLastScanTime = false;
     std::shared_ptr<CPVREpgChannelData> m_channelData;
     CPVREpgTagsContainer m_tags;
+    std::atomic<unsigned int> m_iTagsVersion;
 
     CEventSource<PVREvent> m_events;
   };
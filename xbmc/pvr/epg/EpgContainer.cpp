@@ -21,6 +21,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 
 #include <memory>
@@ -290,20 +291,31 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
 
   if (!changedEpgs.empty())
   {
+    const uint64_t iWrittenTags = database->GetWrittenTagsCount();
+    const unsigned int iStart = XbmcThreads::SystemClockMillis();
+    unsigned int iPersisted = 0;
+
     XbmcThreads::EndTime processTimeslice(iMaxTimeslice);
     for (const auto& epg : changedEpgs)
     {
       CLog::Log(LOGDEBUG, "EPG Container: Persisting events for channel '%s'...",
                 epg->GetChannelData()->ChannelName().c_str());
 
-      bReturn &= epg->Persist(database, true);
+      // one transaction per table
+      bReturn &= epg->Persist(database, false);
+      iPersisted++;
 
       if (processTimeslice.IsTimePast())
         break;
     }
 
-    if (bReturn)
-      database->CommitInsertQueries();
+    const unsigned int iTags =
+        static_cast<unsigned int>(database->GetWrittenTagsCount() - iWrittenTags);
+    const unsigned int iElapsed = XbmcThreads::SystemClockMillis() - iStart;
+    CLog::Log(LOGDEBUG,
+              "EPG Container: Persisted %u of %u tables, %u events written in %u ms (%u events/s)",
+              iPersisted, static_cast<unsigned int>(changedEpgs.size()), iTags, iElapsed,
+              iElapsed > 0 ? static_cast<unsigned int>(iTags * 1000ULL / iElapsed) : iTags);
   }
 
   return bReturn;
@@ -570,9 +582,13 @@ bool CPVREpgContainer::RemoveOldEntries()
 {
   const CDateTime cleanupTime(CDateTime::GetUTCDateTime() - CDateTimeSpan(GetPastDaysToDisplay(), 0, 0, 0));
 
-  /* call Cleanup() on all known EPG tables */
+  /* call Cleanup() on all known EPG tables, removing their old entries in one go */
   for (const auto& epgEntry : m_epgIdToEpgMap)
-    epgEntry.second->Cleanup(cleanupTime);
+    epgEntry.second->Cleanup(cleanupTime, true);
+
+  const std::shared_ptr<CPVREpgDatabase> database = GetEpgDatabase();
+  if (database)
+    database->CommitInsertQueries();
 
   CSingleLock lock(m_critSection);
   CDateTime::GetCurrentDateTime().GetAsUTCDateTime().GetAsTime(m_iLastEpgCleanup);
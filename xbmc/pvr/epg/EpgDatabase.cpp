@@ -16,9 +16,12 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/Crc32.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +29,21 @@
 using namespace dbiplus;
 using namespace PVR;
 
+namespace
+{
+
+// columns of an epgtags row as written by CPVREpgDatabase::GetEpgTagValues
+const std::string EPG_TAG_COLUMNS =
+    "idEpg, iStartTime, iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, "
+    "sWriter, iYear, sIMDBNumber, sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, "
+    "iParentalRating, iStarRating, iSeriesId, iEpisodeId, iEpisodePart, sEpisodeName, iFlags, "
+    "sSeriesLink, iBroadcastUid, iContentHash, idBroadcast";
+
+// rows or ranges per queued statement
+constexpr size_t BULK_ROWS = 100;
+
+} // unnamed namespace
+
 bool CPVREpgDatabase::Open()
 {
   CSingleLock lock(m_critSection);
@@ -93,7 +111,8 @@ void CPVREpgDatabase::CreateTables()
         "iEpisodePart    integer, "
         "sEpisodeName    varchar(128), "
         "iFlags          integer, "
-        "sSeriesLink     varchar(255)"
+        "sSeriesLink     varchar(255), "
+        "iContentHash    integer"
       ")"
   );
 
@@ -258,6 +277,11 @@ void CPVREpgDatabase::UpdateTables(int iVersion)
     m_pDS->exec("DROP TABLE epgtags");
     m_pDS->exec("ALTER TABLE epgtags_new RENAME TO epgtags");
   }
+
+  if (iVersion < 14)
+  {
+    m_pDS->exec("ALTER TABLE epgtags ADD iContentHash integer;");
+  }
 }
 
 bool CPVREpgDatabase::DeleteEpg()
@@ -377,6 +401,7 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpgDatabase::CreateEpgTag(
     newTag->m_strIconPath = m_pDS->fv("sIconPath").get_asString().c_str();
     newTag->m_iFlags = m_pDS->fv("iFlags").get_asInt();
     newTag->m_strSeriesLink = m_pDS->fv("sSeriesLink").get_asString().c_str();
+    newTag->m_iContentHash = m_pDS->fv("iContentHash").get_asInt();
 
     newTag->SetGenre(m_pDS->fv("iGenreType").get_asInt(), m_pDS->fv("iGenreSubType").get_asInt(),
                      m_pDS->fv("sGenre").get_asString().c_str());
@@ -999,7 +1024,9 @@ int CPVREpgDatabase::Persist(int iEpgId,
   return iReturn;
 }
 
-bool CPVREpgDatabase::DeleteEpgTags(int iEpgId, const CDateTime& maxEndTime)
+bool CPVREpgDatabase::DeleteEpgTags(int iEpgId,
+                                    const CDateTime& maxEndTime,
+                                    bool bQueueWrite /* = false */)
 {
   time_t iMaxEndTime;
   maxEndTime.GetAsTime(iMaxEndTime);
@@ -1007,6 +1034,10 @@ bool CPVREpgDatabase::DeleteEpgTags(int iEpgId, const CDateTime& maxEndTime)
   Filter filter;
 
   CSingleLock lock(m_critSection);
+  if (bQueueWrite)
+    return QueueInsertQuery(PrepareSQL("DELETE FROM epgtags WHERE idEpg = %u AND iEndTime < %u;",
+                                       iEpgId, static_cast<unsigned int>(iMaxEndTime)));
+
   filter.AppendWhere(
       PrepareSQL("idEpg = %u AND iEndTime < %u", iEpgId, static_cast<unsigned int>(iMaxEndTime)));
   return DeleteValues("epgtags", filter);
@@ -1021,16 +1052,8 @@ bool CPVREpgDatabase::DeleteEpgTags(int iEpgId)
   return DeleteValues("epgtags", filter);
 }
 
-int CPVREpgDatabase::Persist(const CPVREpgInfoTag& tag, bool bSingleUpdate /* = true */)
+std::string CPVREpgDatabase::GetEpgTagValues(const CPVREpgInfoTag& tag, int& iContentHash) const
 {
-  int iReturn(-1);
-
-  if (tag.EpgID() <= 0)
-  {
-    CLog::LogF(LOGERROR, "Tag '%s' does not have a valid table", tag.Title().c_str());
-    return iReturn;
-  }
-
   time_t iStartTime, iEndTime;
   tag.StartAsUTC().GetAsTime(iStartTime);
   tag.EndAsUTC().GetAsTime(iEndTime);
@@ -1039,47 +1062,45 @@ int CPVREpgDatabase::Persist(const CPVREpgInfoTag& tag, bool bSingleUpdate /* =
   if (tag.FirstAired().IsValid())
     sFirstAired = tag.FirstAired().GetAsW3CDate();
 
-  int iBroadcastId = tag.DatabaseID();
-  std::string strQuery;
-
   /* Only store the genre string when needed */
   std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING || tag.GenreSubType() == EPG_GENRE_USE_STRING) ? tag.DeTokenize(tag.Genre()) : "";
 
-  CSingleLock lock(m_critSection);
+  const std::string strValues = PrepareSQL(
+      "%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', %i",
+      tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
+      tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
+      tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
+      tag.DeTokenize(tag.Writers()).c_str(), tag.Year(), tag.IMDBNumber().c_str(),
+      tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
+      sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
+      tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(), tag.SeriesLink().c_str(),
+      tag.UniqueBroadcastID());
+
+  // stored as a signed integer column
+  iContentHash = static_cast<int>(Crc32::Compute(strValues));
+
+  // strValues is already escaped, so it's not passed to PrepareSQL again
+  const int iBroadcastId = tag.DatabaseID();
+  return "(" + strValues + ", " + std::to_string(iContentHash) + ", " +
+         (iBroadcastId < 0 ? std::string("NULL") : std::to_string(iBroadcastId)) + ")";
+}
 
-  if (iBroadcastId < 0)
-  {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', %i);",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
-        tag.DeTokenize(tag.Writers()).c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(), tag.SeriesLink().c_str(),
-        tag.UniqueBroadcastID());
-  }
-  else
+int CPVREpgDatabase::Persist(const CPVREpgInfoTag& tag, bool bSingleUpdate /* = true */)
+{
+  int iReturn(-1);
+
+  if (tag.EpgID() <= 0)
   {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid, idBroadcast) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', %i, %i);",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
-        tag.DeTokenize(tag.Writers()).c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(), tag.SeriesLink().c_str(),
-        tag.UniqueBroadcastID(), iBroadcastId);
+    CLog::LogF(LOGERROR, "Tag '%s' does not have a valid table", tag.Title().c_str());
+    return iReturn;
   }
 
+  CSingleLock lock(m_critSection);
+
+  int iContentHash;
+  const std::string strQuery =
+      "REPLACE INTO epgtags (" + EPG_TAG_COLUMNS + ") VALUES " + GetEpgTagValues(tag, iContentHash) + ";";
+
   if (bSingleUpdate)
   {
     if (ExecuteQuery(strQuery))
@@ -1094,6 +1115,166 @@ int CPVREpgDatabase::Persist(const CPVREpgInfoTag& tag, bool bSingleUpdate /* =
   return iReturn;
 }
 
+int CPVREpgDatabase::QueuePersistQuery(int iEpgId,
+                                       const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+{
+  if (iEpgId <= 0)
+  {
+    CLog::LogF(LOGERROR, "Invalid EPG id: %d", iEpgId);
+    return 0;
+  }
+
+  struct Row
+  {
+    std::shared_ptr<CPVREpgInfoTag> tag;
+    time_t start;
+    time_t end;
+    std::string values;
+    int iContentHash;
+    bool bChanged;
+  };
+
+  CSingleLock lock(m_critSection);
+
+  std::vector<Row> rows;
+  rows.reserve(tags.size());
+  for (const auto& tag : tags)
+  {
+    if (tag->EpgID() != iEpgId)
+    {
+      CLog::LogF(LOGERROR, "Tag '%s' does not belong to EPG %d", tag->Title().c_str(), iEpgId);
+      continue;
+    }
+
+    Row row;
+    row.tag = tag;
+    tag->StartAsUTC().GetAsTime(row.start);
+    tag->EndAsUTC().GetAsTime(row.end);
+    row.values = GetEpgTagValues(*tag, row.iContentHash);
+    {
+      CSingleLock tagLock(tag->m_critSection);
+      row.bChanged = tag->m_iContentHash != row.iContentHash;
+    }
+    rows.emplace_back(std::move(row));
+  }
+
+  // conflicting events are removed by the time range of each changed tag. an unchanged tag within
+  // such a range must be written again, which in turn removes the events conflicting with it.
+  for (bool bCascaded = true; bCascaded;)
+  {
+    bCascaded = false;
+
+    time_t maxChangedEnd = 0;
+    for (auto& row : rows)
+    {
+      if (!row.bChanged && row.start < maxChangedEnd)
+        bCascaded = row.bChanged = true;
+      if (row.bChanged)
+        maxChangedEnd = std::max(maxChangedEnd, row.end);
+    }
+
+    time_t minChangedStart = std::numeric_limits<time_t>::max();
+    for (auto it = rows.rbegin(); it != rows.rend(); ++it)
+    {
+      if (!it->bChanged && it->end > minChangedStart)
+        bCascaded = it->bChanged = true;
+      if (it->bChanged)
+        minChangedStart = std::min(minChangedStart, it->start);
+    }
+  }
+
+  // remove conflicting events, with adjoining ranges merged
+  std::vector<std::pair<time_t, time_t>> ranges;
+  for (const auto& row : rows)
+  {
+    if (!row.bChanged)
+      continue;
+
+    if (!ranges.empty() && row.start <= ranges.back().second)
+      ranges.back().second = std::max(ranges.back().second, row.end);
+    else
+      ranges.emplace_back(row.start, row.end);
+  }
+
+  for (size_t i = 0; i < ranges.size(); i += BULK_ROWS)
+  {
+    std::string strWhere;
+    for (size_t j = i; j < ranges.size() && j < i + BULK_ROWS; j++)
+    {
+      if (!strWhere.empty())
+        strWhere += " OR ";
+      strWhere += PrepareSQL("(iEndTime > %u AND iStartTime < %u)",
+                             static_cast<unsigned int>(ranges[j].first),
+                             static_cast<unsigned int>(ranges[j].second));
+    }
+    QueueInsertQuery(PrepareSQL("DELETE FROM epgtags WHERE idEpg = %u AND (", iEpgId) + strWhere + ");");
+  }
+
+  // write the changed tags, several rows per statement
+  int iWritten = 0;
+  std::string strQuery;
+  for (const auto& row : rows)
+  {
+    if (!row.bChanged)
+      continue;
+
+    if (strQuery.empty())
+      strQuery = "REPLACE INTO epgtags (" + EPG_TAG_COLUMNS + ") VALUES " + row.values;
+    else
+      strQuery += ", " + row.values;
+
+    if (++iWritten % BULK_ROWS == 0)
+    {
+      QueueInsertQuery(strQuery + ";");
+      strQuery.clear();
+    }
+
+    CSingleLock tagLock(row.tag->m_critSection);
+    row.tag->m_iContentHash = row.iContentHash;
+  }
+
+  if (!strQuery.empty())
+    QueueInsertQuery(strQuery + ";");
+
+  m_iWrittenTags += iWritten;
+  return iWritten;
+}
+
+int CPVREpgDatabase::QueueDeleteQuery(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+{
+  std::vector<int> ids;
+  ids.reserve(tags.size());
+  for (const auto& tag : tags)
+  {
+    /* tag without a database ID was not persisted */
+    if (tag->DatabaseID() > 0)
+      ids.emplace_back(tag->DatabaseID());
+  }
+
+  CSingleLock lock(m_critSection);
+
+  for (size_t i = 0; i < ids.size(); i += BULK_ROWS)
+  {
+    std::string strIds;
+    for (size_t j = i; j < ids.size() && j < i + BULK_ROWS; j++)
+    {
+      if (!strIds.empty())
+        strIds += ", ";
+      strIds += std::to_string(ids[j]);
+    }
+    QueueInsertQuery("DELETE FROM epgtags WHERE idBroadcast IN (" + strIds + ");");
+  }
+
+  m_iWrittenTags += ids.size();
+  return static_cast<int>(ids.size());
+}
+
+uint64_t CPVREpgDatabase::GetWrittenTagsCount() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iWrittenTags;
+}
+
 int CPVREpgDatabase::GetLastEPGId()
 {
   CSingleLock lock(m_critSection);
@@ -11,7 +11,9 @@
 #include "dbwrappers/Database.h"
 #include "threads/CriticalSection.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 class CDateTime;
@@ -63,7 +65,7 @@ namespace PVR
      * @brief Get the minimal database version that is required to operate correctly.
      * @return The minimal database version.
      */
-    int GetSchemaVersion() const override { return 13; }
+    int GetSchemaVersion() const override { return 14; }
 
     /*!
      * @brief Get the default sqlite database filename.
@@ -240,9 +242,10 @@ namespace PVR
      * @brief Erase all EPG tags with the given epg ID and an end time less than the given time.
      * @param iEpgId The ID of the EPG.
      * @param maxEndTime The maximum allowed end time.
+     * @param bQueueWrite Don't execute the query immediately but queue it if true.
      * @return True if the entries were removed successfully, false otherwise.
      */
-    bool DeleteEpgTags(int iEpgId, const CDateTime& maxEndTime);
+    bool DeleteEpgTags(int iEpgId, const CDateTime& maxEndTime, bool bQueueWrite = false);
 
     /*!
      * @brief Erase all EPG tags with the given epg ID.
@@ -259,6 +262,30 @@ namespace PVR
      */
     int Persist(const CPVREpgInfoTag& tag, bool bSingleUpdate = true);
 
+    /*!
+     * @brief Queue the persistence of the given tags of an EPG, to be written in one transaction
+     * by CommitInsertQueries(). Events conflicting with changed tags are removed. Tags whose content
+     * is the same as in the database are skipped, unless they conflict with a changed tag.
+     * @param iEpgId The ID of the EPG.
+     * @param tags The tags to persist, sorted by start time.
+     * @return The number of tags queued for writing.
+     */
+    int QueuePersistQuery(int iEpgId, const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags);
+
+    /*!
+     * @brief Queue the removal of the given tags, to be executed by CommitInsertQueries().
+     * @param tags The tags to remove. Tags that were not persisted are ignored.
+     * @return The number of tags queued for removal.
+     */
+    int QueueDeleteQuery(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags);
+
+    /*!
+     * @brief Get the number of tags written or removed so far by QueuePersistQuery() and
+     * QueueDeleteQuery(), e.g. to measure the throughput of an update.
+     * @return The number of tags.
+     */
+    uint64_t GetWrittenTagsCount() const;
+
     /*!
      * @return Last EPG id in the database
      */
@@ -287,6 +314,15 @@ namespace PVR
 
     std::shared_ptr<CPVREpgInfoTag> CreateEpgTag(const std::unique_ptr<dbiplus::Dataset>& pDS);
 
-    CCriticalSection m_critSection;
+    /*!
+     * @brief Get the values of an epgtags row for the given tag, in the order of EPG_TAG_COLUMNS.
+     * @param tag The tag.
+     * @param iContentHash Set to the hash of the values, not including the database ID of the tag.
+     * @return The values, enclosed in parentheses.
+     */
+    std::string GetEpgTagValues(const CPVREpgInfoTag& tag, int& iContentHash) const;
+
+    mutable CCriticalSection m_critSection;
+    uint64_t m_iWrittenTags = 0;
   };
 }
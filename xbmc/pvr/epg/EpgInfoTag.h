@@ -483,6 +483,7 @@ namespace PVR
     unsigned int m_iFlags = 0; /*!< the flags applicable to this EPG entry */
     std::string m_strSeriesLink; /*!< series link */
     bool m_bIsGapTag = false;
+    int m_iContentHash = 0; /*!< hash of the content as last read from or written to the database */
 
     mutable CCriticalSection m_critSection;
     std::shared_ptr<CPVREpgChannelData> m_channelData;
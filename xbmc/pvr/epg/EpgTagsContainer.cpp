@@ -14,6 +14,8 @@
 #include "pvr/epg/EpgTagsCache.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 using namespace PVR;
 
 namespace
@@ -275,7 +277,7 @@ bool CPVREpgTagsContainer::DeleteEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
   return true;
 }
 
-void CPVREpgTagsContainer::Cleanup(const CDateTime& time)
+void CPVREpgTagsContainer::Cleanup(const CDateTime& time, bool bQueueWrite /* = false */)
 {
   for (auto it = m_changedTags.begin(); it != m_changedTags.end();)
   {
@@ -296,7 +298,7 @@ void CPVREpgTagsContainer::Cleanup(const CDateTime& time)
   }
 
   if (m_database)
-    m_database->DeleteEpgTags(m_iEpgID, time);
+    m_database->DeleteEpgTags(m_iEpgID, time, bQueueWrite);
 }
 
 void CPVREpgTagsContainer::Clear()
@@ -583,29 +585,30 @@ void CPVREpgTagsContainer::Persist(bool bCommit)
   {
     m_database->Lock();
 
-    CLog::Log(LOGDEBUG, "EPG Tags Container: Updating %d, deleting %d events...",
-              m_changedTags.size(), m_deletedTags.size());
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+    tags.reserve(std::max(m_deletedTags.size(), m_changedTags.size()));
 
     for (const auto& tag : m_deletedTags)
-      m_database->Delete(*tag.second);
+      tags.emplace_back(tag.second);
 
+    const int iDeleted = m_database->QueueDeleteQuery(tags);
     m_deletedTags.clear();
 
+    // conflicting events are removed from the database along with persisting the tags
+    tags.clear();
     for (const auto& tag : m_changedTags)
-    {
-      // remove any conflicting events from database before persisting the new event
-      m_database->DeleteEpgTagsByMinEndMaxStartTime(m_iEpgID, tag.second->StartAsUTC(),
-                                                    tag.second->EndAsUTC() - ONE_SECOND);
-
-      tag.second->Persist(m_database, false);
-    }
+      tags.emplace_back(tag.second);
 
+    const int iWritten = m_database->QueuePersistQuery(m_iEpgID, tags);
     m_changedTags.clear();
 
     if (bCommit)
       m_database->CommitInsertQueries();
 
     m_database->Unlock();
+
+    CLog::Log(LOGDEBUG, "EPG Tags Container: Updated %d events (%d unchanged), deleted %d events",
+              iWritten, static_cast<int>(tags.size()) - iWritten, iDeleted);
   }
 }
 
@@ -71,8 +71,9 @@ public:
   /*!
    * @brief Remove all entries which were finished before the given time.
    * @param time Delete entries with an end time before this time.
+   * @param bQueueWrite Don't delete them from the database immediately but queue the query if true.
    */
-  void Cleanup(const CDateTime& time);
+  void Cleanup(const CDateTime& time, bool bQueueWrite = false);
 
   /*!
    * @brief Check whether this container is empty.
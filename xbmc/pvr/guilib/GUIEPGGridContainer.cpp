@@ -1791,6 +1791,9 @@ void CGUIEPGGridContainer::SetTimelineItems(const std::unique_ptr<CFileItemList>
   {
     CSingleLock lock(m_critSection);
 
+    // only channels whose epg changed need to be fetched again
+    newUpdatedGridModel->TakeUnchangedEpgTags(*m_gridModel);
+
     // grid contains CFileItem instances. CFileItem dtor locks global graphics mutex.
     // by increasing its refcount make sure, old data are not deleted while we're holding own mutex.
     oldUpdatedGridModel = std::move(m_updatedGridModel);
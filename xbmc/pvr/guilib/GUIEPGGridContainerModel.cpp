@@ -20,7 +20,10 @@
 #include "utils/log.h"
 
 #include <cmath>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 using namespace PVR;
@@ -37,6 +40,51 @@ void CGUIEPGGridContainerModel::SetInvalid()
     ruler->SetInvalid();
 }
 
+void CGUIEPGGridContainerModel::TakeUnchangedEpgTags(const CGUIEPGGridContainerModel& other)
+{
+  if (m_gridStart != other.m_gridStart || m_gridEnd != other.m_gridEnd)
+    return;
+
+  // channel indexes may differ between the models, e.g. if channels were added or removed
+  std::map<std::pair<int, int>, int> channelIndexes;
+  for (int i = 0; i < ChannelItemsSize(); ++i)
+  {
+    const std::shared_ptr<CPVRChannel> channel = m_channelItems[i]->GetPVRChannelInfoTag();
+    channelIndexes.insert({{channel->ClientID(), channel->UniqueID()}, i});
+  }
+
+  for (const auto& epgItem : other.m_epgItems)
+  {
+    const EpgTags& epgTags = epgItem.second;
+    if (epgTags.tagsVersion == 0 || epgTags.tags.empty())
+      continue;
+
+    const std::shared_ptr<CPVRChannel> channel =
+        other.m_channelItems[epgItem.first]->GetPVRChannelInfoTag();
+    const auto it = channelIndexes.find({channel->ClientID(), channel->UniqueID()});
+    if (it == channelIndexes.end() || GetEpgTagsVersion((*it).second) != epgTags.tagsVersion)
+      continue; // channel gone or its epg changed; tags will be fetched on demand
+
+    m_epgItems.insert({(*it).second, epgTags});
+  }
+}
+
+unsigned int CGUIEPGGridContainerModel::GetEpgTagsVersion(int iChannel) const
+{
+  const std::shared_ptr<CPVREpg> epg = m_channelItems[iChannel]->GetPVRChannelInfoTag()->GetEPG();
+  return epg ? epg->GetTagsVersion() : 0;
+}
+
+void CGUIEPGGridContainerModel::UpdateEpgTagsVersion(EpgTags& epgTags,
+                                                     unsigned int tagsVersion) const
+{
+  // tags fetched from different versions of the epg can not be taken over by another model
+  if (epgTags.tags.empty())
+    epgTags.tagsVersion = tagsVersion;
+  else if (epgTags.tagsVersion != tagsVersion)
+    epgTags.tagsVersion = 0;
+}
+
 std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateGapItem(int iChannel) const
 {
   const std::shared_ptr<CPVRChannel> channel = m_channelItems[iChannel]->GetPVRChannelInfoTag();
@@ -138,6 +186,7 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateEpgTags(int iChannel
   const int firstBlock = iBlock < m_firstActiveBlock ? iBlock : m_firstActiveBlock;
   const int lastBlock = iBlock > m_lastActiveBlock ? iBlock : m_lastActiveBlock;
 
+  epgTags.tagsVersion = GetEpgTagsVersion(iChannel);
   const auto tags = m_channelItems[iChannel]->GetPVRChannelInfoTag()->GetEPGTimeline(
       m_gridStart, m_gridEnd, GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(lastBlock));
 
@@ -150,7 +199,7 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateEpgTags(int iChannel
     if (!result && IsEventMemberOfBlock(tag, iBlock))
       result = item;
 
-    epgTags.tags.emplace_back(item);
+    epgTags.tags.emplace_hint(epgTags.tags.end(), GetBlock(tag->StartAsUTC()), item);
   }
 
   return result;
@@ -174,19 +223,25 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTags(EpgTagsMap::ite
   }
   else
   {
-    for (const auto& item : epgTags.tags)
-    {
-      if (IsEventMemberOfBlock(item->GetEPGInfoTag(), iBlock))
-      {
-        result = item;
-        break;
-      }
-    }
+    result = FindEpgTag(epgTags, iBlock);
   }
 
   return result;
 }
 
+std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::FindEpgTag(const EpgTags& epgTags,
+                                                                 int iBlock) const
+{
+  const auto it = FindFirstEventOfBlock(
+      epgTags.tags, iBlock, [this, iBlock](const std::shared_ptr<CFileItem>& item) {
+        return IsEventMemberOfBlock(item->GetEPGInfoTag(), iBlock);
+      });
+  if (it == epgTags.tags.end())
+    return {};
+
+  return (*it).second;
+}
+
 std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsBefore(EpgTags& epgTags,
                                                                        int iChannel,
                                                                        int iBlock) const
@@ -197,6 +252,7 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsBefore(EpgTags&
   if (lastBlock < 0)
     lastBlock = 0;
 
+  UpdateEpgTagsVersion(epgTags, GetEpgTagsVersion(iChannel));
   const auto tags = m_channelItems[iChannel]->GetPVRChannelInfoTag()->GetEPGTimeline(
       m_gridStart, m_gridEnd, GetStartTimeForBlock(iBlock), GetStartTimeForBlock(lastBlock));
 
@@ -218,11 +274,12 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsBefore(EpgTags&
       // ptr comp does not work for gap tags!
       // if ((*it) == epgTags.tags.front()->GetEPGInfoTag())
 
-      const std::shared_ptr<CPVREpgInfoTag> t = epgTags.tags.front()->GetEPGInfoTag();
+      const std::shared_ptr<CFileItem> front = (*epgTags.tags.begin()).second;
+      const std::shared_ptr<CPVREpgInfoTag> t = front->GetEPGInfoTag();
       if ((*it)->StartAsUTC() == t->StartAsUTC() && (*it)->EndAsUTC() == t->EndAsUTC())
       {
         if (!result && IsEventMemberOfBlock(*it, iBlock))
-          result = epgTags.tags.front();
+          result = front;
 
         ++it; // skip, because we already have that epg tag
       }
@@ -234,7 +291,7 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsBefore(EpgTags&
       if (!result && IsEventMemberOfBlock(*it, iBlock))
         result = item;
 
-      epgTags.tags.insert(epgTags.tags.begin(), item);
+      epgTags.tags.emplace_hint(epgTags.tags.begin(), GetBlock((*it)->StartAsUTC()), item);
     }
   }
 
@@ -251,6 +308,7 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsAfter(EpgTags& e
   if (firstBlock >= GetLastBlock())
     firstBlock = GetLastBlock();
 
+  UpdateEpgTagsVersion(epgTags, GetEpgTagsVersion(iChannel));
   const auto tags = m_channelItems[iChannel]->GetPVRChannelInfoTag()->GetEPGTimeline(
       m_gridStart, m_gridEnd, GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(iBlock));
 
@@ -272,11 +330,12 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsAfter(EpgTags& e
       // ptr comp does not work for gap tags!
       // if ((*it) == epgTags.tags.back()->GetEPGInfoTag())
 
-      const std::shared_ptr<CPVREpgInfoTag> t = epgTags.tags.back()->GetEPGInfoTag();
+      const std::shared_ptr<CFileItem> back = (*epgTags.tags.rbegin()).second;
+      const std::shared_ptr<CPVREpgInfoTag> t = back->GetEPGInfoTag();
       if ((*it)->StartAsUTC() == t->StartAsUTC() && (*it)->EndAsUTC() == t->EndAsUTC())
       {
         if (!result && IsEventMemberOfBlock(*it, iBlock))
-          result = epgTags.tags.back();
+          result = back;
 
         ++it; // skip, because we already have that epg tag
       }
@@ -288,7 +347,7 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsAfter(EpgTags& e
       if (!result && IsEventMemberOfBlock(*it, iBlock))
         result = item;
 
-      epgTags.tags.emplace_back(item);
+      epgTags.tags.emplace_hint(epgTags.tags.end(), GetBlock((*it)->StartAsUTC()), item);
     }
   }
 
@@ -505,10 +564,12 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
 
         (*it).second.tags.clear();
 
+        epgTags.tagsVersion = GetEpgTagsVersion(i);
         tags = m_channelItems[i]->GetPVRChannelInfoTag()->GetEPGTimeline(m_gridStart, m_gridEnd,
                                                                          maxEnd, minStart);
         for (const auto& tag : tags)
-          epgTags.tags.emplace_back(std::make_shared<CFileItem>(tag));
+          epgTags.tags.emplace_hint(epgTags.tags.end(), GetBlock(tag->StartAsUTC()),
+                                    std::make_shared<CFileItem>(tag));
 
         epgTags.firstBlock = GetFirstEventBlock(tags.front());
         epgTags.lastBlock = GetLastEventBlock(tags.back());
@@ -646,8 +707,8 @@ std::unique_ptr<CFileItemList> CGUIEPGGridContainerModel::GetCurrentTimeLineItem
       // tags are sorted, so we can iterate and append
       for (const auto& tag : (*itEpg).second.tags)
       {
-        tag->SetProperty("TimelineIndex", i);
-        items->Add(tag);
+        tag.second->SetProperty("TimelineIndex", i);
+        items->Add(tag.second);
         ++i;
       }
     }
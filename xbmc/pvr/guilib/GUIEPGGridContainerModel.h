@@ -10,7 +10,9 @@
 
 #include "XBDateTime.h"
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <unordered_map>
@@ -66,6 +68,13 @@ namespace PVR
                     float fBlockSize);
     void SetInvalid();
 
+    /*!
+     * @brief Take over the epg tags already fetched by another model for all channels whose epg
+     *        did not change since. Does nothing if the other model covers a different grid.
+     * @param other The model to take the tags from.
+     */
+    void TakeUnchangedEpgTags(const CGUIEPGGridContainerModel& other);
+
     static const int INVALID_INDEX = -1;
     void FindChannelAndBlockIndex(int channelUid, unsigned int broadcastUid, int eventOffset, int& newChannelIndex, int& newBlockIndex) const;
 
@@ -110,16 +119,62 @@ namespace PVR
 
     std::unique_ptr<CFileItemList> GetCurrentTimeLineItems() const;
 
+    /*!
+     * @brief Find the first event in start order being member of a block.
+     * @param index Events keyed by the block they start in.
+     * @param iBlock The block.
+     * @param isMember Whether an event of the index is member of iBlock.
+     * @return The event or index.end() if there is none.
+     *
+     * Events starting in earlier blocks may last into iBlock, e.g. an event ending in the block
+     * the next event starts in. Such an event comes first, like in the grid items.
+     */
+    template<class Index, class Predicate>
+    static typename Index::const_iterator FindFirstEventOfBlock(const Index& index,
+                                                                int iBlock,
+                                                                Predicate isMember)
+    {
+      // group of the events starting last in or before the block
+      const auto end = index.upper_bound(iBlock);
+      if (end == index.begin())
+        return index.end();
+
+      auto first = index.lower_bound((*std::prev(end)).first);
+
+      // go back as long as events of the previous group still reach the block
+      while (first != index.begin())
+      {
+        const auto group = index.lower_bound((*std::prev(first)).first);
+        if (std::none_of(group, first, [&isMember](const typename Index::value_type& event) {
+              return isMember(event.second);
+            }))
+          break;
+
+        first = group;
+      }
+
+      for (; first != end; ++first)
+      {
+        if (isMember((*first).second))
+          return first;
+      }
+      return index.end();
+    }
+
   private:
     GridItem* GetGridItemPtr(int iChannel, int iBlock) const;
     std::shared_ptr<CFileItem> CreateGapItem(int iChannel) const;
     std::shared_ptr<CFileItem> GetItem(int iChannel, int iBlock) const;
 
+    // tags of a channel, keyed by the block the event starts in, for log(n) block lookups
+    using EpgTagsIndex = std::multimap<int, std::shared_ptr<CFileItem>>;
+
     struct EpgTags
     {
-      std::vector<std::shared_ptr<CFileItem>> tags;
+      EpgTagsIndex tags;
       int firstBlock = -1;
       int lastBlock = -1;
+      unsigned int tagsVersion = 0; // CPVREpg::GetTagsVersion() at the time the tags were fetched
     };
 
     using EpgTagsMap = std::unordered_map<int, EpgTags>;
@@ -130,6 +185,9 @@ namespace PVR
                                           int iBlock) const;
     std::shared_ptr<CFileItem> GetEpgTagsBefore(EpgTags& epgTags, int iChannel, int iBlock) const;
     std::shared_ptr<CFileItem> GetEpgTagsAfter(EpgTags& epgTags, int iChannel, int iBlock) const;
+    std::shared_ptr<CFileItem> FindEpgTag(const EpgTags& epgTags, int iBlock) const;
+    unsigned int GetEpgTagsVersion(int iChannel) const;
+    void UpdateEpgTagsVersion(EpgTags& epgTags, unsigned int tagsVersion) const;
 
     mutable EpgTagsMap m_epgItems;
 
@@ -108,10 +108,12 @@ void CPVRGUITimesInfo::UpdateTimeshiftData()
   }
 
   time_t now = std::time(nullptr);
-  time_t iStartTime;
-  int64_t iPlayTime, iMinTime, iMaxTime;
-  CServiceBroker::GetDataCacheCore().GetPlayTimes(iStartTime, iPlayTime, iMinTime, iMaxTime);
-  bool bPlaying = CServiceBroker::GetDataCacheCore().GetSpeed() == 1.0;
+  const PlayerStateSnapshot state = CServiceBroker::GetDataCacheCore().GetPlayerStateSnapshot();
+  time_t iStartTime = state.startTime;
+  int64_t iPlayTime = state.time;
+  int64_t iMinTime = state.timeMin;
+  int64_t iMaxTime = state.timeMax;
+  bool bPlaying = state.speed == 1.0;
   const std::shared_ptr<CPVRChannel> playingChannel = CServiceBroker::GetPVRManager().PlaybackState()->GetPlayingChannel();
 
   CSingleLock lock(m_critSection);
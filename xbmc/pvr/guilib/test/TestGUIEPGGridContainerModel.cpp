@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/guilib/GUIEPGGridContainerModel.h"
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+
+struct Event
+{
+  std::string name;
+  int firstBlock; // block the event starts in
+  int lastBlock; // block the event ends in
+};
+
+using EventIndex = std::multimap<int, Event>;
+
+EventIndex CreateIndex(std::initializer_list<Event> events)
+{
+  EventIndex index;
+  for (const Event& event : events)
+    index.emplace_hint(index.end(), event.firstBlock, event);
+  return index;
+}
+
+std::string Find(const EventIndex& index, int iBlock)
+{
+  const auto it = CGUIEPGGridContainerModel::FindFirstEventOfBlock(
+      index, iBlock, [iBlock](const Event& event) {
+        return event.firstBlock == iBlock ||
+               (event.firstBlock < iBlock && iBlock <= event.lastBlock);
+      });
+  return it == index.end() ? "" : (*it).second.name;
+}
+
+} // unnamed namespace
+
+TEST(TestGUIEPGGridContainerModel, FindFirstEventOfBlock)
+{
+  const EventIndex index = CreateIndex({{"A", 0, 1}, {"B", 2, 2}, {"C", 2, 4}, {"D", 6, 6}});
+
+  EXPECT_EQ("A", Find(index, 0));
+  EXPECT_EQ("A", Find(index, 1));
+  // several events starting in the same block, first one wins
+  EXPECT_EQ("B", Find(index, 2));
+  EXPECT_EQ("C", Find(index, 3));
+  EXPECT_EQ("C", Find(index, 4));
+  EXPECT_EQ("", Find(index, 5));
+  EXPECT_EQ("D", Find(index, 6));
+  EXPECT_EQ("", Find(index, 7));
+  EXPECT_EQ("", Find(index, -1));
+}
+
+TEST(TestGUIEPGGridContainerModel, FindEventSpillingIntoNextStartBlock)
+{
+  // A ends in the middle of block 7, the block B starts in
+  const EventIndex index = CreateIndex({{"A", 5, 7}, {"B", 7, 9}});
+
+  EXPECT_EQ("A", Find(index, 5));
+  EXPECT_EQ("A", Find(index, 7));
+  EXPECT_EQ("B", Find(index, 8));
+
+  // also across several groups of short events
+  const EventIndex groups =
+      CreateIndex({{"A", 1, 7}, {"B", 7, 7}, {"C", 7, 8}, {"D", 8, 8}, {"E", 8, 9}});
+  EXPECT_EQ("A", Find(groups, 7));
+  EXPECT_EQ("C", Find(groups, 8));
+  EXPECT_EQ("E", Find(groups, 9));
+}
@@ -170,6 +170,9 @@ void CAdvancedSettings::Initialize()
   m_slideshowPanAmount = 2.5f;
   m_slideshowZoomAmount = 5.0f;
   m_slideshowBlackBarCompensation = 20.0f;
+  m_slideshowPrefetchAhead = 2;
+  m_slideshowPrefetchBehind = 1;
+  m_slideshowPrefetchMemory = 256;
 
   m_songInfoDuration = 10;
 
@@ -416,6 +419,10 @@ void CAdvancedSettings::Initialize()
   m_videoAssFixedWorks = false;
 
   m_logLevelHint = m_logLevel = LOG_LEVEL_NORMAL;
+  m_logAsync = false;
+  m_logAsyncDropOnOverflow = false;
+  m_logRotateSize = 0;
+  m_logRotateAge = 0;
 
   m_openGlDebugging = false;
 
@@ -797,6 +804,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "panamount", m_slideshowPanAmount, 0.0f, 20.0f);
     XMLUtils::GetFloat(pElement, "zoomamount", m_slideshowZoomAmount, 0.0f, 20.0f);
     XMLUtils::GetFloat(pElement, "blackbarcompensation", m_slideshowBlackBarCompensation, 0.0f, 50.0f);
+    XMLUtils::GetInt(pElement, "prefetchahead", m_slideshowPrefetchAhead, 0, 10);
+    XMLUtils::GetInt(pElement, "prefetchbehind", m_slideshowPrefetchBehind, 0, 10);
+    XMLUtils::GetInt(pElement, "prefetchmemory", m_slideshowPrefetchMemory, 16, 2048);
   }
 
   pElement = pRootElement->FirstChildElement("network");
@@ -859,6 +869,21 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     CServiceBroker::GetLogging().SetLogLevel(m_logLevel);
   }
 
+  pElement = pRootElement->FirstChildElement("logging");
+  if (pElement)
+  {
+    XMLUtils::GetBoolean(pElement, "async", m_logAsync);
+    std::string overflow;
+    if (XMLUtils::GetString(pElement, "asyncoverflow", overflow))
+      m_logAsyncDropOnOverflow = StringUtils::EqualsNoCase(overflow, "drop");
+    XMLUtils::GetUInt(pElement, "rotatesize", m_logRotateSize, 0, 4096);
+    XMLUtils::GetUInt(pElement, "rotateage", m_logRotateAge, 0, 7 * 24 * 60);
+
+    CServiceBroker::GetLogging().SetRotation(static_cast<size_t>(m_logRotateSize) * 1024 * 1024,
+                                             m_logRotateAge);
+    CServiceBroker::GetLogging().SetAsync(m_logAsync, m_logAsyncDropOnOverflow);
+  }
+
   XMLUtils::GetString(pRootElement, "cddbaddress", m_cddbAddress);
   XMLUtils::GetBoolean(pRootElement, "addsourceontop", m_addSourceOnTop);
 
@@ -179,10 +179,17 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_slideshowBlackBarCompensation;
     float m_slideshowZoomAmount;
     float m_slideshowPanAmount;
+    int m_slideshowPrefetchAhead;
+    int m_slideshowPrefetchBehind;
+    int m_slideshowPrefetchMemory; // MB
 
     int m_songInfoDuration;
     int m_logLevel;
     int m_logLevelHint;
+    bool m_logAsync;
+    bool m_logAsyncDropOnOverflow;
+    unsigned int m_logRotateSize; // MB
+    unsigned int m_logRotateAge; // minutes
     std::string m_cddbAddress;
     bool m_addSourceOnTop; //!< True to put 'add source' buttons on top
 
@@ -118,7 +118,7 @@ protected:
   SettingDependencies m_dependencies;
   std::set<CSettingUpdate> m_updates;
   bool m_changed = false;
-  mutable CSharedSection m_critical;
+  mutable CSharedSection m_critical{"CSetting"};
 
   std::string m_referencedId;
 };
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "settings/lib/ISettingCallback.h"
+#include "settings/lib/ISettingsHandler.h"
+#include "settings/lib/Setting.h"
+#include "settings/lib/SettingsManager.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+/*!
+ \ingroup settings
+ \brief Typed handle to the value of a boolean, integer or number setting.
+
+ The setting is looked up once on construction. Its value is kept in an atomic
+ which is updated whenever the setting changes or the settings are (re-)loaded,
+ so reading it neither searches the setting map nor takes any lock. Meant for
+ settings read on hot paths, e.g. per packet or per frame.
+
+ A handle must not outlive the settings manager it has been created with.
+
+ \sa CSettingBool, CSettingInt, CSettingNumber
+ */
+template<class TSetting>
+class CSettingHandle : public ISettingCallback, public ISettingsHandler
+{
+public:
+  typedef typename TSetting::Value Value;
+
+  CSettingHandle(CSettingsManager& settingsManager, const std::string& settingId)
+    : m_settingsManager(settingsManager)
+  {
+    const std::shared_ptr<CSetting> setting = m_settingsManager.GetSetting(settingId);
+    if (setting == nullptr || setting->GetType() != TSetting::Type())
+      return;
+
+    m_setting = std::static_pointer_cast<TSetting>(setting);
+
+    // register first so that no change between reading and registering is lost
+    m_settingsManager.RegisterCallback(this, {m_setting->GetId()});
+    m_settingsManager.RegisterSettingsHandler(this);
+    Refresh();
+  }
+
+  ~CSettingHandle() override
+  {
+    if (m_setting)
+    {
+      m_settingsManager.UnregisterSettingsHandler(this);
+      m_settingsManager.UnregisterCallback(this);
+    }
+  }
+
+  CSettingHandle(const CSettingHandle&) = delete;
+  CSettingHandle& operator=(const CSettingHandle&) = delete;
+
+  /*!
+   \brief Whether the setting exists and has the expected type. If not, Get()
+   returns a default constructed value.
+   */
+  bool IsValid() const { return m_setting != nullptr; }
+
+  Value Get() const { return m_value.load(std::memory_order_relaxed); }
+
+  // implementation of ISettingCallback
+  void OnSettingChanged(std::shared_ptr<const CSetting> setting) override
+  {
+    if (setting != nullptr && setting->GetType() == TSetting::Type())
+      m_value.store(std::static_pointer_cast<const TSetting>(setting)->GetValue(),
+                    std::memory_order_relaxed);
+  }
+
+  // implementation of ISettingsHandler, values change without notification while (un)loading
+  void OnSettingsLoaded() override { Refresh(); }
+  void OnSettingsUnloaded() override { Refresh(); }
+
+private:
+  void Refresh()
+  {
+    // store until stable, a concurrent change may have been notified in between
+    Value value = m_setting->GetValue();
+    m_value.store(value, std::memory_order_relaxed);
+    for (Value current = m_setting->GetValue(); current != value; current = m_setting->GetValue())
+    {
+      value = current;
+      m_value.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  CSettingsManager& m_settingsManager;
+  std::shared_ptr<TSetting> m_setting;
+  std::atomic<Value> m_value{Value()};
+};
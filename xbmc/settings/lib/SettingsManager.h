@@ -540,6 +540,6 @@ private:
   using SettingOptionsFillerMap = std::map<std::string, SettingOptionsFiller>;
   SettingOptionsFillerMap m_optionsFillers;
 
-  mutable CSharedSection m_critical;
-  mutable CSharedSection m_settingsCritical;
+  mutable CSharedSection m_critical{"CSettingsManager"};
+  mutable CSharedSection m_settingsCritical{"CSettingsManager.settings"};
 };
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "settings/lib/Setting.h"
+#include "settings/lib/SettingHandle.h"
+#include "settings/lib/SettingSection.h"
+#include "settings/lib/SettingsManager.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+class TestSettingHandle : public testing::Test
+{
+protected:
+  TestSettingHandle()
+  {
+    auto section = std::make_shared<CSettingSection>("section", &m_settingsManager);
+    auto category = std::make_shared<CSettingCategory>("category", &m_settingsManager);
+    auto group = std::make_shared<CSettingGroup>("group", &m_settingsManager);
+
+    m_settingsManager.AddSetting(std::make_shared<CSettingBool>("test.bool", 0, true, &m_settingsManager),
+                                 section, category, group);
+    m_settingsManager.AddSetting(std::make_shared<CSettingInt>("test.int", 0, 3, &m_settingsManager),
+                                 section, category, group);
+    m_settingsManager.AddSetting(
+        std::make_shared<CSettingNumber>("test.number", 0, 1.5, &m_settingsManager), section,
+        category, group);
+    m_settingsManager.SetInitialized();
+    m_settingsManager.SetLoaded();
+  }
+
+  ~TestSettingHandle() override { m_settingsManager.Clear(); }
+
+  CSettingsManager m_settingsManager;
+};
+
+TEST_F(TestSettingHandle, Values)
+{
+  CSettingHandle<CSettingBool> boolHandle(m_settingsManager, "test.bool");
+  CSettingHandle<CSettingInt> intHandle(m_settingsManager, "test.int");
+  CSettingHandle<CSettingNumber> numberHandle(m_settingsManager, "test.number");
+
+  ASSERT_TRUE(boolHandle.IsValid());
+  ASSERT_TRUE(intHandle.IsValid());
+  ASSERT_TRUE(numberHandle.IsValid());
+  EXPECT_TRUE(boolHandle.Get());
+  EXPECT_EQ(3, intHandle.Get());
+  EXPECT_DOUBLE_EQ(1.5, numberHandle.Get());
+
+  EXPECT_TRUE(m_settingsManager.SetBool("test.bool", false));
+  EXPECT_TRUE(m_settingsManager.SetInt("test.int", 7));
+  EXPECT_TRUE(m_settingsManager.SetNumber("test.number", 2.5));
+  EXPECT_FALSE(boolHandle.Get());
+  EXPECT_EQ(7, intHandle.Get());
+  EXPECT_DOUBLE_EQ(2.5, numberHandle.Get());
+
+  // unloading resets the values without notifying callbacks
+  m_settingsManager.Unload();
+  EXPECT_TRUE(boolHandle.Get());
+  EXPECT_EQ(3, intHandle.Get());
+  EXPECT_DOUBLE_EQ(1.5, numberHandle.Get());
+}
+
+TEST_F(TestSettingHandle, Invalid)
+{
+  CSettingHandle<CSettingBool> missing(m_settingsManager, "test.missing");
+  EXPECT_FALSE(missing.IsValid());
+  EXPECT_FALSE(missing.Get());
+
+  CSettingHandle<CSettingBool> wrongType(m_settingsManager, "test.int");
+  EXPECT_FALSE(wrongType.IsValid());
+}
+
+/*
+ * Compares the cost of reading a setting by its id and through a handle when
+ * KODI_BENCHMARK_SETTINGS is set. The numbers are only reported, timings depend too much on the
+ * machine to be asserted on.
+ */
+TEST_F(TestSettingHandle, LookupCost)
+{
+  if (!std::getenv("KODI_BENCHMARK_SETTINGS"))
+    GTEST_SKIP() << "KODI_BENCHMARK_SETTINGS not set";
+
+  constexpr int lookups = 1000000;
+  CSettingHandle<CSettingBool> handle(m_settingsManager, "test.bool");
+
+  // volatile keeps the loops from being optimized away
+  volatile bool value = false;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < lookups; i++)
+    value = m_settingsManager.GetBool("test.bool");
+  const auto lookupCost = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count() /
+                          static_cast<double>(lookups);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < lookups; i++)
+    value = handle.Get();
+  const auto handleCost = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count() /
+                          static_cast<double>(lookups);
+  EXPECT_TRUE(value);
+
+  std::cout << "setting read cost: GetBool " << lookupCost << " ns, handle " << handleCost
+            << " ns" << std::endl;
+  RecordProperty("GetBoolNsPerCall", std::to_string(lookupCost));
+  RecordProperty("HandleNsPerCall", std::to_string(handleCost));
+}
@@ -11,4 +11,31 @@
 #include "platform/RecursiveMutex.h"
 #include "threads/Lockables.h"
 
-class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecursiveMutex> {};
+#ifdef HAS_LOCK_PROFILING
+#include "threads/LockProfiler.h"
+
+class CCriticalSection
+  : public XbmcThreads::CountingLockable<XbmcThreads::CProfiledMutex<XbmcThreads::CRecursiveMutex>>
+{
+public:
+  CCriticalSection() = default;
+
+  /**
+   * Sections of the same name share their lock profiling statistics.
+   */
+  explicit CCriticalSection(const char* name) { mutex.SetName(name); }
+
+  XbmcThreads::LockStats* GetProfilerStats() const { return mutex.GetStats(); }
+};
+#else
+class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecursiveMutex>
+{
+public:
+  CCriticalSection() = default;
+
+  /**
+   * The name is only used for lock profiling (HAS_LOCK_PROFILING).
+   */
+  explicit CCriticalSection(const char* /* name */) {}
+};
+#endif
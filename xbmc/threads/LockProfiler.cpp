@@ -0,0 +1,296 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LockProfiler.h"
+
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#if defined(TARGET_POSIX)
+#include <dlfcn.h>
+#endif
+
+using namespace XbmcThreads;
+
+namespace
+{
+
+void UpdateMax(std::atomic<uint64_t>& max, uint64_t value)
+{
+  uint64_t current = max.load(std::memory_order_relaxed);
+  while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    ;
+}
+
+double ToMs(uint64_t ns)
+{
+  return ns / 1000000.0;
+}
+
+std::string DescribeSite(const void* address)
+{
+#if defined(TARGET_POSIX)
+  // resolve with e.g. addr2line -f -e <module> <offset>
+  Dl_info info;
+  if (dladdr(address, &info) && info.dli_fname)
+  {
+    std::string module = info.dli_fname;
+    const size_t slash = module.rfind('/');
+    if (slash != std::string::npos)
+      module.erase(0, slash + 1);
+
+    const uintptr_t offset = reinterpret_cast<uintptr_t>(address) -
+                             reinterpret_cast<uintptr_t>(info.dli_fbase);
+    if (info.dli_sname)
+      return StringUtils::Format("{}+0x{:x} ({})", module, offset, info.dli_sname);
+    return StringUtils::Format("{}+0x{:x}", module, offset);
+  }
+#endif
+  return StringUtils::Format("{}", address);
+}
+
+} // unnamed namespace
+
+void LockStats::RecordAcquire(int64_t wait)
+{
+  acquisitions.fetch_add(1, std::memory_order_relaxed);
+  if (wait >= 0)
+    RecordWait(wait);
+}
+
+void LockStats::RecordWait(int64_t wait)
+{
+  contentions.fetch_add(1, std::memory_order_relaxed);
+  waitTotal.fetch_add(wait, std::memory_order_relaxed);
+  UpdateMax(waitMax, wait);
+  waitHistogram[GetBucket(wait)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LockStats::RecordHold(int64_t hold)
+{
+  holds.fetch_add(1, std::memory_order_relaxed);
+  holdTotal.fetch_add(hold, std::memory_order_relaxed);
+  UpdateMax(holdMax, hold);
+  holdHistogram[GetBucket(hold)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LockStats::Reset()
+{
+  acquisitions = 0;
+  contentions = 0;
+  waitTotal = 0;
+  waitMax = 0;
+  holds = 0;
+  holdTotal = 0;
+  holdMax = 0;
+  for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+  {
+    waitHistogram[i] = 0;
+    holdHistogram[i] = 0;
+  }
+}
+
+size_t LockStats::GetBucket(int64_t time)
+{
+  size_t bucket = 0;
+  for (int64_t us = time / 1000; us > 0 && bucket < HISTOGRAM_BUCKETS - 1; us >>= 1)
+    bucket++;
+  return bucket;
+}
+
+int64_t LockStats::GetPercentile(const std::atomic<uint64_t> (&histogram)[HISTOGRAM_BUCKETS],
+                                 double percentile)
+{
+  uint64_t total = 0;
+  for (const auto& bucket : histogram)
+    total += bucket;
+  if (total == 0)
+    return 0;
+
+  const uint64_t rank = static_cast<uint64_t>(total * percentile);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+  {
+    seen += histogram[i];
+    if (seen > rank)
+      return (INT64_C(1) << i) * 1000;
+  }
+  return (INT64_C(1) << (HISTOGRAM_BUCKETS - 1)) * 1000;
+}
+
+std::atomic<bool> CLockProfiler::m_enabled{false};
+
+CLockProfiler::CLockProfiler() : m_sites(new Site[SITES])
+{
+}
+
+CLockProfiler& CLockProfiler::GetInstance()
+{
+  // never destroyed, static locks may still be used during shutdown
+  static CLockProfiler* profiler = new CLockProfiler;
+  return *profiler;
+}
+
+int64_t CLockProfiler::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void CLockProfiler::Start()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_locksMutex);
+    for (auto& lockStats : m_locks)
+      lockStats.second->Reset();
+  }
+  m_unnamed.Reset();
+  for (size_t i = 0; i < SITES; i++)
+    m_sites[i].stats.Reset();
+
+  m_enabled = true;
+}
+
+void CLockProfiler::Stop()
+{
+  m_enabled = false;
+}
+
+LockStats* CLockProfiler::GetLockStats(const char* name)
+{
+  if (!name || !*name)
+    return &m_unnamed;
+
+  std::lock_guard<std::mutex> lock(m_locksMutex);
+  auto& lockStats = m_locks[name];
+  if (!lockStats)
+    lockStats.reset(new LockStats(name));
+  return lockStats.get();
+}
+
+const LockStats* CLockProfiler::FindLockStats(const std::string& name) const
+{
+  std::lock_guard<std::mutex> lock(m_locksMutex);
+  const auto it = m_locks.find(name);
+  return it != m_locks.end() ? it->second.get() : nullptr;
+}
+
+LockStats* CLockProfiler::RecordAcquire(LockStats* lock, const void* site, int64_t wait)
+{
+  if (!lock)
+    lock = &m_unnamed;
+  lock->RecordAcquire(wait);
+
+  LockStats* siteStats = GetSiteStats(site, lock);
+  if (siteStats)
+    siteStats->RecordAcquire(wait);
+  return siteStats;
+}
+
+void CLockProfiler::RecordRelease(LockStats* lock, LockStats* site, int64_t hold)
+{
+  if (!lock)
+    lock = &m_unnamed;
+  lock->RecordHold(hold);
+
+  if (site)
+    site->RecordHold(hold);
+}
+
+void CLockProfiler::RecordWait(LockStats* lock, int64_t wait)
+{
+  if (!lock)
+    lock = &m_unnamed;
+  lock->RecordWait(wait);
+}
+
+LockStats* CLockProfiler::GetSiteStats(const void* address, const LockStats* lock)
+{
+  if (!address)
+    return nullptr;
+
+  // open addressing, slots are claimed once and never released
+  size_t slot = (reinterpret_cast<uintptr_t>(address) >> 2) % SITES;
+  for (size_t probe = 0; probe < SITES; probe++, slot = (slot + 1) % SITES)
+  {
+    Site& site = m_sites[slot];
+    const void* current = site.address.load(std::memory_order_acquire);
+    if (!current)
+    {
+      if (site.address.compare_exchange_strong(current, address, std::memory_order_acq_rel))
+      {
+        site.lock = lock;
+        return &site.stats;
+      }
+    }
+    if (current == address)
+      return &site.stats;
+  }
+
+  // table is full, the lock statistics still have it
+  return nullptr;
+}
+
+std::string CLockProfiler::GetReport(size_t count) const
+{
+  struct Entry
+  {
+    std::string name;
+    const LockStats* stats;
+  };
+
+  std::vector<Entry> locks;
+  {
+    std::lock_guard<std::mutex> lock(m_locksMutex);
+    for (const auto& lockStats : m_locks)
+      locks.push_back({lockStats.first, lockStats.second.get()});
+  }
+  locks.push_back({m_unnamed.name, &m_unnamed});
+
+  std::vector<Entry> sites;
+  for (size_t i = 0; i < SITES; i++)
+  {
+    const Site& site = m_sites[i];
+    const void* address = site.address.load(std::memory_order_acquire);
+    const LockStats* lock = site.lock.load();
+    if (address && site.stats.acquisitions > 0)
+      sites.push_back({DescribeSite(address) + " [" + (lock ? lock->name : "?") + "]", &site.stats});
+  }
+
+  const auto byWait = [](const Entry& a, const Entry& b) {
+    return a.stats->waitTotal > b.stats->waitTotal;
+  };
+  std::sort(locks.begin(), locks.end(), byWait);
+  std::sort(sites.begin(), sites.end(), byWait);
+
+  const auto format = [](const Entry& entry) {
+    const LockStats& stats = *entry.stats;
+    return StringUtils::Format(
+        "  {}: acquired {}, contended {}, wait total {:.3f} ms p50 <{:.3f} ms p99 <{:.3f} ms max "
+        "{:.3f} ms, hold total {:.3f} ms p99 <{:.3f} ms max {:.3f} ms\n",
+        entry.name, stats.acquisitions.load(), stats.contentions.load(), ToMs(stats.waitTotal),
+        ToMs(LockStats::GetPercentile(stats.waitHistogram, 0.5)),
+        ToMs(LockStats::GetPercentile(stats.waitHistogram, 0.99)), ToMs(stats.waitMax),
+        ToMs(stats.holdTotal), ToMs(LockStats::GetPercentile(stats.holdHistogram, 0.99)),
+        ToMs(stats.holdMax));
+  };
+
+  std::string report = "Locks by total wait time:\n";
+  for (size_t i = 0; i < locks.size() && i < count; i++)
+    report += format(locks[i]);
+
+  report += "Call sites by total wait time:\n";
+  for (size_t i = 0; i < sites.size() && i < count; i++)
+    report += format(sites[i]);
+
+  return report;
+}
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LOCK_PROFILER_NOINLINE __declspec(noinline)
+#define LOCK_PROFILER_CALLER _ReturnAddress()
+#else
+#define LOCK_PROFILER_NOINLINE __attribute__((noinline))
+#define LOCK_PROFILER_CALLER __builtin_return_address(0)
+#endif
+
+namespace XbmcThreads
+{
+
+/**
+ * Wait and hold times of a lock or of one call site, all times in nanoseconds.
+ *
+ * The histograms have power of two buckets in microseconds: bucket 0 counts
+ * times below 1us, bucket n times in [2^(n-1), 2^n) us and the last bucket
+ * everything above.
+ */
+struct LockStats
+{
+  static constexpr size_t HISTOGRAM_BUCKETS = 24;
+
+  explicit LockStats(const std::string& lockName = "") : name(lockName) {}
+
+  void RecordAcquire(int64_t wait);
+  void RecordWait(int64_t wait);
+  void RecordHold(int64_t hold);
+  void Reset();
+
+  static size_t GetBucket(int64_t time);
+
+  /**
+   * Upper bound of the bucket containing the given percentile, in nanoseconds.
+   */
+  static int64_t GetPercentile(const std::atomic<uint64_t> (&histogram)[HISTOGRAM_BUCKETS],
+                               double percentile);
+
+  const std::string name;
+  std::atomic<uint64_t> acquisitions{0};
+  std::atomic<uint64_t> contentions{0};
+  std::atomic<uint64_t> waitTotal{0};
+  std::atomic<uint64_t> waitMax{0};
+  std::atomic<uint64_t> holds{0};
+  std::atomic<uint64_t> holdTotal{0};
+  std::atomic<uint64_t> holdMax{0};
+  std::atomic<uint64_t> waitHistogram[HISTOGRAM_BUCKETS] = {};
+  std::atomic<uint64_t> holdHistogram[HISTOGRAM_BUCKETS] = {};
+};
+
+/**
+ * Collects wait and hold times of all profiled locks, per lock name and per
+ * call site. Only compiled into the locks with HAS_LOCK_PROFILING, and even
+ * then nothing is recorded until Start() is called.
+ *
+ * Call sites are the return addresses of the lock() calls. They are only
+ * meaningful in optimized builds, where the lock guards are inlined into the
+ * code taking the lock.
+ */
+class CLockProfiler
+{
+public:
+  static CLockProfiler& GetInstance();
+
+  static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+  static int64_t Now();
+
+  /**
+   * Reset all statistics and start recording.
+   */
+  void Start();
+  void Stop();
+
+  /**
+   * Human readable report of the count locks and call sites with the longest
+   * total wait time.
+   */
+  std::string GetReport(size_t count) const;
+
+  /**
+   * Statistics shared by all locks of the given name. Locks without a name
+   * are accounted to a common "unnamed" entry.
+   */
+  LockStats* GetLockStats(const char* name);
+  const LockStats* FindLockStats(const std::string& name) const;
+
+  /**
+   * \return the statistics of the call site, to be passed to RecordRelease()
+   */
+  LockStats* RecordAcquire(LockStats* lock, const void* site, int64_t wait);
+  void RecordRelease(LockStats* lock, LockStats* site, int64_t hold);
+
+  /**
+   * Contention not spent in the mutex itself, e.g. a writer waiting for the
+   * readers of a shared section.
+   */
+  void RecordWait(LockStats* lock, int64_t wait);
+
+private:
+  CLockProfiler();
+
+  struct Site
+  {
+    std::atomic<const void*> address{nullptr};
+    std::atomic<const LockStats*> lock{nullptr};
+    LockStats stats;
+  };
+  static constexpr size_t SITES = 1024;
+
+  LockStats* GetSiteStats(const void* address, const LockStats* lock);
+
+  static std::atomic<bool> m_enabled;
+
+  mutable std::mutex m_locksMutex;
+  std::map<std::string, std::unique_ptr<LockStats>> m_locks;
+  LockStats m_unnamed{"unnamed"};
+  std::unique_ptr<Site[]> m_sites;
+};
+
+/**
+ * Wraps a recursive mutex and records how long it is waited for and held.
+ *
+ * Recursive acquisitions are not recorded, the hold time is measured from
+ * the outermost lock() to the matching unlock(). Condition variables waiting
+ * on the mutex release it, which ends the hold.
+ */
+template<class L>
+class CProfiledMutex
+{
+public:
+  CProfiledMutex() = default;
+  CProfiledMutex(const CProfiledMutex&) = delete;
+  CProfiledMutex& operator=(const CProfiledMutex&) = delete;
+
+  void SetName(const char* name) { m_stats = CLockProfiler::GetInstance().GetLockStats(name); }
+  LockStats* GetStats() const { return m_stats; }
+
+  inline void lock()
+  {
+    if (CLockProfiler::IsEnabled())
+      ProfiledLock();
+    else
+    {
+      m_mutex.lock();
+      m_depth++;
+    }
+  }
+
+  inline bool try_lock()
+  {
+    if (CLockProfiler::IsEnabled())
+      return ProfiledTryLock();
+
+    if (!m_mutex.try_lock())
+      return false;
+    m_depth++;
+    return true;
+  }
+
+  inline void unlock()
+  {
+    // only the owner touches the depth and hold start, they're read before releasing
+    if (--m_depth == 0 && m_holdStart != 0)
+      EndHold();
+    m_mutex.unlock();
+  }
+
+private:
+  LOCK_PROFILER_NOINLINE void ProfiledLock()
+  {
+    const void* site = LOCK_PROFILER_CALLER;
+    int64_t wait = -1;
+    if (!m_mutex.try_lock())
+    {
+      const int64_t start = CLockProfiler::Now();
+      m_mutex.lock();
+      wait = CLockProfiler::Now() - start;
+    }
+
+    if (++m_depth == 1)
+      BeginHold(site, wait);
+  }
+
+  LOCK_PROFILER_NOINLINE bool ProfiledTryLock()
+  {
+    const void* site = LOCK_PROFILER_CALLER;
+    if (!m_mutex.try_lock())
+      return false;
+
+    if (++m_depth == 1)
+      BeginHold(site, -1);
+    return true;
+  }
+
+  void BeginHold(const void* site, int64_t wait)
+  {
+    m_site = CLockProfiler::GetInstance().RecordAcquire(m_stats, site, wait);
+    m_holdStart = CLockProfiler::Now();
+  }
+
+  void EndHold()
+  {
+    CLockProfiler::GetInstance().RecordRelease(m_stats, m_site, CLockProfiler::Now() - m_holdStart);
+    m_holdStart = 0;
+  }
+
+  L m_mutex;
+  LockStats* m_stats = nullptr;
+  LockStats* m_site = nullptr;
+  unsigned int m_depth = 0;
+  int64_t m_holdStart = 0;
+};
+
+}
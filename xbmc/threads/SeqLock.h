@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace XbmcThreads
+{
+
+/*!
+ * \brief A sequence lock protecting a trivially copyable value.
+ *
+ * Writers must be serialized externally (e.g. by a CCriticalSection). Readers never block
+ * and never take a lock: they copy the value and retry if a write happened concurrently,
+ * so they always observe one consistent generation of the data.
+ *
+ * The payload is stored as relaxed atomic words so concurrent reads and writes are well
+ * defined; the sequence counter orders them.
+ */
+template<typename T>
+class CSeqLock
+{
+  static_assert(std::is_trivially_copyable<T>::value, "CSeqLock requires a trivially copyable type");
+
+public:
+  CSeqLock() { Store(T{}); }
+  explicit CSeqLock(const T& value) { Store(value); }
+
+  CSeqLock(const CSeqLock&) = delete;
+  CSeqLock& operator=(const CSeqLock&) = delete;
+
+  /*!
+   * \brief Publish a new value. Callers must not publish concurrently.
+   */
+  void Publish(const T& value)
+  {
+    const uint32_t seq = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Store(value);
+    m_sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  /*!
+   * \brief Get a consistent copy of the last published value.
+   */
+  T Read() const
+  {
+    T value;
+    uint32_t before;
+    uint32_t after;
+    do
+    {
+      before = m_sequence.load(std::memory_order_acquire);
+      while (before & 1)
+        before = m_sequence.load(std::memory_order_acquire);
+
+      Load(value);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = m_sequence.load(std::memory_order_relaxed);
+    } while (before != after);
+
+    return value;
+  }
+
+  /*!
+   * \brief Number of completed publications. Changes whenever the value changes.
+   */
+  uint32_t Generation() const { return m_sequence.load(std::memory_order_acquire) >> 1; }
+
+private:
+  static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  void Store(const T& value)
+  {
+    uint64_t words[WORDS] = {};
+    std::memcpy(words, &value, sizeof(T));
+    for (size_t i = 0; i < WORDS; i++)
+      m_data[i].store(words[i], std::memory_order_relaxed);
+  }
+
+  void Load(T& value) const
+  {
+    uint64_t words[WORDS];
+    for (size_t i = 0; i < WORDS; i++)
+      words[i] = m_data[i].load(std::memory_order_relaxed);
+    std::memcpy(&value, words, sizeof(T));
+  }
+
+  std::atomic<uint32_t> m_sequence{0};
+  std::array<std::atomic<uint64_t>, WORDS> m_data;
+};
+
+}
@@ -26,7 +26,27 @@ class CSharedSection
 public:
   inline CSharedSection() : cond(actualCv,XbmcThreads::InversePredicate<unsigned int&>(sharedCount)) {}
 
-  inline void lock() { CSingleLock l(sec); while (sharedCount) cond.wait(l); sec.lock(); }
+  /**
+   * The name is only used for lock profiling (HAS_LOCK_PROFILING).
+   */
+  inline explicit CSharedSection(const char* name) : sec(name), cond(actualCv,XbmcThreads::InversePredicate<unsigned int&>(sharedCount)) {}
+
+  inline void lock()
+  {
+    CSingleLock l(sec);
+#ifdef HAS_LOCK_PROFILING
+    // a writer waiting for the readers doesn't wait for the mutex, account it separately
+    if (sharedCount && XbmcThreads::CLockProfiler::IsEnabled())
+    {
+      const int64_t start = XbmcThreads::CLockProfiler::Now();
+      while (sharedCount) cond.wait(l);
+      XbmcThreads::CLockProfiler::GetInstance().RecordWait(sec.GetProfilerStats(),
+                                                           XbmcThreads::CLockProfiler::Now() - start);
+    }
+#endif
+    while (sharedCount) cond.wait(l);
+    sec.lock();
+  }
   inline bool try_lock() { return (sec.try_lock() ? ((sharedCount == 0) ? true : (sec.unlock(), false)) : false); }
   inline void unlock() { sec.unlock(); }
 
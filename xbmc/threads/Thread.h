@@ -67,6 +67,7 @@ public:
   // -----------------------------------------------------------------------------------
 
   static CThread* GetCurrentThread();
+  const std::string& GetName() const { return m_ThreadName; }
 
   virtual void OnException(){} // signal termination handler
 
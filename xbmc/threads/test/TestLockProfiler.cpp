@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/LockProfiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace XbmcThreads;
+
+TEST(TestLockProfiler, Buckets)
+{
+  EXPECT_EQ(0u, LockStats::GetBucket(0));
+  EXPECT_EQ(0u, LockStats::GetBucket(999));
+  EXPECT_EQ(1u, LockStats::GetBucket(1000));
+  EXPECT_EQ(2u, LockStats::GetBucket(2000));
+  EXPECT_EQ(2u, LockStats::GetBucket(3999));
+  EXPECT_EQ(LockStats::HISTOGRAM_BUCKETS - 1, LockStats::GetBucket(INT64_C(1) << 60));
+
+  LockStats stats;
+  for (int i = 0; i < 99; i++)
+    stats.RecordHold(500);
+  stats.RecordHold(5000000);
+  EXPECT_EQ(1000, LockStats::GetPercentile(stats.holdHistogram, 0.5));
+  EXPECT_LE(5000000, LockStats::GetPercentile(stats.holdHistogram, 0.999));
+  EXPECT_EQ(5000000u, stats.holdMax);
+}
+
+TEST(TestLockProfiler, Recursion)
+{
+  CProfiledMutex<std::recursive_mutex> mutex;
+  mutex.SetName("TestLockProfiler.Recursion");
+
+  CLockProfiler& profiler = CLockProfiler::GetInstance();
+  profiler.Start();
+  mutex.lock();
+  mutex.lock();
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+  mutex.unlock();
+  mutex.unlock();
+  profiler.Stop();
+
+  const LockStats* stats = profiler.FindLockStats("TestLockProfiler.Recursion");
+  ASSERT_NE(nullptr, stats);
+  EXPECT_EQ(1u, stats->acquisitions);
+  EXPECT_EQ(0u, stats->contentions);
+  EXPECT_EQ(1u, stats->holds);
+}
+
+TEST(TestLockProfiler, Contention)
+{
+  CProfiledMutex<std::recursive_mutex> mutex;
+  mutex.SetName("TestLockProfiler.Contention");
+
+  CLockProfiler& profiler = CLockProfiler::GetInstance();
+  profiler.Start();
+
+  std::atomic<bool> locked{false};
+  std::thread holder([&mutex, &locked]() {
+    mutex.lock();
+    locked = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    mutex.unlock();
+  });
+  while (!locked)
+    std::this_thread::yield();
+
+  mutex.lock();
+  mutex.unlock();
+  holder.join();
+  profiler.Stop();
+
+  const LockStats* stats = profiler.FindLockStats("TestLockProfiler.Contention");
+  ASSERT_NE(nullptr, stats);
+  EXPECT_EQ(2u, stats->acquisitions);
+  EXPECT_EQ(1u, stats->contentions);
+  EXPECT_LE(10000000u, stats->waitMax);
+  EXPECT_LE(40000000u, stats->holdMax);
+  EXPECT_NE(std::string::npos, profiler.GetReport(100).find("TestLockProfiler.Contention"));
+
+  // nothing is recorded once stopped
+  mutex.lock();
+  mutex.unlock();
+  EXPECT_EQ(2u, stats->acquisitions);
+}
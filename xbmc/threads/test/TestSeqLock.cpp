@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/SeqLock.h"
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct SeqLockTestData
+{
+  int64_t first;
+  int64_t second;
+  float third;
+  bool fourth;
+};
+}
+
+TEST(TestSeqLock, PublishAndRead)
+{
+  XbmcThreads::CSeqLock<SeqLockTestData> lock;
+
+  SeqLockTestData data = lock.Read();
+  EXPECT_EQ(0, data.first);
+  EXPECT_EQ(0u, lock.Generation());
+
+  lock.Publish({1, 2, 3.0f, true});
+  data = lock.Read();
+  EXPECT_EQ(1, data.first);
+  EXPECT_EQ(2, data.second);
+  EXPECT_EQ(3.0f, data.third);
+  EXPECT_TRUE(data.fourth);
+  EXPECT_EQ(1u, lock.Generation());
+}
+
+TEST(TestSeqLock, ConcurrentReadersSeeConsistentData)
+{
+  XbmcThreads::CSeqLock<SeqLockTestData> lock;
+  std::atomic<bool> stop{false};
+  std::atomic<int> torn{0};
+
+  lock.Publish({0, 0, 0.0f, true});
+
+  auto reader = [&]()
+  {
+    while (!stop)
+    {
+      const SeqLockTestData data = lock.Read();
+      if (data.second != -data.first || data.fourth != (data.first % 2 == 0))
+        ++torn;
+    }
+  };
+
+  std::thread reader1(reader);
+  std::thread reader2(reader);
+
+  for (int64_t i = 1; i < 200000; i++)
+    lock.Publish({i, -i, static_cast<float>(i), i % 2 == 0});
+
+  stop = true;
+  reader1.join();
+  reader2.join();
+
+  EXPECT_EQ(0, torn);
+  EXPECT_EQ(199999, lock.Read().first);
+}
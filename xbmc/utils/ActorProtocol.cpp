@@ -8,22 +8,51 @@
 
 #include "ActorProtocol.h"
 
-#include "threads/Event.h"
+#include "threads/SingleLock.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace Actor;
 
-void Message::Release()
+namespace
 {
-  bool skip;
-  origin.Lock();
-  skip = isSync ? !isSyncFini : false;
-  isSyncFini = true;
-  origin.Unlock();
 
-  if (skip)
-    return;
+constexpr uint64_t MakeFreeHead(uint64_t generation, uint32_t index)
+{
+  return (generation << 32) | index;
+}
+
+constexpr uint32_t GetFreeIndex(uint64_t head)
+{
+  return static_cast<uint32_t>(head);
+}
+
+constexpr uint64_t GetFreeGeneration(uint64_t head)
+{
+  return head >> 32;
+}
+
+} // unnamed namespace
+
+constexpr size_t Message::MSG_INTERNAL_BUFFER_SIZE;
+constexpr uint32_t Message::NO_ARENA_INDEX;
+constexpr uint32_t Protocol::ARENA_SIZE;
+
+void Message::Release()
+{
+  if (isSync)
+  {
+    // sender and receiver both release a sync message, the last one frees it
+    bool skip;
+    origin.Lock();
+    skip = !isSyncFini;
+    isSyncFini = true;
+    origin.Unlock();
+
+    if (skip)
+      return;
+  }
 
   // free data buffer
   if (data != buffer)
@@ -31,8 +60,7 @@ void Message::Release()
 
   payloadObj.reset();
 
-  // delete event in case of sync message
-  delete event;
+  event = nullptr;
 
   origin.ReturnMessage(this);
 }
@@ -54,15 +82,8 @@ bool Message::Reply(int sig, void *data /* = NULL*/, size_t size /* = 0 */)
     Message *msg = origin.GetMessage();
     msg->signal = sig;
     msg->isOut = !isOut;
+    msg->SetData(data, size);
     replyMessage = msg;
-    if (data)
-    {
-      if (size > sizeof(msg->buffer))
-        msg->data = new uint8_t[size];
-      else
-        msg->data = msg->buffer;
-      memcpy(msg->data, data, size);
-    }
   }
 
   origin.Unlock();
@@ -73,48 +94,165 @@ bool Message::Reply(int sig, void *data /* = NULL*/, size_t size /* = 0 */)
   return true;
 }
 
-Protocol::~Protocol()
+void Message::SetData(const void* data, size_t size)
 {
-  Message *msg;
-  Purge();
-  while (!freeMessageQueue.empty())
+  if (!data)
+    return;
+
+  if (size > sizeof(buffer))
+    this->data = new uint8_t[size];
+  else
+    this->data = buffer;
+  memcpy(this->data, data, size);
+  payloadSize = size;
+}
+
+void MessageQueue::Push(Message* msg)
+{
+  msg->nextMessage.store(nullptr, std::memory_order_relaxed);
+  Message* prev = m_head.exchange(msg, std::memory_order_acq_rel);
+  // until linked here, the message and any pushed after it are invisible to the receiver
+  prev->nextMessage.store(msg, std::memory_order_release);
+}
+
+bool MessageQueue::Pop(Message** msg)
+{
+  CSingleLock lock(m_receiveSection);
+
+  if (!m_pending.empty())
   {
-    msg = freeMessageQueue.front();
-    freeMessageQueue.pop();
-    delete msg;
+    *msg = m_pending.front();
+    m_pending.pop_front();
+    return true;
   }
+
+  *msg = PopQueued();
+  return *msg != nullptr;
 }
 
-Message *Protocol::GetMessage()
+std::vector<Message*> MessageQueue::Remove(int signal)
 {
-  Message *msg;
+  std::vector<Message*> removed;
 
-  CSingleLock lock(criticalSection);
+  CSingleLock lock(m_receiveSection);
+
+  for (Message* msg = PopQueued(); msg; msg = PopQueued())
+    m_pending.push_back(msg);
+
+  auto it = std::stable_partition(m_pending.begin(), m_pending.end(),
+                                  [signal](const Message* msg) { return msg->signal != signal; });
+  removed.assign(it, m_pending.end());
+  m_pending.erase(it, m_pending.end());
+
+  return removed;
+}
 
-  if (!freeMessageQueue.empty())
+Message* MessageQueue::PopQueued()
+{
+  Message* tail = m_tail;
+  Message* next = tail->nextMessage.load(std::memory_order_acquire);
+
+  if (tail == &m_stub)
   {
-    msg = freeMessageQueue.front();
-    freeMessageQueue.pop();
+    if (!next)
+      return nullptr;
+    m_tail = next;
+    tail = next;
+    next = next->nextMessage.load(std::memory_order_acquire);
   }
-  else
+
+  if (next)
+  {
+    m_tail = next;
+    return tail;
+  }
+
+  // a sender is in the middle of pushing, its container event follows
+  if (tail != m_head.load(std::memory_order_acquire))
+    return nullptr;
+
+  // tail is the last message, put the stub behind it so it can be taken
+  Push(&m_stub);
+  next = tail->nextMessage.load(std::memory_order_acquire);
+  if (next)
+  {
+    m_tail = next;
+    return tail;
+  }
+
+  return nullptr;
+}
+
+Protocol::Protocol(std::string name, CEvent* inEvent, CEvent* outEvent)
+  : portName(name),
+    containerInEvent(inEvent),
+    containerOutEvent(outEvent),
+    outMessages(*this),
+    inMessages(*this)
+{
+  for (uint32_t i = 0; i < ARENA_SIZE; i++)
+  {
+    arena[i].reset(new Message(*this, i));
+    arena[i]->nextFree.store(i + 1 < ARENA_SIZE ? i + 1 : Message::NO_ARENA_INDEX,
+                             std::memory_order_relaxed);
+  }
+  freeHead.store(MakeFreeHead(0, 0), std::memory_order_release);
+}
+
+Protocol::~Protocol()
+{
+  Purge();
+}
+
+Message *Protocol::GetMessage()
+{
+  Message *msg = nullptr;
+
+  uint64_t head = freeHead.load(std::memory_order_acquire);
+  while (GetFreeIndex(head) != Message::NO_ARENA_INDEX)
+  {
+    Message* first = arena[GetFreeIndex(head)].get();
+    // the generation guards against the first message having been taken and returned meanwhile
+    const uint64_t next =
+        MakeFreeHead(GetFreeGeneration(head) + 1, first->nextFree.load(std::memory_order_relaxed));
+    if (freeHead.compare_exchange_weak(head, next, std::memory_order_acquire,
+                                       std::memory_order_acquire))
+    {
+      msg = first;
+      break;
+    }
+  }
+
+  // all messages of the arena are in use
+  if (!msg)
     msg = new Message(*this);
 
   msg->isSync = false;
   msg->isSyncFini = false;
   msg->isSyncTimeout = false;
-  msg->event = NULL;
-  msg->data = NULL;
+  msg->event = nullptr;
+  msg->data = nullptr;
   msg->payloadSize = 0;
-  msg->replyMessage = NULL;
+  msg->replyMessage = nullptr;
 
   return msg;
 }
 
 void Protocol::ReturnMessage(Message *msg)
 {
-  CSingleLock lock(criticalSection);
+  if (msg->arenaIndex == Message::NO_ARENA_INDEX)
+  {
+    delete msg;
+    return;
+  }
 
-  freeMessageQueue.push(msg);
+  uint64_t head = freeHead.load(std::memory_order_relaxed);
+  do
+  {
+    msg->nextFree.store(GetFreeIndex(head), std::memory_order_relaxed);
+  } while (!freeHead.compare_exchange_weak(
+      head, MakeFreeHead(GetFreeGeneration(head) + 1, msg->arenaIndex), std::memory_order_release,
+      std::memory_order_relaxed));
 }
 
 bool Protocol::SendOutMessage(int signal,
@@ -130,19 +268,9 @@ bool Protocol::SendOutMessage(int signal,
 
   msg->signal = signal;
   msg->isOut = true;
+  msg->SetData(data, size);
 
-  if (data)
-  {
-    if (size > sizeof(msg->buffer))
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
-
-  { CSingleLock lock(criticalSection);
-    outMessages.push(msg);
-  }
+  outMessages.Push(msg);
   if (containerOutEvent)
     containerOutEvent->Set();
 
@@ -162,9 +290,7 @@ bool Protocol::SendOutMessage(int signal, CPayloadWrapBase *payload, Message *ou
 
   msg->payloadObj.reset(payload);
 
-  { CSingleLock lock(criticalSection);
-    outMessages.push(msg);
-  }
+  outMessages.Push(msg);
   if (containerOutEvent)
     containerOutEvent->Set();
 
@@ -184,19 +310,9 @@ bool Protocol::SendInMessage(int signal,
 
   msg->signal = signal;
   msg->isOut = false;
+  msg->SetData(data, size);
 
-  if (data)
-  {
-    if (size > sizeof(msg->data))
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
-
-  { CSingleLock lock(criticalSection);
-    inMessages.push(msg);
-  }
+  inMessages.Push(msg);
   if (containerInEvent)
     containerInEvent->Set();
 
@@ -216,9 +332,7 @@ bool Protocol::SendInMessage(int signal, CPayloadWrapBase *payload, Message *out
 
   msg->payloadObj.reset(payload);
 
-  { CSingleLock lock(criticalSection);
-    inMessages.push(msg);
-  }
+  inMessages.Push(msg);
   if (containerInEvent)
     containerInEvent->Set();
 
@@ -231,30 +345,11 @@ bool Protocol::SendOutMessageSync(
   Message *msg = GetMessage();
   msg->isOut = true;
   msg->isSync = true;
-  msg->event = new CEvent;
+  msg->event = &msg->syncEvent;
   msg->event->Reset();
   SendOutMessage(signal, data, size, msg);
 
-  if (!msg->event->WaitMSec(timeout))
-  {
-    const CSingleLock lock(criticalSection);
-    if (msg->replyMessage)
-      *retMsg = msg->replyMessage;
-    else
-    {
-      *retMsg = NULL;
-      msg->isSyncTimeout = true;
-    }
-  }
-  else
-    *retMsg = msg->replyMessage;
-
-  msg->Release();
-
-  if (*retMsg)
-    return true;
-  else
-    return false;
+  return WaitForReply(msg, retMsg, timeout);
 }
 
 bool Protocol::SendOutMessageSync(int signal, Message **retMsg, int timeout, CPayloadWrapBase *payload)
@@ -262,10 +357,15 @@ bool Protocol::SendOutMessageSync(int signal, Message **retMsg, int timeout, CPa
   Message *msg = GetMessage();
   msg->isOut = true;
   msg->isSync = true;
-  msg->event = new CEvent;
+  msg->event = &msg->syncEvent;
   msg->event->Reset();
   SendOutMessage(signal, payload, msg);
 
+  return WaitForReply(msg, retMsg, timeout);
+}
+
+bool Protocol::WaitForReply(Message* msg, Message** retMsg, int timeout)
+{
   if (!msg->event->WaitMSec(timeout))
   {
     const CSingleLock lock(criticalSection);
@@ -290,28 +390,18 @@ bool Protocol::SendOutMessageSync(int signal, Message **retMsg, int timeout, CPa
 
 bool Protocol::ReceiveOutMessage(Message **msg)
 {
-  CSingleLock lock(criticalSection);
-
-  if (outMessages.empty() || outDefered)
+  if (outDefered)
     return false;
 
-  *msg = outMessages.front();
-  outMessages.pop();
-
-  return true;
+  return outMessages.Pop(msg);
 }
 
 bool Protocol::ReceiveInMessage(Message **msg)
 {
-  CSingleLock lock(criticalSection);
-
-  if (inMessages.empty() || inDefered)
+  if (inDefered)
     return false;
 
-  *msg = inMessages.front();
-  inMessages.pop();
-
-  return true;
+  return inMessages.Pop(msg);
 }
 
 
@@ -328,44 +418,12 @@ void Protocol::Purge()
 
 void Protocol::PurgeIn(int signal)
 {
-  Message *msg;
-  std::queue<Message*> msgs;
-
-  CSingleLock lock(criticalSection);
-
-  while (!inMessages.empty())
-  {
-    msg = inMessages.front();
-    inMessages.pop();
-    if (msg->signal != signal)
-      msgs.push(msg);
-  }
-  while (!msgs.empty())
-  {
-    msg = msgs.front();
-    msgs.pop();
-    inMessages.push(msg);
-  }
+  for (Message* msg : inMessages.Remove(signal))
+    msg->Release();
 }
 
 void Protocol::PurgeOut(int signal)
 {
-  Message *msg;
-  std::queue<Message*> msgs;
-
-  CSingleLock lock(criticalSection);
-
-  while (!outMessages.empty())
-  {
-    msg = outMessages.front();
-    outMessages.pop();
-    if (msg->signal != signal)
-      msgs.push(msg);
-  }
-  while (!msgs.empty())
-  {
-    msg = msgs.front();
-    msgs.pop();
-    outMessages.push(msg);
-  }
+  for (Message* msg : outMessages.Remove(signal))
+    msg->Release();
 }
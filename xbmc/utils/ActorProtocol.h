@@ -9,13 +9,15 @@
 #pragma once
 
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
-#include <queue>
 #include <string>
-
-class CEvent;
+#include <vector>
 
 namespace Actor
 {
@@ -43,8 +45,10 @@ class Protocol;
 class Message
 {
   friend class Protocol;
+  friend class MessageQueue;
 
-  static constexpr size_t MSG_INTERNAL_BUFFER_SIZE = 32;
+  static constexpr size_t MSG_INTERNAL_BUFFER_SIZE = 64;
+  static constexpr uint32_t NO_ARENA_INDEX = UINT32_MAX;
 
 public:
   int signal;
@@ -64,15 +68,56 @@ public:
   bool Reply(int sig, void *data = nullptr, size_t size = 0);
 
 private:
-  explicit Message(Protocol &_origin) noexcept
-    :origin(_origin) {}
+  explicit Message(Protocol &_origin, uint32_t _arenaIndex = NO_ARENA_INDEX) noexcept
+    :origin(_origin), arenaIndex(_arenaIndex) {}
+
+  void SetData(const void* data, size_t size);
+
+  std::atomic<Message*> nextMessage{nullptr}; // next message in a queue
+  std::atomic<uint32_t> nextFree{NO_ARENA_INDEX}; // next free message of the arena
+  const uint32_t arenaIndex;
+  CEvent syncEvent;
 };
 
+/*!
+ * \brief Queue of messages with any number of senders and one receiver at a time.
+ *
+ * Pushing is lock-free (an intrusive list after D. Vyukov). Receivers are serialized by a lock,
+ * which isn't contended as long as only the thread of the actor receives.
+ */
+class MessageQueue
+{
+public:
+  explicit MessageQueue(Protocol& origin) : m_stub(origin), m_head(&m_stub), m_tail(&m_stub) {}
+
+  void Push(Message* msg);
+  bool Pop(Message** msg);
+
+  /*!
+   * \brief Take all queued messages with the given signal out of the queue.
+   */
+  std::vector<Message*> Remove(int signal);
+
+private:
+  Message* PopQueued();
+
+  Message m_stub;
+  std::atomic<Message*> m_head;
+  Message* m_tail;
+
+  CCriticalSection m_receiveSection;
+  std::deque<Message*> m_pending; // taken out of the list, but not received yet
+};
+
+/*!
+ * \brief Messages are taken from an arena of preallocated ones, with more being allocated while
+ * all of them are in use. Sending and receiving messages asynchronously doesn't lock, besides
+ * receivers of the same queue. Sync messages still lock to hand over the reply.
+ */
 class Protocol
 {
 public:
-  Protocol(std::string name, CEvent* inEvent, CEvent *outEvent)
-    :portName(name), containerInEvent(inEvent), containerOutEvent(outEvent) {}
+  Protocol(std::string name, CEvent* inEvent, CEvent *outEvent);
   Protocol(std::string name)
     : Protocol(name, nullptr, nullptr) {}
   ~Protocol();
@@ -102,13 +147,19 @@ public:
   void Unlock() {criticalSection.unlock();};
   std::string portName;
 
+  static constexpr uint32_t ARENA_SIZE = 64;
+
 protected:
+  bool WaitForReply(Message* msg, Message** retMsg, int timeout);
+
   CEvent *containerInEvent, *containerOutEvent;
   CCriticalSection criticalSection;
-  std::queue<Message*> outMessages;
-  std::queue<Message*> inMessages;
-  std::queue<Message*> freeMessageQueue;
-  bool inDefered = false, outDefered = false;
+  MessageQueue outMessages;
+  MessageQueue inMessages;
+  std::atomic<bool> inDefered{false}, outDefered{false};
+
+  std::unique_ptr<Message> arena[ARENA_SIZE];
+  std::atomic<uint64_t> freeHead; // generation << 32 | index of the first free message
 };
 
 }
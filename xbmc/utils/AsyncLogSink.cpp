@@ -0,0 +1,291 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AsyncLogSink.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <spdlog/details/log_msg.h>
+
+namespace
+{
+constexpr auto WriterInterval = std::chrono::milliseconds(50);
+
+std::atomic<uint64_t> g_nextSinkId{1};
+
+// the writer must never wait for itself, e.g. if the target sink reports an error
+thread_local bool g_isWriterThread = false;
+} // unnamed namespace
+
+bool CAsyncLogSink::Ring::Push(const spdlog::details::log_msg& msg,
+                               std::atomic<uint64_t>& sequence)
+{
+  const size_t h = head.load(std::memory_order_relaxed);
+  if (h - tail.load(std::memory_order_acquire) >= CAPACITY)
+    return false;
+
+  // the strings keep their capacity, so steady state logging does not allocate
+  Entry& entry = entries[h % CAPACITY];
+  entry.sequence = sequence++;
+  entry.level = msg.level;
+  entry.time = msg.time;
+  entry.threadId = msg.thread_id;
+  entry.loggerName.assign(msg.logger_name.data(), msg.logger_name.size());
+  entry.payload.assign(msg.payload.data(), msg.payload.size());
+
+  head.store(h + 1, std::memory_order_release);
+  return true;
+}
+
+bool CAsyncLogSink::Ring::Pop(Entry& entry)
+{
+  const size_t t = tail.load(std::memory_order_relaxed);
+  if (t == head.load(std::memory_order_acquire))
+    return false;
+
+  std::swap(entry, entries[t % CAPACITY]);
+
+  tail.store(t + 1, std::memory_order_release);
+  return true;
+}
+
+bool CAsyncLogSink::Ring::Empty() const
+{
+  return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+}
+
+CAsyncLogSink::CAsyncLogSink(std::shared_ptr<spdlog::sinks::sink> target)
+  : m_target(std::move(target)), m_id(g_nextSinkId++)
+{
+}
+
+CAsyncLogSink::~CAsyncLogSink()
+{
+  if (m_async)
+    Stop();
+}
+
+void CAsyncLogSink::log(const spdlog::details::log_msg& msg)
+{
+  if (!m_async)
+  {
+    m_target->log(msg);
+    return;
+  }
+
+  m_producers++;
+  if (!m_async || g_isWriterThread)
+  {
+    // switched back to synchronous mode in the meantime
+    m_producers--;
+    m_target->log(msg);
+    return;
+  }
+
+  const std::shared_ptr<Ring> ring = GetThreadRing();
+  while (!ring->Push(msg, m_sequence))
+  {
+    if (m_policy == OverflowPolicy::DROP)
+    {
+      m_dropped++;
+      break;
+    }
+
+    m_wakeWriter.notify_one();
+    std::this_thread::yield();
+  }
+
+  const size_t queued = ring->head.load(std::memory_order_relaxed) -
+                        ring->tail.load(std::memory_order_relaxed);
+  if (queued > Ring::CAPACITY / 2)
+    m_wakeWriter.notify_one();
+
+  m_producers--;
+}
+
+void CAsyncLogSink::flush()
+{
+  // the writer flushes the target after every batch
+  if (!m_async)
+    m_target->flush();
+}
+
+void CAsyncLogSink::set_pattern(const std::string& pattern)
+{
+  m_target->set_pattern(pattern);
+}
+
+void CAsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter)
+{
+  m_target->set_formatter(std::move(sinkFormatter));
+}
+
+void CAsyncLogSink::SetAsync(bool async, OverflowPolicy policy)
+{
+  std::lock_guard<std::mutex> lock(m_switchMutex);
+
+  m_policy = policy;
+  if (async && !m_async)
+    Start();
+  else if (!async && m_async)
+    Stop();
+}
+
+void CAsyncLogSink::Drain()
+{
+  if (!m_async)
+  {
+    m_target->flush();
+    return;
+  }
+
+  const uint64_t queued = m_sequence;
+  std::unique_lock<std::mutex> lock(m_writerMutex);
+  m_wakeWriter.notify_one();
+  m_drained.wait(lock, [this, queued]() { return m_written >= queued || !m_async; });
+}
+
+std::shared_ptr<CAsyncLogSink::Ring> CAsyncLogSink::GetThreadRing()
+{
+  struct ThreadRing
+  {
+    ~ThreadRing()
+    {
+      if (ring)
+        ring->orphaned = true;
+    }
+
+    uint64_t sinkId = 0;
+    std::shared_ptr<Ring> ring;
+  };
+  static thread_local ThreadRing threadRing;
+
+  if (threadRing.sinkId != m_id)
+  {
+    if (threadRing.ring)
+      threadRing.ring->orphaned = true;
+
+    threadRing.ring = std::make_shared<Ring>();
+    threadRing.sinkId = m_id;
+
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    m_rings.emplace_back(threadRing.ring);
+  }
+
+  return threadRing.ring;
+}
+
+void CAsyncLogSink::Start()
+{
+  m_stop = false;
+  m_writer = std::thread(&CAsyncLogSink::Process, this);
+  m_async = true;
+}
+
+void CAsyncLogSink::Stop()
+{
+  m_async = false;
+
+  // wait for threads which are still queueing, the writer picks up their messages
+  while (m_producers > 0)
+    std::this_thread::yield();
+
+  {
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    m_stop = true;
+  }
+  m_wakeWriter.notify_one();
+  m_writer.join();
+
+  m_drained.notify_all();
+}
+
+void CAsyncLogSink::Process()
+{
+  g_isWriterThread = true;
+
+  std::vector<std::shared_ptr<Ring>> rings;
+  std::vector<Entry> batch;
+  uint64_t reportedDropped = m_dropped;
+
+  while (true)
+  {
+    bool stop;
+    {
+      std::unique_lock<std::mutex> lock(m_writerMutex);
+      if (!m_stop)
+        m_wakeWriter.wait_for(lock, WriterInterval);
+      stop = m_stop;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_ringsMutex);
+      rings = m_rings;
+
+      // forget the rings of threads which have exited once they are empty
+      m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                   [](const std::shared_ptr<Ring>& ring) {
+                                     return ring->orphaned && ring->Empty();
+                                   }),
+                    m_rings.end());
+    }
+
+    Entry entry;
+    for (const auto& ring : rings)
+    {
+      while (ring->Pop(entry))
+        batch.emplace_back(std::move(entry));
+    }
+    rings.clear();
+
+    // restore the order across threads
+    std::sort(batch.begin(), batch.end(),
+              [](const Entry& a, const Entry& b) { return a.sequence < b.sequence; });
+
+    for (const auto& queuedEntry : batch)
+      Write(queuedEntry);
+
+    const uint64_t dropped = m_dropped;
+    if (dropped != reportedDropped)
+    {
+      Entry warning;
+      warning.level = spdlog::level::warn;
+      warning.time = spdlog::log_clock::now();
+      warning.loggerName = "general";
+      warning.payload = "CAsyncLogSink: " + std::to_string(dropped - reportedDropped) +
+                        " log messages dropped, queue full";
+      Write(warning);
+      reportedDropped = dropped;
+    }
+
+    if (!batch.empty())
+      m_target->flush();
+
+    {
+      std::lock_guard<std::mutex> lock(m_writerMutex);
+      m_written += batch.size();
+    }
+    m_drained.notify_all();
+    batch.clear();
+
+    if (stop && m_written == m_sequence)
+      break;
+  }
+
+  g_isWriterThread = false;
+}
+
+void CAsyncLogSink::Write(const Entry& entry)
+{
+  spdlog::details::log_msg msg(spdlog::source_loc{}, entry.loggerName, entry.level,
+                               entry.payload);
+  msg.time = entry.time;
+  msg.thread_id = entry.threadId;
+  m_target->log(msg);
+}
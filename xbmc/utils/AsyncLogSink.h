@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/sinks/sink.h>
+
+/*!
+ * \brief Sink in front of all other log sinks that optionally moves writing off the calling thread.
+ *
+ * In synchronous mode messages are passed straight on to the target sink. In asynchronous mode
+ * every logging thread copies its messages into its own lock-free ring buffer and returns. A
+ * background writer collects the messages of all threads in order, formats them with the target's
+ * pattern and writes them out. If a thread's ring is full the message is either dropped and
+ * counted or the thread waits until the writer caught up.
+ */
+class CAsyncLogSink : public spdlog::sinks::sink
+{
+public:
+  enum class OverflowPolicy
+  {
+    BLOCK,
+    DROP
+  };
+
+  explicit CAsyncLogSink(std::shared_ptr<spdlog::sinks::sink> target);
+  ~CAsyncLogSink() override;
+
+  // implementation of spdlog::sinks::sink
+  void log(const spdlog::details::log_msg& msg) override;
+  void flush() override;
+  void set_pattern(const std::string& pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override;
+
+  /*!
+   * \brief Switch between synchronous and asynchronous writing. Pending messages are written
+   *        before switching back to synchronous mode.
+   */
+  void SetAsync(bool async, OverflowPolicy policy);
+  bool IsAsync() const { return m_async; }
+
+  /*!
+   * \brief Wait until all messages logged so far have been passed on to the target sink.
+   */
+  void Drain();
+
+  /*!
+   * \brief Number of messages dropped because a ring buffer was full.
+   */
+  uint64_t GetDroppedCount() const { return m_dropped; }
+
+private:
+  struct Entry
+  {
+    uint64_t sequence = 0;
+    spdlog::level::level_enum level = spdlog::level::info;
+    spdlog::log_clock::time_point time;
+    size_t threadId = 0;
+    std::string loggerName;
+    std::string payload;
+  };
+
+  // single producer (the logging thread), single consumer (the writer)
+  struct Ring
+  {
+    static constexpr size_t CAPACITY = 1024;
+
+    bool Push(const spdlog::details::log_msg& msg, std::atomic<uint64_t>& sequence);
+    bool Pop(Entry& entry);
+    bool Empty() const;
+
+    std::array<Entry, CAPACITY> entries;
+    std::atomic<size_t> head{0}; // written by the producer
+    std::atomic<size_t> tail{0}; // written by the consumer
+    std::atomic<bool> orphaned{false}; // producer thread has exited
+  };
+
+  std::shared_ptr<Ring> GetThreadRing();
+  void Start();
+  void Stop();
+  void Process();
+  void Write(const Entry& entry);
+
+  const std::shared_ptr<spdlog::sinks::sink> m_target;
+  const uint64_t m_id;
+
+  std::atomic<bool> m_async{false};
+  std::atomic<OverflowPolicy> m_policy{OverflowPolicy::DROP};
+  std::atomic<uint64_t> m_sequence{0}; // number of messages queued so far
+  std::atomic<uint64_t> m_written{0}; // number of queued messages passed on to the target
+  std::atomic<uint64_t> m_dropped{0};
+  std::atomic<int> m_producers{0}; // threads currently queueing a message
+
+  std::mutex m_ringsMutex;
+  std::vector<std::shared_ptr<Ring>> m_rings;
+
+  std::mutex m_writerMutex;
+  std::condition_variable m_wakeWriter;
+  std::condition_variable m_drained;
+  bool m_stop = false;
+  std::thread m_writer;
+  std::mutex m_switchMutex; // serializes SetAsync
+};
@@ -9,6 +9,7 @@
 #include "JobManager.h"
 
 #include "threads/SingleLock.h"
+#include "utils/TraceRecorder.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
@@ -52,6 +53,7 @@ void CJobWorker::Process()
     bool success = false;
     try
     {
+      TRACE_SCOPE("job", job->GetType());
       success = job->DoWork();
     }
     catch (...)
@@ -174,7 +174,7 @@ private:
 
   unsigned int m_jobsAtOnce;
   CJob::PRIORITY m_priority;
-  mutable CCriticalSection m_section;
+  mutable CCriticalSection m_section{"CJobQueue"};
   bool m_lifo;
 };
 
@@ -367,7 +367,7 @@ private:
   Processing m_processing;
   Workers    m_workers;
 
-  mutable CCriticalSection m_section;
+  mutable CCriticalSection m_section{"CJobManager"};
   CEvent           m_jobEvent;
   bool             m_running;
 };
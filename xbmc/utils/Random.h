@@ -9,6 +9,7 @@
 #pragma once
 
 #include <algorithm>
+#include <iterator>
 #include <random>
 
 namespace KODI
@@ -22,5 +23,27 @@ void RandomShuffle(TIterator begin, TIterator end)
   std::mt19937 mt(rd());
   std::shuffle(begin, end, mt);
 }
+
+/*!
+ * \brief Move count uniformly chosen elements of [begin, end) to its front, in random order.
+ *
+ * A partial Fisher-Yates shuffle taking O(count) steps. Sampling consecutive chunks of a range
+ * this way draws a random permutation of it lazily, without shuffling or sorting it up front.
+ *
+ * \return the end of the sample, i.e. begin + min(count, end - begin)
+ */
+template<class TIterator>
+TIterator RandomSample(TIterator begin, TIterator end, size_t count)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  for (; count > 0 && begin != end; ++begin, --count)
+  {
+    std::uniform_int_distribution<typename std::iterator_traits<TIterator>::difference_type> dist(
+        0, std::distance(begin, end) - 1);
+    std::iter_swap(begin, std::next(begin, dist(mt)));
+  }
+  return begin;
+}
 }
 }
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RandomIdCache.h"
+
+#include "threads/SingleLock.h"
+#include "utils/Random.h"
+
+#include <algorithm>
+
+CRandomIdCache& CRandomIdCache::GetInstance()
+{
+  static CRandomIdCache cache;
+  return cache;
+}
+
+std::vector<int> CRandomIdCache::Draw(const std::string& key,
+                                      size_t total,
+                                      size_t count,
+                                      const FetchIds& fetchIds)
+{
+  std::vector<int> result;
+  if (count == 0 || total == 0)
+    return result;
+
+  CSingleLock lock(m_critSection);
+  auto it = m_entries.find(key);
+  if (it == m_entries.end() || it->second.ids.size() != total)
+  {
+    // fetch without holding the lock, other candidate sets may be drawn from meanwhile
+    lock.Leave();
+    std::vector<int> ids;
+    if (!fetchIds(ids) || ids.empty())
+      return result;
+    lock.Enter();
+
+    if (m_entries.size() >= MAX_ENTRIES && m_entries.find(key) == m_entries.end())
+    {
+      const auto leastRecent = std::min_element(
+          m_entries.begin(), m_entries.end(), [](const std::pair<const std::string, Entry>& a,
+                                                 const std::pair<const std::string, Entry>& b) {
+            return a.second.lastUsed < b.second.lastUsed;
+          });
+      m_entries.erase(leastRecent);
+    }
+
+    Entry& entry = m_entries[key];
+    entry.ids = std::move(ids);
+    entry.next = 0;
+    it = m_entries.find(key);
+  }
+
+  Entry& entry = it->second;
+  entry.lastUsed = ++m_useCounter;
+
+  // start a new round rather than repeat ids within one draw
+  count = std::min(count, entry.ids.size());
+  if (entry.ids.size() - entry.next < count)
+    entry.next = 0;
+
+  const auto begin = entry.ids.begin() + entry.next;
+  const auto end = KODI::UTILS::RandomSample(begin, entry.ids.end(), count);
+  result.assign(begin, end);
+  entry.next += result.size();
+  return result;
+}
+
+void CRandomIdCache::Clear()
+{
+  CSingleLock lock(m_critSection);
+  m_entries.clear();
+}
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Random permutations of database ids, cached per candidate set.
+
+ Used instead of ORDER BY RANDOM() with a limit, which sorts the whole candidate set every time.
+ The ids of a candidate set are fetched once, unsorted, and successive draws take the next
+ chunk of a lazily shuffled permutation of them. A draw costs O(count) and ids only repeat once
+ every candidate has been drawn.
+ */
+class CRandomIdCache
+{
+public:
+  typedef std::function<bool(std::vector<int>& ids)> FetchIds;
+
+  static CRandomIdCache& GetInstance();
+
+  /*!
+   \brief Draw ids in random order from a candidate set.
+   \param key identifies the candidate set, e.g. the database, media type and query of the candidates
+   \param total the current number of candidates, counted like fetchIds does. The ids are fetched
+   again when it has changed. Changes keeping the number have to Clear() the cache.
+   \param count the number of ids to draw
+   \param fetchIds fills in all candidate ids, in any order
+   \return count ids, fewer only if there are fewer candidates or fetching them failed
+   */
+  std::vector<int> Draw(const std::string& key, size_t total, size_t count, const FetchIds& fetchIds);
+
+  /*!
+   \brief Drop all cached candidate sets, e.g. after the library has been updated.
+   */
+  void Clear();
+
+private:
+  CRandomIdCache() = default;
+
+  struct Entry
+  {
+    std::vector<int> ids;
+    size_t next = 0; //!< ids before next have been drawn in the current round
+    unsigned int lastUsed = 0;
+  };
+
+  static constexpr size_t MAX_ENTRIES = 16;
+
+  CCriticalSection m_critSection;
+  std::map<std::string, Entry> m_entries;
+  unsigned int m_useCounter = 0;
+};
@@ -361,7 +361,7 @@ int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int star
     bufferLen = std::min<size_t>(bufferLen, startoffset + maxNumberOfCharsToTest);
 
   m_subject.assign(str + startoffset, bufferLen - startoffset);
-  int rc = pcre_exec(m_re, NULL, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
+  int rc = pcre_exec(m_re, m_sd, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
 
   if (rc<1)
   {
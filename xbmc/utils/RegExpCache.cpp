@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RegExpCache.h"
+
+#include "threads/SingleLock.h"
+
+namespace
+{
+
+std::string MakeKey(const std::string& pattern, bool caseless, CRegExp::utf8Mode utf8)
+{
+  std::string key;
+  key.reserve(pattern.size() + 2);
+  key += caseless ? 'i' : 'c';
+  key += static_cast<char>('1' + utf8);
+  key += pattern;
+  return key;
+}
+
+} // unnamed namespace
+
+CRegExpCache::Handle::Handle(CRegExpCache* cache,
+                             const std::string& key,
+                             std::unique_ptr<CRegExp> regExp)
+  : m_cache(cache), m_key(key), m_regExp(std::move(regExp))
+{
+}
+
+CRegExpCache::Handle& CRegExpCache::Handle::operator=(Handle&& other)
+{
+  if (this != &other)
+  {
+    Release();
+    m_cache = other.m_cache;
+    m_key = std::move(other.m_key);
+    m_regExp = std::move(other.m_regExp);
+  }
+  return *this;
+}
+
+CRegExpCache::Handle::~Handle()
+{
+  Release();
+}
+
+void CRegExpCache::Handle::Release()
+{
+  if (m_cache && m_regExp)
+    m_cache->Return(m_key, std::move(m_regExp));
+  m_regExp.reset();
+}
+
+CRegExpCache& CRegExpCache::GetInstance()
+{
+  static CRegExpCache cache;
+  return cache;
+}
+
+CRegExpCache::Handle CRegExpCache::Get(const std::string& pattern,
+                                       bool caseless,
+                                       CRegExp::utf8Mode utf8)
+{
+  const std::string key = MakeKey(pattern, caseless, utf8);
+  bool enabled;
+  {
+    CSingleLock lock(m_critSection);
+    enabled = m_enabled;
+    if (enabled)
+    {
+      auto it = m_entries.find(key);
+      if (it != m_entries.end())
+      {
+        if (it->second.failed)
+        {
+          m_hits++;
+          return Handle();
+        }
+        if (!it->second.idle.empty())
+        {
+          m_hits++;
+          std::unique_ptr<CRegExp> regExp = std::move(it->second.idle.back());
+          it->second.idle.pop_back();
+          return Handle(this, key, std::move(regExp));
+        }
+      }
+    }
+    m_misses++;
+  }
+
+  // compile outside of the lock, it's the expensive part
+  std::unique_ptr<CRegExp> regExp(new CRegExp(caseless, utf8));
+  if (!regExp->RegComp(pattern, enabled ? CRegExp::StudyWithJitComp : CRegExp::NoStudy))
+  {
+    if (enabled)
+    {
+      // remember, the pattern won't get any better and logs its error on every compile
+      CSingleLock lock(m_critSection);
+      m_entries[key].failed = true;
+    }
+    return Handle();
+  }
+  return Handle(enabled ? this : nullptr, key, std::move(regExp));
+}
+
+void CRegExpCache::Return(const std::string& key, std::unique_ptr<CRegExp> regExp)
+{
+  CSingleLock lock(m_critSection);
+  if (!m_enabled)
+    return;
+
+  // start over when full, expressions in use come back into new entries
+  if (m_entries.size() >= MAX_ENTRIES && m_entries.find(key) == m_entries.end())
+    m_entries.clear();
+  m_entries[key].idle.push_back(std::move(regExp));
+}
+
+void CRegExpCache::SetEnabled(bool enabled)
+{
+  CSingleLock lock(m_critSection);
+  m_enabled = enabled;
+  if (!enabled)
+    m_entries.clear();
+}
+
+unsigned int CRegExpCache::GetHits() const
+{
+  CSingleLock lock(m_critSection);
+  return m_hits;
+}
+
+unsigned int CRegExpCache::GetMisses() const
+{
+  CSingleLock lock(m_critSection);
+  return m_misses;
+}
+
+void CRegExpCache::Clear()
+{
+  CSingleLock lock(m_critSection);
+  m_entries.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "RegExp.h"
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Process wide cache of compiled and JIT-studied regular expressions.
+
+ Meant for code which compiles the same expressions over and over, like the scraper parser
+ during a library scan. A CRegExp keeps the state of its last match, so an expression is lent
+ out to one user at a time: Get() hands out an idle instance or compiles a new one, the
+ handle returns it to the cache when it goes out of scope.
+ */
+class CRegExpCache
+{
+public:
+  class Handle
+  {
+  public:
+    Handle() = default;
+    Handle(Handle&& other) = default;
+    Handle& operator=(Handle&& other);
+    ~Handle();
+
+    explicit operator bool() const { return m_regExp != nullptr; }
+    CRegExp* operator->() const { return m_regExp.get(); }
+    CRegExp& operator*() const { return *m_regExp; }
+
+  private:
+    friend class CRegExpCache;
+    Handle(CRegExpCache* cache, const std::string& key, std::unique_ptr<CRegExp> regExp);
+    void Release();
+
+    CRegExpCache* m_cache = nullptr;
+    std::string m_key;
+    std::unique_ptr<CRegExp> m_regExp;
+  };
+
+  static CRegExpCache& GetInstance();
+
+  /*!
+   \brief Get a compiled expression.
+   \param pattern the regular expression
+   \param caseless match case insensitive
+   \param utf8 UTF-8 processing, see CRegExp
+   \return the expression, or an empty handle if the pattern doesn't compile
+   */
+  Handle Get(const std::string& pattern, bool caseless = false,
+             CRegExp::utf8Mode utf8 = CRegExp::asciiOnly);
+
+  /*!
+   \brief Compile every expression on every Get(), without JIT, like it was done before the cache.
+   For comparing in benchmarks.
+   */
+  void SetEnabled(bool enabled);
+
+  void Clear();
+
+  unsigned int GetHits() const;
+  unsigned int GetMisses() const;
+
+private:
+  CRegExpCache() = default;
+
+  void Return(const std::string& key, std::unique_ptr<CRegExp> regExp);
+
+  struct Entry
+  {
+    std::vector<std::unique_ptr<CRegExp>> idle;
+    bool failed = false;
+  };
+
+  // patterns with substituted scraper buffers are endless, start over beyond this
+  static constexpr size_t MAX_ENTRIES = 1024;
+
+  mutable CCriticalSection m_critSection;
+  std::map<std::string, Entry> m_entries;
+  bool m_enabled = true;
+  unsigned int m_hits = 0;
+  unsigned int m_misses = 0;
+};
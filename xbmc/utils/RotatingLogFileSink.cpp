@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RotatingLogFileSink.h"
+
+#include <spdlog/details/os.h>
+
+namespace
+{
+constexpr char Utf8Bom[3] = {'\xEF', '\xBB', '\xBF'};
+}
+
+CRotatingLogFileSink::CRotatingLogFileSink(const spdlog_filename_t& filename,
+                                           const spdlog_filename_t& rotatedFilename)
+  : m_filename(filename), m_rotatedFilename(rotatedFilename)
+{
+  Open();
+}
+
+void CRotatingLogFileSink::SetRotation(size_t maxSize, std::chrono::minutes maxAge)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  m_maxSize = maxSize;
+  m_maxAge = maxAge;
+}
+
+void CRotatingLogFileSink::sink_it_(const spdlog::details::log_msg& msg)
+{
+  spdlog::memory_buf_t formatted;
+  formatter_->format(msg, formatted);
+
+  if ((m_maxSize > 0 && m_size + formatted.size() > m_maxSize) ||
+      (m_maxAge.count() > 0 && std::chrono::steady_clock::now() - m_opened > m_maxAge))
+    Rotate();
+
+  m_file.write(formatted);
+  m_size += formatted.size();
+}
+
+void CRotatingLogFileSink::flush_()
+{
+  m_file.flush();
+}
+
+void CRotatingLogFileSink::Open()
+{
+  // the file has been prepared (old log moved away, BOM written) by CLog
+  m_file.open(m_filename, false);
+  m_size = m_file.size();
+  m_opened = std::chrono::steady_clock::now();
+}
+
+void CRotatingLogFileSink::Rotate()
+{
+  // never log from here, we're called with the sink mutex held
+  m_file.close();
+  spdlog::details::os::remove(m_rotatedFilename);
+  // keep appending to the current file if it can't be moved away
+  const bool rotated = spdlog::details::os::rename(m_filename, m_rotatedFilename) == 0;
+
+  m_file.open(m_filename, rotated);
+  if (rotated)
+  {
+    spdlog::memory_buf_t bom;
+    bom.append(Utf8Bom, Utf8Bom + sizeof(Utf8Bom));
+    m_file.write(bom);
+  }
+
+  m_size = m_file.size();
+  m_opened = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/IPlatformLog.h"
+
+#include <chrono>
+#include <mutex>
+
+#include <spdlog/details/file_helper.h>
+#include <spdlog/sinks/base_sink.h>
+
+/*!
+ * \brief File sink which starts a new log file once the current one exceeds a size or an age.
+ *
+ * The previous part is kept as <name>.1.log, the current one is always the file the sink was
+ * opened with. Rotation is disabled as long as neither a size nor an age limit is set.
+ */
+class CRotatingLogFileSink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+  CRotatingLogFileSink(const spdlog_filename_t& filename, const spdlog_filename_t& rotatedFilename);
+
+  /*!
+   * \brief Set the rotation limits
+   * \param maxSize rotate once the file is larger than this many bytes, 0 for no limit
+   * \param maxAge rotate once the file is older than this, 0 for no limit
+   */
+  void SetRotation(size_t maxSize, std::chrono::minutes maxAge);
+
+protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override;
+  void flush_() override;
+
+private:
+  void Open();
+  void Rotate();
+
+  spdlog::details::file_helper m_file;
+  spdlog_filename_t m_filename;
+  spdlog_filename_t m_rotatedFilename;
+  size_t m_maxSize = 0;
+  std::chrono::minutes m_maxAge{0};
+  size_t m_size = 0;
+  std::chrono::steady_clock::time_point m_opened;
+};
@@ -11,6 +11,7 @@
 #include "addons/AddonManager.h"
 #include "guilib/LocalizeStrings.h"
 #include "RegExp.h"
+#include "RegExpCache.h"
 #include "HTMLUtil.h"
 #include "addons/Scraper.h"
 #include "URL.h"
@@ -205,7 +206,6 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
         eUtf8 = CRegExp::autoUtf8;
     }
 
-    CRegExp reg(bInsensitive, eUtf8);
     std::string strExpression;
     if (pExpression->FirstChild())
       strExpression = pExpression->FirstChild()->Value();
@@ -214,7 +214,8 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
     ReplaceBuffers(strExpression);
     ReplaceBuffers(strOutput);
 
-    if (!reg.RegComp(strExpression.c_str()))
+    CRegExpCache::Handle reg = CRegExpCache::GetInstance().Get(strExpression, bInsensitive, eUtf8);
+    if (!reg)
     {
       return;
     }
@@ -261,7 +262,7 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
       if (bEncode[iBuf])
         InsertToken(strOutput,iBuf+1,"!!!ENCODE!!!");
     }
-    int i = reg.RegFind(curInput.c_str());
+    int i = reg->RegFind(curInput.c_str());
     while (i > -1 && (i < (int)curInput.size() || curInput.empty()))
     {
       if (!bAppend)
@@ -275,13 +276,12 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
       {
         char temp[12];
         sprintf(temp,"\\%i",iOptional);
-        std::string szParam = reg.GetReplaceString(temp);
-        CRegExp reg2;
-        reg2.RegComp("(.*)(\\\\\\(.*\\\\2.*)\\\\\\)(.*)");
-        int i2=reg2.RegFind(strCurOutput.c_str());
+        std::string szParam = reg->GetReplaceString(temp);
+        CRegExpCache::Handle reg2 = CRegExpCache::GetInstance().Get("(.*)(\\\\\\(.*\\\\2.*)\\\\\\)(.*)");
+        int i2=reg2->RegFind(strCurOutput.c_str());
         while (i2 > -1)
         {
-          std::string szRemove(reg2.GetMatch(2));
+          std::string szRemove(reg2->GetMatch(2));
           int iRemove = szRemove.size();
           int i3 = strCurOutput.find(szRemove);
           if (!szParam.empty())
@@ -292,14 +292,14 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
           else
             strCurOutput.replace(strCurOutput.begin()+i3,strCurOutput.begin()+i3+iRemove+2,"");
 
-          i2 = reg2.RegFind(strCurOutput.c_str());
+          i2 = reg2->RegFind(strCurOutput.c_str());
         }
       }
 
-      int iLen = reg.GetFindLen();
+      int iLen = reg->GetFindLen();
       // nasty hack #1 - & means \0 in a replace string
       StringUtils::Replace(strCurOutput, "&","!!!AMPAMP!!!");
-      std::string result = reg.GetReplaceString(strCurOutput.c_str());
+      std::string result = reg->GetReplaceString(strCurOutput.c_str());
       if (!result.empty())
       {
         std::string strResult(result);
@@ -319,7 +319,7 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
       if (bRepeat && iLen > 0)
       {
         curInput.erase(0,i+iLen>(int)curInput.size()?curInput.size():i+iLen);
-        i = reg.RegFind(curInput.c_str());
+        i = reg->RegFind(curInput.c_str());
       }
       else
         i = -1;
@@ -541,27 +541,25 @@ void CScraperParser::Clean(std::string& strDirty)
 
 void CScraperParser::ConvertJSON(std::string &string)
 {
-  CRegExp reg;
-  reg.RegComp("\\\\u([0-f]{4})");
-  while (reg.RegFind(string.c_str()) > -1)
+  CRegExpCache::Handle reg = CRegExpCache::GetInstance().Get("\\\\u([0-f]{4})");
+  while (reg->RegFind(string.c_str()) > -1)
   {
-    int pos = reg.GetSubStart(1);
-    std::string szReplace(reg.GetMatch(1));
+    int pos = reg->GetSubStart(1);
+    std::string szReplace(reg->GetMatch(1));
 
     std::string replace = StringUtils::Format("&#x%s;", szReplace.c_str());
     string.replace(string.begin()+pos-2, string.begin()+pos+4, replace);
   }
 
-  CRegExp reg2;
-  reg2.RegComp("\\\\x([0-9]{2})([^\\\\]+;)");
-  while (reg2.RegFind(string.c_str()) > -1)
+  CRegExpCache::Handle reg2 = CRegExpCache::GetInstance().Get("\\\\x([0-9]{2})([^\\\\]+;)");
+  while (reg2->RegFind(string.c_str()) > -1)
   {
-    int pos1 = reg2.GetSubStart(1);
-    int pos2 = reg2.GetSubStart(2);
-    std::string szHexValue(reg2.GetMatch(1));
+    int pos1 = reg2->GetSubStart(1);
+    int pos2 = reg2->GetSubStart(2);
+    std::string szHexValue(reg2->GetMatch(1));
 
     std::string replace = StringUtils::Format("%li", strtol(szHexValue.c_str(), NULL, 16));
-    string.replace(string.begin()+pos1-2, string.begin()+pos2+reg2.GetSubLength(2), replace);
+    string.replace(string.begin()+pos1-2, string.begin()+pos2+reg2->GetSubLength(2), replace);
   }
 
   StringUtils::Replace(string, "\\\"","\"");
@@ -0,0 +1,193 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TraceRecorder.h"
+
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+namespace
+{
+
+void AppendEscaped(std::string& out, const char* str)
+{
+  for (; *str; ++str)
+  {
+    const char c = *str;
+    if (c == '"' || c == '\\')
+    {
+      out += '\\';
+      out += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+      out += StringUtils::Format("\\u%04x", static_cast<int>(c));
+    else
+      out += c;
+  }
+}
+
+} // unnamed namespace
+
+std::atomic<bool> CTraceRecorder::m_recording{false};
+
+CTraceRecorder& CTraceRecorder::GetInstance()
+{
+  static CTraceRecorder recorder;
+  return recorder;
+}
+
+void CTraceRecorder::Start(size_t maxEventsPerThread)
+{
+  CSingleLock lock(m_critSection);
+
+  m_buffers.clear();
+  m_maxEventsPerThread = maxEventsPerThread;
+  m_session++;
+  m_recording = true;
+
+  CLog::Log(LOGINFO, "CTraceRecorder::Start - recording trace events");
+}
+
+bool CTraceRecorder::Stop(const std::string& path)
+{
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    CSingleLock lock(m_critSection);
+    if (!m_recording)
+      return false;
+
+    m_recording = false;
+    buffers.swap(m_buffers);
+  }
+
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  size_t events = 0;
+  size_t dropped = 0;
+
+  for (const auto& buffer : buffers)
+  {
+    if (!first)
+      json += ',';
+    first = false;
+
+    // name the thread in the timeline
+    json += StringUtils::Format("{{\"ph\":\"M\",\"pid\":1,\"tid\":{},\"name\":\"thread_name\","
+                                "\"args\":{{\"name\":\"",
+                                buffer->threadId);
+    AppendEscaped(json, buffer->threadName.c_str());
+    json += "\"}}";
+
+    const size_t count = buffer->count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++)
+    {
+      const Event& event = buffer->events[i];
+      json += ",{\"cat\":\"";
+      AppendEscaped(json, event.category);
+      json += "\",\"name\":\"";
+      AppendEscaped(json, event.name);
+      json += StringUtils::Format("\",\"ph\":\"{:c}\",\"pid\":1,\"tid\":{},\"ts\":{}", event.phase,
+                                  buffer->threadId, event.timestamp);
+      if (event.phase == 'X')
+        json += StringUtils::Format(",\"dur\":{}}}", event.value);
+      else if (event.phase == 'C')
+        json += StringUtils::Format(",\"args\":{{\"value\":{}}}}}", event.value);
+      else
+        json += ",\"s\":\"t\"}";
+    }
+    events += count;
+    dropped += buffer->dropped;
+  }
+  json += "]}";
+
+  CLog::Log(LOGINFO, "CTraceRecorder::Stop - {} events of {} threads recorded, {} dropped", events,
+            buffers.size(), dropped);
+
+  if (events == 0)
+    return false;
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(path, true) ||
+      file.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CTraceRecorder::Stop - unable to write {}", path);
+    return false;
+  }
+
+  CLog::Log(LOGINFO, "CTraceRecorder::Stop - trace written to {}", path);
+  return true;
+}
+
+void CTraceRecorder::AddSpan(const char* category,
+                             const char* name,
+                             int64_t start,
+                             int64_t duration)
+{
+  Add({category, name, 'X', start, duration});
+}
+
+void CTraceRecorder::AddCounter(const char* category, const char* name, int64_t value)
+{
+  Add({category, name, 'C', Now(), value});
+}
+
+void CTraceRecorder::AddInstant(const char* category, const char* name)
+{
+  Add({category, name, 'i', Now(), 0});
+}
+
+void CTraceRecorder::Add(const Event& event)
+{
+  if (!IsRecording())
+    return;
+
+  const std::shared_ptr<ThreadBuffer> buffer = GetThreadBuffer();
+  if (!buffer)
+    return;
+
+  // only this thread writes, the exporter reads up to the published count
+  const size_t count = buffer->count.load(std::memory_order_relaxed);
+  if (count >= buffer->events.size())
+  {
+    buffer->dropped++;
+    return;
+  }
+
+  buffer->events[count] = event;
+  buffer->count.store(count + 1, std::memory_order_release);
+}
+
+std::shared_ptr<CTraceRecorder::ThreadBuffer> CTraceRecorder::GetThreadBuffer()
+{
+  struct ThreadState
+  {
+    unsigned int session = 0;
+    std::shared_ptr<ThreadBuffer> buffer;
+  };
+  static thread_local ThreadState state;
+
+  const unsigned int session = m_session;
+  if (state.session != session)
+  {
+    CSingleLock lock(m_critSection);
+    if (!m_recording)
+      return nullptr;
+
+    state.buffer = std::make_shared<ThreadBuffer>(m_maxEventsPerThread);
+    state.buffer->threadId = CThread::GetCurrentThreadNativeId();
+    const CThread* thread = CThread::GetCurrentThread();
+    state.buffer->threadName = thread ? thread->GetName() : "";
+    state.session = m_session;
+    m_buffers.emplace_back(state.buffer);
+  }
+
+  return state.buffer;
+}
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Process wide recorder of trace events, exported in Chrome's trace event format.
+ *
+ * Every thread records into its own buffer without locking, so spans and counters can be
+ * placed on hot paths. Nothing is recorded unless a recording has been started, and the
+ * TRACE_* macros compile to nothing without HAS_TRACE_EVENTS.
+ *
+ * Category and event names are stored as pointers and must be string literals or otherwise
+ * outlive the recording.
+ *
+ * Load the written file in chrome://tracing or ui.perfetto.dev.
+ */
+class CTraceRecorder
+{
+public:
+  static CTraceRecorder& GetInstance();
+
+  /*!
+   * \brief Start a new recording, discarding the events of a previous one.
+   * \param maxEventsPerThread events a single thread may record, further ones are dropped
+   */
+  void Start(size_t maxEventsPerThread = 65536);
+
+  /*!
+   * \brief Stop recording and write the events as Chrome trace JSON.
+   * \param path file to write, e.g. special://temp/trace.json
+   * \return false if nothing was recorded or the file could not be written
+   */
+  bool Stop(const std::string& path);
+
+  static bool IsRecording() { return m_recording.load(std::memory_order_relaxed); }
+
+  static int64_t Now()
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void AddSpan(const char* category, const char* name, int64_t start, int64_t duration);
+  void AddCounter(const char* category, const char* name, int64_t value);
+  void AddInstant(const char* category, const char* name);
+
+private:
+  CTraceRecorder() = default;
+
+  struct Event
+  {
+    const char* category;
+    const char* name;
+    char phase; // 'X' span, 'C' counter, 'i' instant
+    int64_t timestamp; // us
+    int64_t value; // duration for spans, value for counters
+  };
+
+  struct ThreadBuffer
+  {
+    explicit ThreadBuffer(size_t capacity) : events(capacity) {}
+
+    std::vector<Event> events;
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> dropped{0};
+    uint64_t threadId = 0;
+    std::string threadName;
+  };
+
+  void Add(const Event& event);
+  std::shared_ptr<ThreadBuffer> GetThreadBuffer();
+
+  static std::atomic<bool> m_recording;
+
+  CCriticalSection m_critSection;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+  std::atomic<unsigned int> m_session{0};
+  size_t m_maxEventsPerThread = 0;
+};
+
+/*!
+ * \brief Records the lifetime of the scope as a span.
+ */
+class CTraceScope
+{
+public:
+  CTraceScope(const char* category, const char* name)
+  {
+    if (CTraceRecorder::IsRecording())
+    {
+      m_category = category;
+      m_name = name;
+      m_start = CTraceRecorder::Now();
+    }
+  }
+
+  ~CTraceScope()
+  {
+    if (m_name)
+      CTraceRecorder::GetInstance().AddSpan(m_category, m_name, m_start,
+                                            CTraceRecorder::Now() - m_start);
+  }
+
+  CTraceScope(const CTraceScope&) = delete;
+  CTraceScope& operator=(const CTraceScope&) = delete;
+
+private:
+  const char* m_category = nullptr;
+  const char* m_name = nullptr;
+  int64_t m_start = 0;
+};
+
+#ifdef HAS_TRACE_EVENTS
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(category, name) CTraceScope TRACE_CONCAT(traceScope, __LINE__)((category), (name))
+#define TRACE_COUNTER(category, name, value) \
+  do \
+  { \
+    if (CTraceRecorder::IsRecording()) \
+      CTraceRecorder::GetInstance().AddCounter((category), (name), (value)); \
+  } while (0)
+#define TRACE_INSTANT(category, name) \
+  do \
+  { \
+    if (CTraceRecorder::IsRecording()) \
+      CTraceRecorder::GetInstance().AddInstant((category), (name)); \
+  } while (0)
+#else
+#define TRACE_SCOPE(category, name) ((void)0)
+#define TRACE_COUNTER(category, name, value) ((void)0)
+#define TRACE_INSTANT(category, name) ((void)0)
+#endif
@@ -26,12 +26,14 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingsManager.h"
+#include "utils/AsyncLogSink.h"
+#include "utils/RotatingLogFileSink.h"
 #include "utils/URIUtils.h"
 
+#include <chrono>
 #include <cstring>
 #include <set>
 
-#include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/dist_sink.h>
 
 static constexpr unsigned char Utf8Bom[3] = {0xEF, 0xBB, 0xBF};
@@ -41,6 +43,7 @@ static const std::string LogPattern = "%Y-%m-%d %T.%e T:%-5t %7l <%n>: %v";
 CLog::CLog()
   : m_platform(IPlatformLog::CreatePlatformLog()),
     m_sinks(std::make_shared<spdlog::sinks::dist_sink_mt>()),
+    m_asyncSink(std::make_shared<CAsyncLogSink>(m_sinks)),
     m_defaultLogger(CreateLogger("general")),
     m_logLevel(LOG_LEVEL_DEBUG),
     m_componentLogEnabled(false),
@@ -107,10 +110,12 @@ void CLog::Initialize(const std::string& path)
   const std::string filePathBase = URIUtils::AddFileToFolder(path, appName);
   const std::string filePath = filePathBase + LogFileExtension;
   const std::string oldFilePath = filePathBase + ".old" + LogFileExtension;
+  const std::string rotatedFilePath = filePathBase + ".1" + LogFileExtension;
 
   // handle old.log by deleting an existing old.log and renaming the last log to old.log
   XFILE::CFile::Delete(oldFilePath);
   XFILE::CFile::Rename(filePath, oldFilePath);
+  XFILE::CFile::Delete(rotatedFilePath);
 
   // write UTF-8 BOM
   {
@@ -120,9 +125,10 @@ void CLog::Initialize(const std::string& path)
   }
 
   // create the file sink
-  m_fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
-      m_platform->GetLogFilename(filePath), false);
+  m_fileSink = std::make_shared<CRotatingLogFileSink>(m_platform->GetLogFilename(filePath),
+                                                      m_platform->GetLogFilename(rotatedFilePath));
   m_fileSink->set_pattern(LogPattern);
+  m_fileSink->SetRotation(m_rotateSize, std::chrono::minutes(m_rotateAge));
 
   // add it to the existing sinks
   m_sinks->add_sink(m_fileSink);
@@ -140,7 +146,8 @@ void CLog::Uninitialize()
   settingsManager->UnregisterSettingsHandler(this);
   settingsManager->UnregisterCallback(this);
 
-  // flush all loggers
+  // write out queued messages and flush all loggers
+  m_asyncSink->Drain();
   spdlog::apply_all([](std::shared_ptr<spdlog::logger> logger) { logger->flush(); });
 
   // flush the file sink
@@ -172,6 +179,31 @@ void CLog::SetLogLevel(int level)
                        spdlog::level::to_string_view(spdLevel));
 }
 
+void CLog::SetAsync(bool async, bool dropOnOverflow)
+{
+  const bool wasAsync = m_asyncSink->IsAsync();
+  m_asyncSink->SetAsync(async, dropOnOverflow ? CAsyncLogSink::OverflowPolicy::DROP
+                                              : CAsyncLogSink::OverflowPolicy::BLOCK);
+  if (async != wasAsync)
+    FormatAndLogInternal(spdlog::level::info, "Asynchronous logging {}",
+                         async ? (dropOnOverflow ? "enabled, dropping on overflow" : "enabled")
+                               : "disabled");
+}
+
+bool CLog::IsAsync() const
+{
+  return m_asyncSink->IsAsync();
+}
+
+void CLog::SetRotation(size_t maxSize, unsigned int maxAge)
+{
+  m_rotateSize = maxSize;
+  m_rotateAge = maxAge;
+
+  if (m_fileSink != nullptr)
+    m_fileSink->SetRotation(m_rotateSize, std::chrono::minutes(m_rotateAge));
+}
+
 bool CLog::IsLogLevelLogged(int loglevel)
 {
   if (m_logLevel >= LOG_LEVEL_DEBUG)
@@ -267,7 +299,7 @@ spdlog::level::level_enum CLog::MapLogLevel(int level)
 Logger CLog::CreateLogger(const std::string& loggerName)
 {
   // create the logger
-  auto logger = std::make_shared<spdlog::logger>(loggerName, m_sinks);
+  auto logger = std::make_shared<spdlog::logger>(loggerName, m_asyncSink);
 
   // initialize the logger
   spdlog::initialize_logger(logger);
@@ -28,14 +28,14 @@ namespace spdlog
 {
 namespace sinks
 {
-template<typename Mutex>
-class basic_file_sink;
-
 template<typename Mutex>
 class dist_sink;
 } // namespace sinks
 } // namespace spdlog
 
+class CAsyncLogSink;
+class CRotatingLogFileSink;
+
 class CLog : public ISettingsHandler, public ISettingCallback
 {
 public:
@@ -55,6 +55,22 @@ public:
   int GetLogLevel() { return m_logLevel; }
   bool IsLogLevelLogged(int loglevel);
 
+  /*!
+   * \brief Write log messages from a background thread instead of the calling thread.
+   * \param async true to queue messages, false to write them synchronously
+   * \param dropOnOverflow drop (and count) messages if a thread's queue is full instead of
+   *        waiting for the writer
+   */
+  void SetAsync(bool async, bool dropOnOverflow);
+  bool IsAsync() const;
+
+  /*!
+   * \brief Start a new log file once the current one is too large or too old.
+   * \param maxSize maximum size in bytes, 0 for no limit
+   * \param maxAge maximum age in minutes, 0 for no limit
+   */
+  void SetRotation(size_t maxSize, unsigned int maxAge);
+
   bool CanLogComponent(uint32_t component) const;
   static void SettingOptionsLoggingComponentsFiller(std::shared_ptr<const CSetting> setting,
                                                     std::vector<IntegerSettingOption>& list,
@@ -193,9 +209,12 @@ private:
 
   std::unique_ptr<IPlatformLog> m_platform;
   std::shared_ptr<spdlog::sinks::dist_sink<std::mutex>> m_sinks;
+  std::shared_ptr<CAsyncLogSink> m_asyncSink;
   Logger m_defaultLogger;
 
-  std::shared_ptr<spdlog::sinks::basic_file_sink<std::mutex>> m_fileSink;
+  std::shared_ptr<CRotatingLogFileSink> m_fileSink;
+  size_t m_rotateSize = 0;
+  unsigned int m_rotateAge = 0;
 
   int m_logLevel;
 
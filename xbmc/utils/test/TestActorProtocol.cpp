@@ -0,0 +1,263 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Event.h"
+#include "utils/ActorProtocol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Actor;
+
+namespace
+{
+
+enum Signals
+{
+  PING = 1,
+  PONG,
+  DROP,
+  QUIT
+};
+
+struct BigPayload
+{
+  uint8_t data[256];
+};
+
+} // unnamed namespace
+
+TEST(TestActorProtocol, Order)
+{
+  CEvent inEvent;
+  Protocol protocol("TestActorProtocol", &inEvent, nullptr);
+
+  // more messages than there are in the arena
+  const int count = Protocol::ARENA_SIZE * 2;
+  for (int i = 0; i < count; i++)
+    protocol.SendInMessage(PING, &i, sizeof(i));
+
+  Message* msg;
+  for (int i = 0; i < count; i++)
+  {
+    ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+    EXPECT_EQ(PING, msg->signal);
+    EXPECT_FALSE(msg->isOut);
+    EXPECT_EQ(i, *reinterpret_cast<int*>(msg->data));
+    msg->Release();
+  }
+  EXPECT_FALSE(protocol.ReceiveInMessage(&msg));
+}
+
+TEST(TestActorProtocol, Payload)
+{
+  Protocol protocol("TestActorProtocol");
+
+  BigPayload big;
+  for (size_t i = 0; i < sizeof(big.data); i++)
+    big.data[i] = static_cast<uint8_t>(i);
+  protocol.SendOutMessage(PING, &big, sizeof(big));
+  protocol.SendOutMessage(PONG, new CPayloadWrap<BigPayload>(big));
+
+  Message* msg;
+  ASSERT_TRUE(protocol.ReceiveOutMessage(&msg));
+  EXPECT_TRUE(msg->isOut);
+  EXPECT_EQ(sizeof(big), msg->payloadSize);
+  EXPECT_EQ(0, memcmp(big.data, msg->data, sizeof(big)));
+  msg->Release();
+
+  ASSERT_TRUE(protocol.ReceiveOutMessage(&msg));
+  ASSERT_TRUE(msg->payloadObj);
+  auto* payload = static_cast<CPayloadWrap<BigPayload>*>(msg->payloadObj.get());
+  EXPECT_EQ(0, memcmp(big.data, payload->GetPlayload()->data, sizeof(big)));
+  msg->Release();
+}
+
+TEST(TestActorProtocol, Defer)
+{
+  Protocol protocol("TestActorProtocol");
+  protocol.SendInMessage(PING);
+
+  Message* msg;
+  protocol.DeferIn(true);
+  EXPECT_FALSE(protocol.ReceiveInMessage(&msg));
+  protocol.DeferIn(false);
+  ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+  msg->Release();
+}
+
+TEST(TestActorProtocol, Purge)
+{
+  Protocol protocol("TestActorProtocol");
+  protocol.SendInMessage(PING);
+  protocol.SendInMessage(DROP);
+  protocol.SendInMessage(PONG);
+  protocol.SendInMessage(DROP);
+
+  protocol.PurgeIn(DROP);
+
+  Message* msg;
+  ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+  EXPECT_EQ(PING, msg->signal);
+  msg->Release();
+  // messages sent after purging are received after the remaining ones
+  protocol.SendInMessage(QUIT);
+  ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+  EXPECT_EQ(PONG, msg->signal);
+  msg->Release();
+  ASSERT_TRUE(protocol.ReceiveInMessage(&msg));
+  EXPECT_EQ(QUIT, msg->signal);
+  msg->Release();
+  EXPECT_FALSE(protocol.ReceiveInMessage(&msg));
+}
+
+TEST(TestActorProtocol, Sync)
+{
+  CEvent outEvent;
+  Protocol protocol("TestActorProtocol", nullptr, &outEvent);
+
+  std::thread actor([&protocol, &outEvent]() {
+    Message* msg;
+    while (!protocol.ReceiveOutMessage(&msg))
+      outEvent.Wait();
+    int value = *reinterpret_cast<int*>(msg->data) + 1;
+    msg->Reply(PONG, &value, sizeof(value));
+    msg->Release();
+  });
+
+  Message* reply;
+  const int value = 41;
+  ASSERT_TRUE(protocol.SendOutMessageSync(PING, &reply, 5000, &value, sizeof(value)));
+  actor.join();
+  EXPECT_EQ(PONG, reply->signal);
+  EXPECT_FALSE(reply->isOut);
+  EXPECT_EQ(42, *reinterpret_cast<int*>(reply->data));
+  reply->Release();
+}
+
+TEST(TestActorProtocol, SyncTimeout)
+{
+  Protocol protocol("TestActorProtocol");
+
+  Message* reply;
+  EXPECT_FALSE(protocol.SendOutMessageSync(PING, &reply, 10));
+  EXPECT_EQ(nullptr, reply);
+
+  // replying late is dropped
+  Message* msg;
+  ASSERT_TRUE(protocol.ReceiveOutMessage(&msg));
+  EXPECT_TRUE(msg->Reply(PONG));
+  msg->Release();
+  EXPECT_FALSE(protocol.ReceiveInMessage(&msg));
+}
+
+TEST(TestActorProtocol, Senders)
+{
+  CEvent inEvent;
+  Protocol protocol("TestActorProtocol", &inEvent, nullptr);
+
+  const int senders = 4;
+  const int count = 10000;
+  std::vector<std::thread> threads;
+  for (int s = 0; s < senders; s++)
+  {
+    threads.emplace_back([&protocol, s]() {
+      for (int i = 0; i < count; i++)
+      {
+        const int value = s * count + i;
+        protocol.SendInMessage(PING, &value, sizeof(value));
+      }
+    });
+  }
+
+  // messages of each sender arrive in order
+  std::vector<int> last(senders, -1);
+  int received = 0;
+  while (received < senders * count)
+  {
+    Message* msg;
+    if (!protocol.ReceiveInMessage(&msg))
+    {
+      inEvent.WaitMSec(100);
+      continue;
+    }
+    const int value = *reinterpret_cast<int*>(msg->data);
+    msg->Release();
+    EXPECT_LT(last[value / count], value % count);
+    last[value / count] = value % count;
+    received++;
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+}
+
+/*
+ * Measures the round trip of sync messages between two threads. Set
+ * KODI_BENCHMARK_ACTOR to the number of round trips to run it.
+ */
+TEST(TestActorProtocol, Benchmark)
+{
+  const char* env = std::getenv("KODI_BENCHMARK_ACTOR");
+  if (!env)
+    GTEST_SKIP() << "KODI_BENCHMARK_ACTOR not set";
+  const int count = std::max(1, std::atoi(env));
+
+  CEvent outEvent;
+  Protocol protocol("TestActorProtocol", nullptr, &outEvent);
+
+  std::thread actor([&protocol, &outEvent]() {
+    while (true)
+    {
+      Message* msg;
+      if (!protocol.ReceiveOutMessage(&msg))
+      {
+        outEvent.Wait();
+        continue;
+      }
+      const bool quit = msg->signal == QUIT;
+      msg->Reply(PONG, msg->data, msg->payloadSize);
+      msg->Release();
+      if (quit)
+        break;
+    }
+  });
+
+  std::vector<int64_t> latencies;
+  latencies.reserve(count);
+  for (int i = 0; i < count; i++)
+  {
+    Message* reply;
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(protocol.SendOutMessageSync(PING, &reply, 5000, &i, sizeof(i)));
+    latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+    EXPECT_EQ(i, *reinterpret_cast<int*>(reply->data));
+    reply->Release();
+  }
+
+  Message* reply;
+  EXPECT_TRUE(protocol.SendOutMessageSync(QUIT, &reply, 5000));
+  if (reply)
+    reply->Release();
+  actor.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "round trips: " << count << ", latency p50: " << latencies[count / 2] / 1000
+            << "us, p99: " << latencies[count * 99 / 100] / 1000
+            << "us, max: " << latencies.back() / 1000 << "us" << std::endl;
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/Random.h"
+#include "utils/RandomIdCache.h"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+#include <gtest/gtest.h>
+
+TEST(TestRandomIdCache, RandomSample)
+{
+  std::vector<int> values(100);
+  std::iota(values.begin(), values.end(), 0);
+
+  auto end = KODI::UTILS::RandomSample(values.begin(), values.end(), 10);
+  EXPECT_EQ(values.begin() + 10, end);
+  end = KODI::UTILS::RandomSample(end, values.end(), 1000);
+  EXPECT_EQ(values.end(), end);
+
+  // sampling in chunks permutes the whole range
+  std::vector<int> sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+  for (int i = 0; i < 100; i++)
+    EXPECT_EQ(i, sorted[i]);
+}
+
+TEST(TestRandomIdCache, DrawWithoutRepeats)
+{
+  CRandomIdCache& cache = CRandomIdCache::GetInstance();
+  cache.Clear();
+
+  int fetches = 0;
+  const auto fetchIds = [&fetches](std::vector<int>& ids) {
+    fetches++;
+    ids.resize(50);
+    std::iota(ids.begin(), ids.end(), 1);
+    return true;
+  };
+
+  std::set<int> drawn;
+  for (int i = 0; i < 5; i++)
+  {
+    const std::vector<int> ids = cache.Draw("TestRandomIdCache.songs", 50, 10, fetchIds);
+    ASSERT_EQ(10u, ids.size());
+    drawn.insert(ids.begin(), ids.end());
+  }
+  EXPECT_EQ(50u, drawn.size());
+  EXPECT_EQ(1, fetches);
+
+  // the next round starts over, a changed total fetches the ids again
+  EXPECT_EQ(10u, cache.Draw("TestRandomIdCache.songs", 50, 10, fetchIds).size());
+  EXPECT_EQ(1, fetches);
+  EXPECT_EQ(50u, cache.Draw("TestRandomIdCache.songs", 51, 100, fetchIds).size());
+  EXPECT_EQ(2, fetches);
+}
+
+TEST(TestRandomIdCache, FetchFailure)
+{
+  CRandomIdCache& cache = CRandomIdCache::GetInstance();
+  cache.Clear();
+
+  const auto fetchIds = [](std::vector<int>& ids) { return false; };
+  EXPECT_TRUE(cache.Draw("TestRandomIdCache.failure", 10, 5, fetchIds).empty());
+  EXPECT_TRUE(cache.Draw("TestRandomIdCache.empty", 0, 5, fetchIds).empty());
+}
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/RegExpCache.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestRegExpCache, Reuse)
+{
+  CRegExpCache& cache = CRegExpCache::GetInstance();
+  cache.Clear();
+
+  const CRegExp* first;
+  {
+    CRegExpCache::Handle reg = cache.Get("^(Test)\\s*(.*)\\.");
+    ASSERT_TRUE(reg);
+    EXPECT_EQ(0, reg->RegFind("Test string."));
+    EXPECT_EQ("string", reg->GetMatch(2));
+    first = &*reg;
+
+    // in use, so another instance is compiled
+    CRegExpCache::Handle other = cache.Get("^(Test)\\s*(.*)\\.");
+    ASSERT_TRUE(other);
+    EXPECT_NE(first, &*other);
+  }
+  EXPECT_EQ(0u, cache.GetHits());
+  EXPECT_EQ(2u, cache.GetMisses());
+
+  CRegExpCache::Handle reg = cache.Get("^(Test)\\s*(.*)\\.");
+  ASSERT_TRUE(reg);
+  EXPECT_EQ(1u, cache.GetHits());
+  EXPECT_EQ(0, reg->RegFind("Test again."));
+  EXPECT_EQ("again", reg->GetMatch(2));
+}
+
+TEST(TestRegExpCache, Options)
+{
+  CRegExpCache& cache = CRegExpCache::GetInstance();
+  cache.Clear();
+
+  CRegExpCache::Handle sensitive = cache.Get("test");
+  CRegExpCache::Handle insensitive = cache.Get("test", true);
+  ASSERT_TRUE(sensitive);
+  ASSERT_TRUE(insensitive);
+  EXPECT_EQ(-1, sensitive->RegFind("TEST"));
+  EXPECT_EQ(0, insensitive->RegFind("TEST"));
+}
+
+TEST(TestRegExpCache, Failure)
+{
+  CRegExpCache& cache = CRegExpCache::GetInstance();
+  cache.Clear();
+
+  EXPECT_FALSE(cache.Get("(unbalanced"));
+  EXPECT_FALSE(cache.Get("(unbalanced"));
+  EXPECT_EQ(1u, cache.GetHits());
+  EXPECT_EQ(1u, cache.GetMisses());
+}
+
+TEST(TestRegExpCache, Disabled)
+{
+  CRegExpCache& cache = CRegExpCache::GetInstance();
+  cache.Clear();
+  cache.SetEnabled(false);
+
+  {
+    CRegExpCache::Handle reg = cache.Get("a+");
+    ASSERT_TRUE(reg);
+    EXPECT_EQ(1, reg->RegFind("baa"));
+  }
+  EXPECT_TRUE(cache.Get("a+"));
+  EXPECT_EQ(0u, cache.GetHits());
+  EXPECT_EQ(2u, cache.GetMisses());
+
+  cache.SetEnabled(true);
+}
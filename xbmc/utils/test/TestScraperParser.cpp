@@ -7,7 +7,15 @@
  */
 
 #include "test/TestUtils.h"
+#include "utils/RegExpCache.h"
 #include "utils/ScraperParser.h"
+#include "utils/StringUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
 
 #include <gtest/gtest.h>
 
@@ -24,3 +32,46 @@ TEST(TestScraperParser, General)
     a.GetFilename().c_str());
   EXPECT_STREQ("UTF-8", a.GetSearchStringEncoding().c_str());
 }
+
+TEST(TestScraperParser, Benchmark)
+{
+  // replays a recorded scrape: the scraper, the function and the page it got as input
+  const char* scraper = std::getenv("KODI_BENCHMARK_SCRAPER");
+  const char* input = std::getenv("KODI_BENCHMARK_SCRAPER_INPUT");
+  if (!scraper || !input)
+    GTEST_SKIP() << "KODI_BENCHMARK_SCRAPER or KODI_BENCHMARK_SCRAPER_INPUT not set";
+  const char* function = std::getenv("KODI_BENCHMARK_SCRAPER_FUNCTION");
+  if (!function)
+    function = "GetDetails";
+
+  CScraperParser parser;
+  ASSERT_TRUE(parser.Load(scraper));
+
+  std::ifstream file(input, std::ios::binary);
+  ASSERT_TRUE(file.good());
+  std::stringstream page;
+  page << file.rdbuf();
+
+  const int iterations = 100;
+  CRegExpCache& cache = CRegExpCache::GetInstance();
+  std::string results[2];
+  double times[2];
+  for (int pass = 0; pass < 2; pass++)
+  {
+    cache.SetEnabled(pass == 1);
+    cache.Clear();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      parser.m_param[0] = page.str();
+      results[pass] = parser.Parse(function, nullptr);
+    }
+    times[pass] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+  cache.SetEnabled(true);
+
+  EXPECT_EQ(results[0], results[1]);
+  std::cout << StringUtils::Format("{} x {}: uncached {:.1f} ms, cached {:.1f} ms, {} hits, {} misses\n",
+                                   iterations, function, times[0], times[1], cache.GetHits(),
+                                   cache.GetMisses());
+}
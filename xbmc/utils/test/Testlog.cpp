@@ -15,6 +15,8 @@
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <chrono>
+#include <iostream>
 #include <stdlib.h>
 
 #include <gtest/gtest.h>
@@ -100,3 +102,60 @@ TEST_F(Testlog, SetLogLevel)
   CServiceBroker::GetLogging().Uninitialize();
   EXPECT_TRUE(XFILE::CFile::Delete(logfile));
 }
+
+TEST_F(Testlog, AsyncCallCost)
+{
+  constexpr int messages = 5000;
+  std::string logfile, logstring;
+  char buf[100];
+  ssize_t bytesread;
+  XFILE::CFile file;
+  CRegExp regex;
+
+  std::string appName = CCompileInfo::GetAppName();
+  StringUtils::ToLower(appName);
+  logfile = CSpecialProtocol::TranslatePath("special://temp/") + appName + ".log";
+  CServiceBroker::GetLogging().Initialize(
+      CSpecialProtocol::TranslatePath("special://temp/").c_str());
+  EXPECT_TRUE(XFILE::CFile::Exists(logfile));
+
+  // cost per call on the calling thread, formatting and writing included in synchronous mode
+  auto measure = [](const char* mode) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < messages; i++)
+      CLog::Log(LOGDEBUG, "{} benchmark message {} with some payload {:.3f}", mode, i, i * 0.5);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / messages;
+  };
+
+  const auto syncCost = measure("sync");
+
+  CServiceBroker::GetLogging().SetAsync(true, false);
+  EXPECT_TRUE(CServiceBroker::GetLogging().IsAsync());
+  const auto asyncCost = measure("async");
+  CServiceBroker::GetLogging().SetAsync(false, false);
+  EXPECT_FALSE(CServiceBroker::GetLogging().IsAsync());
+
+  std::cout << "log call cost: sync " << syncCost << " ns, async " << asyncCost << " ns"
+            << std::endl;
+  RecordProperty("SyncNsPerCall", std::to_string(syncCost));
+  RecordProperty("AsyncNsPerCall", std::to_string(asyncCost));
+
+  CServiceBroker::GetLogging().Uninitialize();
+
+  EXPECT_TRUE(file.Open(logfile));
+  while ((bytesread = file.Read(buf, sizeof(buf) - 1)) > 0)
+  {
+    buf[bytesread] = '\0';
+    logstring.append(buf);
+  }
+  file.Close();
+
+  // nothing may get lost when blocking on overflow
+  EXPECT_TRUE(regex.RegComp(".*DEBUG <general>: sync benchmark message 4999 .*"));
+  EXPECT_GE(regex.RegFind(logstring), 0);
+  EXPECT_TRUE(regex.RegComp(".*DEBUG <general>: async benchmark message 4999 .*"));
+  EXPECT_GE(regex.RegFind(logstring), 0);
+
+  EXPECT_TRUE(XFILE::CFile::Delete(logfile));
+}
@@ -47,6 +47,7 @@
 #include "utils/FileUtils.h"
 #include "utils/GroupUtils.h"
 #include "utils/LabelFormatter.h"
+#include "utils/RandomIdCache.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
@@ -69,6 +70,88 @@ using namespace ADDON;
 using namespace KODI::MESSAGING;
 using namespace KODI::GUILIB;
 
+namespace
+{
+
+// name of the column of a VIDEODB_ID_* field
+std::string VideoColumn(int id)
+{
+  return StringUtils::Format("c{:02}", id);
+}
+
+// The episode and watched counts of tv shows and seasons are kept in tvshowstats and seasonstats
+// by triggers, instead of aggregating all episodes whenever a show or season is listed. MAX and
+// COUNT(DISTINCT) can't be maintained incrementally, so the triggers recompute the statistics
+// of the affected shows and seasons only.
+
+// showFilter is a list of or a subquery returning idShow, condition limits when to recompute
+std::string ReplaceTvShowStatsSQL(const std::string& showFilter, const std::string& condition = "")
+{
+  return StringUtils::Format(
+      "REPLACE INTO tvshowstats (idShow, lastPlayed, totalCount, watchedcount, totalSeasons, dateAdded) "
+      "SELECT tvshow.idShow, MAX(files.lastPlayed), NULLIF(COUNT(episode.c{0:02}), 0), "
+      "COUNT(files.playCount), NULLIF(COUNT(DISTINCT(episode.c{0:02})), 0), MAX(files.dateAdded) "
+      "FROM tvshow "
+      "LEFT JOIN episode ON episode.idShow=tvshow.idShow "
+      "LEFT JOIN files ON files.idFile=episode.idFile "
+      "WHERE tvshow.idShow IN ({1}){2} "
+      "GROUP BY tvshow.idShow",
+      VIDEODB_ID_EPISODE_SEASON, showFilter, condition.empty() ? "" : " AND " + condition);
+}
+
+// Returns the statement for a trigger body
+std::string UpdateTvShowStatsSQL(const std::string& showFilter, const std::string& condition = "")
+{
+  return ReplaceTvShowStatsSQL(showFilter, condition) + "; ";
+}
+
+std::string SeasonStatsWhere(const std::string& seasonFilter, const std::string& condition)
+{
+  return StringUtils::Format("WHERE seasons.idSeason IN ({}){}", seasonFilter,
+                             condition.empty() ? "" : " AND " + condition);
+}
+
+std::string InsertSeasonStatsSQL(const std::string& seasonFilter, const std::string& condition = "")
+{
+  // seasons without episodes get no statistics, like in the former aggregating season_view
+  return StringUtils::Format(
+      "INSERT INTO seasonstats (idSeason, episodes, playCount, aired) "
+      "SELECT seasons.idSeason, COUNT(DISTINCT episode.idEpisode), COUNT(files.playCount), "
+      "MIN(episode.c{1:02}) "
+      "FROM seasons "
+      "JOIN episode ON episode.idShow=seasons.idShow AND episode.c{2:02}=seasons.season "
+      "JOIN files ON files.idFile=episode.idFile "
+      "{0} "
+      "GROUP BY seasons.idSeason",
+      SeasonStatsWhere(seasonFilter, condition), VIDEODB_ID_EPISODE_AIRED,
+      VIDEODB_ID_EPISODE_SEASON);
+}
+
+// seasonFilter is a list of or a subquery returning idSeason, condition limits when to recompute.
+// Returns the statements for a trigger body.
+std::string UpdateSeasonStatsSQL(const std::string& seasonFilter, const std::string& condition = "")
+{
+  return StringUtils::Format("DELETE FROM seasonstats WHERE idSeason IN (SELECT seasons.idSeason FROM seasons {}); ",
+                             SeasonStatsWhere(seasonFilter, condition)) +
+         InsertSeasonStatsSQL(seasonFilter, condition) + "; ";
+}
+
+std::string SeasonOfEpisodeSQL(const char* row)
+{
+  return StringUtils::Format("SELECT idSeason FROM seasons WHERE idShow={0}.idShow AND season={0}.c{1:02}",
+                             row, VIDEODB_ID_EPISODE_SEASON);
+}
+
+std::string SeasonsOfFileSQL(const char* row)
+{
+  return StringUtils::Format("SELECT seasons.idSeason FROM seasons "
+                             "JOIN episode ON episode.idShow=seasons.idShow AND episode.c{1:02}=seasons.season "
+                             "WHERE episode.idFile={0}.idFile",
+                             row, VIDEODB_ID_EPISODE_SEASON);
+}
+
+} // unnamed namespace
+
 //********************************************************************************************************************************
 CVideoDatabase::CVideoDatabase(void) = default;
 
@@ -181,6 +264,13 @@ void CVideoDatabase::CreateTables()
   CLog::Log(LOGINFO, "create seasons table");
   m_pDS->exec("CREATE TABLE seasons ( idSeason integer primary key, idShow integer, season integer, name text, userrating integer)");
 
+  CLog::Log(LOGINFO, "create tvshowstats table");
+  m_pDS->exec("CREATE TABLE tvshowstats ( idShow integer primary key, lastPlayed text, totalCount integer, "
+              "watchedcount integer, totalSeasons integer, dateAdded text)");
+
+  CLog::Log(LOGINFO, "create seasonstats table");
+  m_pDS->exec("CREATE TABLE seasonstats ( idSeason integer primary key, episodes integer, playCount integer, aired text)");
+
   CLog::Log(LOGINFO, "create art table");
   m_pDS->exec("CREATE TABLE art(art_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, type TEXT, url TEXT)");
 
@@ -302,6 +392,7 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM tag_link WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM rating WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM uniqueid WHERE media_id=old.idShow AND media_type='tvshow'; "
+              "DELETE FROM tvshowstats WHERE idShow=old.idShow; "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_musicvideo AFTER DELETE ON musicvideo FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
@@ -317,10 +408,13 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM writer_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM art WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM rating WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; "
+              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; " +
+              UpdateTvShowStatsSQL("old.idShow") +
+              UpdateSeasonStatsSQL(SeasonOfEpisodeSQL("old")) +
               "END");
   m_pDS->exec("CREATE TRIGGER delete_season AFTER DELETE ON seasons FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSeason AND media_type='season'; "
+              "DELETE FROM seasonstats WHERE idSeason=old.idSeason; "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_set AFTER DELETE ON sets FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSet AND media_type='set'; "
@@ -335,9 +429,62 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM bookmark WHERE idFile=old.idFile; "
               "DELETE FROM settings WHERE idFile=old.idFile; "
               "DELETE FROM stacktimes WHERE idFile=old.idFile; "
-              "DELETE FROM streamdetails WHERE idFile=old.idFile; "
+              "DELETE FROM streamdetails WHERE idFile=old.idFile; " +
+              UpdateTvShowStatsSQL("SELECT idShow FROM episode WHERE idFile=old.idFile") +
+              UpdateSeasonStatsSQL(SeasonsOfFileSQL("old")) +
+              "END");
+
+  // keep tvshowstats and seasonstats up to date, see UpdateTvShowStatsSQL()
+  m_pDS->exec("CREATE TRIGGER insert_tvshow AFTER INSERT ON tvshow FOR EACH ROW BEGIN " +
+              UpdateTvShowStatsSQL("new.idShow") +
+              "END");
+  m_pDS->exec("CREATE TRIGGER insert_season AFTER INSERT ON seasons FOR EACH ROW BEGIN " +
+              UpdateSeasonStatsSQL("new.idSeason") +
+              "END");
+  const std::string seasonChanged = "(old.idShow<>new.idShow OR old.season<>new.season)";
+  m_pDS->exec("CREATE TRIGGER update_season AFTER UPDATE ON seasons FOR EACH ROW BEGIN " +
+              UpdateSeasonStatsSQL("new.idSeason", seasonChanged) +
+              "END");
+  m_pDS->exec("CREATE TRIGGER insert_episode AFTER INSERT ON episode FOR EACH ROW BEGIN " +
+              UpdateTvShowStatsSQL("new.idShow") +
+              UpdateSeasonStatsSQL(SeasonOfEpisodeSQL("new")) +
+              "END");
+  const std::string episodeChanged = StringUtils::Format(
+      "(COALESCE(old.idShow,-1)<>COALESCE(new.idShow,-1) OR COALESCE(old.idFile,-1)<>COALESCE(new.idFile,-1) OR "
+      "COALESCE(old.c{0:02},'')<>COALESCE(new.c{0:02},'') OR COALESCE(old.c{1:02},'')<>COALESCE(new.c{1:02},''))",
+      VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_EPISODE_AIRED);
+  m_pDS->exec("CREATE TRIGGER update_episode AFTER UPDATE ON episode FOR EACH ROW BEGIN " +
+              UpdateTvShowStatsSQL("old.idShow, new.idShow", episodeChanged) +
+              UpdateSeasonStatsSQL(SeasonOfEpisodeSQL("old"), episodeChanged) +
+              UpdateSeasonStatsSQL(SeasonOfEpisodeSQL("new"), episodeChanged) +
+              "END");
+  m_pDS->exec("CREATE TRIGGER insert_file AFTER INSERT ON files FOR EACH ROW BEGIN " +
+              UpdateTvShowStatsSQL("SELECT idShow FROM episode WHERE idFile=new.idFile") +
+              UpdateSeasonStatsSQL(SeasonsOfFileSQL("new")) +
+              "END");
+  const std::string fileChanged = "(COALESCE(old.playCount,-1)<>COALESCE(new.playCount,-1) OR "
+                                  "COALESCE(old.lastPlayed,'')<>COALESCE(new.lastPlayed,'') OR "
+                                  "COALESCE(old.dateAdded,'')<>COALESCE(new.dateAdded,''))";
+  m_pDS->exec("CREATE TRIGGER update_file AFTER UPDATE ON files FOR EACH ROW BEGIN " +
+              UpdateTvShowStatsSQL("SELECT idShow FROM episode WHERE idFile=new.idFile", fileChanged) +
+              UpdateSeasonStatsSQL(SeasonsOfFileSQL("new"), fileChanged) +
               "END");
 
+  // SQLite only, searches fall back to LIKE without them
+  CLog::Log(LOGINFO, "%s - creating full text indexes", __FUNCTION__);
+  CreateFullTextIndex("moviesearch", "movie", "idMovie",
+                      {VideoColumn(VIDEODB_ID_TITLE), VideoColumn(VIDEODB_ID_PLOT),
+                       VideoColumn(VIDEODB_ID_PLOTOUTLINE), VideoColumn(VIDEODB_ID_TAGLINE)});
+  CreateFullTextIndex("tvshowsearch", "tvshow", "idShow", {VideoColumn(VIDEODB_ID_TV_TITLE)});
+  CreateFullTextIndex("episodesearch", "episode", "idEpisode",
+                      {VideoColumn(VIDEODB_ID_EPISODE_TITLE), VideoColumn(VIDEODB_ID_EPISODE_PLOT)});
+  CreateFullTextIndex("musicvideosearch", "musicvideo", "idMVideo",
+                      {VideoColumn(VIDEODB_ID_MUSICVIDEO_TITLE), VideoColumn(VIDEODB_ID_MUSICVIDEO_ALBUM)});
+  CreateFullTextIndex("actorsearch", "actor", "actor_id", {"name"});
+
+  // results of smart playlists, stored when they are first opened
+  CreateSmartPlaylistCache();
+
   CreateViews();
 }
 
@@ -385,22 +532,6 @@ void CVideoDatabase::CreateViews()
                                       VIDEODB_ID_EPISODE_IDENT_ID);
   m_pDS->exec(episodeview);
 
-  CLog::Log(LOGINFO, "create tvshowcounts");
-  std::string tvshowcounts = PrepareSQL("CREATE VIEW tvshowcounts AS SELECT "
-                                       "      tvshow.idShow AS idShow,"
-                                       "      MAX(files.lastPlayed) AS lastPlayed,"
-                                       "      NULLIF(COUNT(episode.c12), 0) AS totalCount,"
-                                       "      COUNT(files.playCount) AS watchedcount,"
-                                       "      NULLIF(COUNT(DISTINCT(episode.c12)), 0) AS totalSeasons, "
-                                       "      MAX(files.dateAdded) as dateAdded "
-                                       "    FROM tvshow"
-                                       "      LEFT JOIN episode ON"
-                                       "        episode.idShow=tvshow.idShow"
-                                       "      LEFT JOIN files ON"
-                                       "        files.idFile=episode.idFile "
-                                       "GROUP BY tvshow.idShow");
-  m_pDS->exec(tvshowcounts);
-
   CLog::Log(LOGINFO, "create tvshowlinkpath_minview");
   // This view only exists to workaround a limitation in MySQL <5.7 which is not able to
   // perform subqueries in joins.
@@ -420,8 +551,11 @@ void CVideoDatabase::CreateViews()
                                      "  tvshow.*,"
                                      "  path.idParentPath AS idParentPath,"
                                      "  path.strPath AS strPath,"
-                                     "  tvshowcounts.dateAdded AS dateAdded,"
-                                     "  lastPlayed, totalCount, watchedcount, totalSeasons, "
+                                     "  tvshowstats.dateAdded AS dateAdded,"
+                                     "  tvshowstats.lastPlayed AS lastPlayed,"
+                                     "  tvshowstats.totalCount AS totalCount,"
+                                     "  tvshowstats.watchedcount AS watchedcount,"
+                                     "  tvshowstats.totalSeasons AS totalSeasons, "
                                      "  rating.rating AS rating, "
                                      "  rating.votes AS votes, "
                                      "  rating.rating_type AS rating_type, "
@@ -432,8 +566,8 @@ void CVideoDatabase::CreateViews()
                                      "    tvshowlinkpath_minview.idShow=tvshow.idShow"
                                      "  LEFT JOIN path ON"
                                      "    path.idPath=tvshowlinkpath_minview.idPath"
-                                     "  INNER JOIN tvshowcounts ON"
-                                     "    tvshow.idShow = tvshowcounts.idShow "
+                                     "  LEFT JOIN tvshowstats ON"
+                                     "    tvshowstats.idShow=tvshow.idShow "
                                      "  LEFT JOIN rating ON"
                                      "    rating.rating_id=tvshow.c%02d "
                                      "  LEFT JOIN uniqueid ON"
@@ -455,31 +589,14 @@ void CVideoDatabase::CreateViews()
                                      "  tvshow_view.c%02d AS genre,"
                                      "  tvshow_view.c%02d AS studio,"
                                      "  tvshow_view.c%02d AS mpaa,"
-                                     "  count(DISTINCT episode.idEpisode) AS episodes,"
-                                     "  count(files.playCount) AS playCount,"
-                                     "  min(episode.c%02d) AS aired "
+                                     "  seasonstats.episodes AS episodes,"
+                                     "  seasonstats.playCount AS playCount,"
+                                     "  seasonstats.aired AS aired "
                                      "FROM seasons"
                                      "  JOIN tvshow_view ON"
                                      "    tvshow_view.idShow = seasons.idShow"
-                                     "  JOIN episode ON"
-                                     "    episode.idShow = seasons.idShow AND episode.c%02d = seasons.season"
-                                     "  JOIN files ON"
-                                     "    files.idFile = episode.idFile "
-                                     "GROUP BY seasons.idSeason,"
-                                     "         seasons.idShow,"
-                                     "         seasons.season,"
-                                     "         seasons.name,"
-                                     "         seasons.userrating,"
-                                     "         tvshow_view.strPath,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d,"
-                                     "         tvshow_view.c%02d ",
-                                     VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_PLOT, VIDEODB_ID_TV_PREMIERED,
-                                     VIDEODB_ID_TV_GENRE, VIDEODB_ID_TV_STUDIOS, VIDEODB_ID_TV_MPAA,
-                                     VIDEODB_ID_EPISODE_AIRED, VIDEODB_ID_EPISODE_SEASON,
+                                     "  JOIN seasonstats ON"
+                                     "    seasonstats.idSeason = seasons.idSeason",
                                      VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_PLOT, VIDEODB_ID_TV_PREMIERED,
                                      VIDEODB_ID_TV_GENRE, VIDEODB_ID_TV_STUDIOS, VIDEODB_ID_TV_MPAA);
   m_pDS->exec(seasonview);
@@ -1355,6 +1472,8 @@ int CVideoDatabase::AddMovie(const std::string& strFilenameAndPath)
       std::string strSQL=PrepareSQL("insert into movie (idMovie, idFile) values (NULL, %i)", idFile);
       m_pDS->exec(strSQL);
       idMovie = (int)m_pDS->lastinsertid();
+      // the candidates of random draws changed, even if not their number
+      CRandomIdCache::GetInstance().Clear();
     }
 
     return idMovie;
@@ -1408,7 +1527,10 @@ bool CVideoDatabase::AddPathToTvShow(int idShow, const std::string &path, const
 int CVideoDatabase::AddTvShow()
 {
   if (ExecuteQuery("INSERT INTO tvshow(idShow) VALUES(NULL)"))
+  {
+    CRandomIdCache::GetInstance().Clear();
     return (int)m_pDS->lastinsertid();
+  }
   return -1;
 }
 
@@ -1429,6 +1551,7 @@ int CVideoDatabase::AddEpisode(int idShow, const std::string& strFilenameAndPath
 
     std::string strSQL=PrepareSQL("insert into episode (idEpisode, idFile, idShow) values (NULL, %i, %i)", idFile, idShow);
     m_pDS->exec(strSQL);
+    CRandomIdCache::GetInstance().Clear();
     return (int)m_pDS->lastinsertid();
   }
   catch (...)
@@ -1456,6 +1579,7 @@ int CVideoDatabase::AddMusicVideo(const std::string& strFilenameAndPath)
       UpdateFileDateAdded(idFile, strFilenameAndPath);
       std::string strSQL=PrepareSQL("insert into musicvideo (idMVideo, idFile) values (NULL, %i)", idFile);
       m_pDS->exec(strSQL);
+      CRandomIdCache::GetInstance().Clear();
       idMVideo = (int)m_pDS->lastinsertid();
     }
 
@@ -1808,6 +1932,7 @@ void CVideoDatabase::AddTagToItem(int media_id, int tag_id, const std::string &t
     return;
 
   AddToLinkTable(media_id, type, "tag", tag_id);
+  UpdateSmartPlaylistsForItem(media_id, type);
 }
 
 void CVideoDatabase::RemoveTagFromItem(int media_id, int tag_id, const std::string &type)
@@ -1816,6 +1941,7 @@ void CVideoDatabase::RemoveTagFromItem(int media_id, int tag_id, const std::stri
     return;
 
   RemoveFromLinkTable(media_id, type, "tag", tag_id);
+  UpdateSmartPlaylistsForItem(media_id, type);
 }
 
 void CVideoDatabase::RemoveTagsFromItem(int media_id, const std::string &type)
@@ -2505,6 +2631,7 @@ int CVideoDatabase::SetDetailsForMovie(const std::string& strFilenameAndPath, CV
       sql += PrepareSQL(", premiered = '%i'", details.GetYear());
     sql += PrepareSQL(" where idMovie=%i", idMovie);
     m_pDS->exec(sql);
+    UpdateSmartPlaylistsForItem(idMovie, MediaTypeMovie);
     CommitTransaction();
 
     return idMovie;
@@ -2700,6 +2827,7 @@ int CVideoDatabase::SetDetailsForTvShow(const std::vector<std::pair<std::string,
     AddPathToTvShow(idTvShow, i.first, i.second, details.m_dateAdded);
 
   UpdateDetailsForTvShow(idTvShow, details, artwork, seasonArt);
+  UpdateSmartPlaylistsForItem(idTvShow, MediaTypeTvShow);
 
   return idTvShow;
 }
@@ -2903,6 +3031,7 @@ int CVideoDatabase::SetDetailsForEpisode(const std::string& strFilenameAndPath,
     sql += PrepareSQL(", idSeason = %i", idSeason);
     sql += PrepareSQL(" where idEpisode=%i", idEpisode);
     m_pDS->exec(sql);
+    UpdateSmartPlaylistsForItem(idEpisode, MediaTypeEpisode);
     CommitTransaction();
 
     return idEpisode;
@@ -2994,6 +3123,7 @@ int CVideoDatabase::SetDetailsForMusicVideo(const std::string& strFilenameAndPat
       sql += PrepareSQL(", premiered = '%i'", details.GetYear());
     sql += PrepareSQL(" where idMVideo=%i", idMVideo);
     m_pDS->exec(sql);
+    UpdateSmartPlaylistsForItem(idMVideo, MediaTypeMusicVideo);
     CommitTransaction();
 
     return idMVideo;
@@ -3302,6 +3432,8 @@ void CVideoDatabase::AddBookMarkToFile(const std::string& strFilenameAndPath, co
       strSQL=PrepareSQL("insert into bookmark (idBookmark, idFile, timeInSeconds, totalTimeInSeconds, thumbNailImage, player, playerState, type) values(NULL,%i,%f,%f,'%s','%s','%s', %i)", idFile, bookmark.timeInSeconds, bookmark.totalTimeInSeconds, bookmark.thumbNailImage.c_str(), bookmark.player.c_str(), bookmark.playerState.c_str(), (int)type);
 
     m_pDS->exec(strSQL);
+    if (type == CBookmark::RESUME)
+      UpdateSmartPlaylistsForFile(idFile);
   }
   catch (...)
   {
@@ -3337,6 +3469,8 @@ void CVideoDatabase::ClearBookMarkOfFile(const std::string& strFilenameAndPath,
         strSQL=PrepareSQL("update episode set c%02d=-1 where idFile=%i and c%02d=%i", VIDEODB_ID_EPISODE_BOOKMARK, idFile, VIDEODB_ID_EPISODE_BOOKMARK, idBookmark);
         m_pDS->exec(strSQL);
       }
+      else if (type == CBookmark::RESUME)
+        UpdateSmartPlaylistsForFile(idFile);
     }
 
     m_pDS->close();
@@ -3374,6 +3508,8 @@ void CVideoDatabase::ClearBookMarksOfFile(int idFile, CBookmark::EType type /*=
       strSQL=PrepareSQL("update episode set c%02d=-1 where idFile=%i", VIDEODB_ID_EPISODE_BOOKMARK, idFile);
       m_pDS->exec(strSQL);
     }
+    else if (type == CBookmark::RESUME)
+      UpdateSmartPlaylistsForFile(idFile);
   }
   catch (...)
   {
@@ -3481,6 +3617,7 @@ void CVideoDatabase::DeleteMovie(int idMovie, bool bKeepId /* = false */)
 
       std::string strSQL = PrepareSQL("delete from movie where idMovie=%i", idMovie);
       m_pDS->exec(strSQL);
+      CRandomIdCache::GetInstance().Clear();
     }
 
     //! @todo move this below CommitTransaction() once UPnP doesn't rely on this anymore
@@ -3539,6 +3676,7 @@ void CVideoDatabase::DeleteTvShow(int idTvShow, bool bKeepId /* = false */)
     {
       strSQL=PrepareSQL("delete from tvshow where idShow=%i", idTvShow);
       m_pDS->exec(strSQL);
+      CRandomIdCache::GetInstance().Clear();
 
       for (const auto &i : paths)
       {
@@ -3627,8 +3765,12 @@ void CVideoDatabase::DeleteEpisode(int idEpisode, bool bKeepId /* = false */)
       if (!path.empty())
         InvalidatePathHash(path);
 
+      // the episode counts of its show change
+      int idShow = GetDbId(PrepareSQL("SELECT idShow FROM episode WHERE idEpisode=%i", idEpisode));
       std::string strSQL = PrepareSQL("delete from episode where idEpisode=%i", idEpisode);
       m_pDS->exec(strSQL);
+      CRandomIdCache::GetInstance().Clear();
+      UpdateSmartPlaylistsForItem(idShow, MediaTypeTvShow);
     }
 
   }
@@ -3670,6 +3812,7 @@ void CVideoDatabase::DeleteMusicVideo(int idMVideo, bool bKeepId /* = false */)
 
       std::string strSQL = PrepareSQL("delete from musicvideo where idMVideo=%i", idMVideo);
       m_pDS->exec(strSQL);
+      CRandomIdCache::GetInstance().Clear();
     }
 
     //! @todo move this below CommitTransaction() once UPnP doesn't rely on this anymore
@@ -5672,11 +5815,72 @@ void CVideoDatabase::UpdateTables(int iVersion)
     }
     m_pDS->close();
   }
+
+  if (iVersion < 118)
+  {
+    // the aggregating tvshowcounts view is replaced by trigger maintained tables
+    m_pDS->exec("CREATE TABLE tvshowstats ( idShow integer primary key, lastPlayed text, totalCount integer, "
+                "watchedcount integer, totalSeasons integer, dateAdded text)");
+    m_pDS->exec("CREATE TABLE seasonstats ( idSeason integer primary key, episodes integer, playCount integer, aired text)");
+    m_pDS->exec(ReplaceTvShowStatsSQL("SELECT idShow FROM tvshow"));
+    m_pDS->exec(InsertSeasonStatsSQL("SELECT idSeason FROM seasons"));
+  }
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 117;
+  return 120;
+}
+
+bool CVideoDatabase::GetSmartPlaylistSource(const std::string &type, std::string &view, std::string &idColumn) const
+{
+  if (type == "movies")
+  {
+    view = "movie_view";
+    idColumn = "idMovie";
+  }
+  else if (type == "tvshows")
+  {
+    view = "tvshow_view";
+    idColumn = "idShow";
+  }
+  else if (type == "episodes")
+  {
+    view = "episode_view";
+    idColumn = "idEpisode";
+  }
+  else if (type == "musicvideos")
+  {
+    view = "musicvideo_view";
+    idColumn = "idMVideo";
+  }
+  else
+    return false;
+
+  return true;
+}
+
+void CVideoDatabase::UpdateSmartPlaylistsForItem(int id, const MediaType &mediaType)
+{
+  if (mediaType == MediaTypeMovie)
+    UpdateSmartPlaylistItems("movies", PrepareSQL("movie_view.idMovie = %i", id));
+  else if (mediaType == MediaTypeTvShow)
+    UpdateSmartPlaylistItems("tvshows", PrepareSQL("tvshow_view.idShow = %i", id));
+  else if (mediaType == MediaTypeEpisode)
+  {
+    UpdateSmartPlaylistItems("episodes", PrepareSQL("episode_view.idEpisode = %i", id));
+    UpdateSmartPlaylistItems("tvshows", PrepareSQL("tvshow_view.idShow IN (SELECT idShow FROM episode WHERE idEpisode = %i)", id));
+  }
+  else if (mediaType == MediaTypeMusicVideo)
+    UpdateSmartPlaylistItems("musicvideos", PrepareSQL("musicvideo_view.idMVideo = %i", id));
+}
+
+void CVideoDatabase::UpdateSmartPlaylistsForFile(int idFile)
+{
+  UpdateSmartPlaylistItems("movies", PrepareSQL("movie_view.idFile = %i", idFile));
+  UpdateSmartPlaylistItems("episodes", PrepareSQL("episode_view.idFile = %i", idFile));
+  UpdateSmartPlaylistItems("tvshows", PrepareSQL("tvshow_view.idShow IN (SELECT idShow FROM episode WHERE idFile = %i)", idFile));
+  UpdateSmartPlaylistItems("musicvideos", PrepareSQL("musicvideo_view.idFile = %i", idFile));
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -5897,6 +6101,7 @@ void CVideoDatabase::SetPlayCount(const CFileItem &item, int count, const CDateT
     }
 
     m_pDS->exec(strSQL);
+    UpdateSmartPlaylistsForFile(id);
 
     // We only need to announce changes to video items in the library
     if (item.HasVideoInfoTag() && item.GetVideoInfoTag()->m_iDbId > 0)
@@ -7258,6 +7463,21 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
       total = (int)strtol(GetSingleValue(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, m_pDS).c_str(), NULL, 10);
       strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
     }
+    // Draw random items from a cached permutation of the matching ids rather than fetch all of
+    // them to be shuffled
+    else if (extFilter.limit.empty() && extFilter.group.empty() &&
+             sorting.sortBy == SortByRandom && sorting.limitStart == 0 && sorting.limitEnd > 0)
+    {
+      const std::string condition = GetRandomIdCondition(MediaTypeMovie, "movie_view.idMovie",
+                                                         "movie_view " + strSQLExtra, sorting.limitEnd, total);
+      if (!condition.empty())
+      {
+        extFilter.AppendWhere(condition);
+        strSQLExtra.clear();
+        if (!CDatabase::BuildSQL(strSQLExtra, extFilter, strSQLExtra))
+          return false;
+      }
+    }
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
@@ -7369,6 +7589,21 @@ bool CVideoDatabase::GetTvShowsByWhere(const std::string& strBaseDir, const Filt
       total = (int)strtol(GetSingleValue(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, m_pDS).c_str(), NULL, 10);
       strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
     }
+    // Draw random items from a cached permutation of the matching ids rather than fetch all of
+    // them to be shuffled
+    else if (extFilter.limit.empty() && extFilter.group.empty() &&
+             sorting.sortBy == SortByRandom && sorting.limitStart == 0 && sorting.limitEnd > 0)
+    {
+      const std::string condition = GetRandomIdCondition(MediaTypeTvShow, "tvshow_view.idShow",
+                                                         "tvshow_view " + strSQLExtra, sorting.limitEnd, total);
+      if (!condition.empty())
+      {
+        extFilter.AppendWhere(condition);
+        strSQLExtra.clear();
+        if (!CDatabase::BuildSQL(strSQLExtra, extFilter, strSQLExtra))
+          return false;
+      }
+    }
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
@@ -7497,6 +7732,21 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
       total = (int)strtol(GetSingleValue(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, m_pDS).c_str(), NULL, 10);
       strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
     }
+    // Draw random items from a cached permutation of the matching ids rather than fetch all of
+    // them to be shuffled
+    else if (extFilter.limit.empty() && extFilter.group.empty() &&
+             sorting.sortBy == SortByRandom && sorting.limitStart == 0 && sorting.limitEnd > 0)
+    {
+      const std::string condition = GetRandomIdCondition(MediaTypeEpisode, "episode_view.idEpisode",
+                                                         "episode_view " + strSQLExtra, sorting.limitEnd, total);
+      if (!condition.empty())
+      {
+        extFilter.AppendWhere(condition);
+        strSQLExtra.clear();
+        if (!CDatabase::BuildSQL(strSQLExtra, extFilter, strSQLExtra))
+          return false;
+      }
+    }
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
@@ -8083,9 +8333,9 @@ void CVideoDatabase::GetMovieActorsByName(const std::string& strSearch, CFileIte
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL=PrepareSQL("SELECT actor.actor_id, actor.name, path.strPath FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN movie ON actor_link.media_id=movie.idMovie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE actor_link.media_type='movie' AND actor.name LIKE '%%%s%%'", strSearch.c_str());
+      strSQL=PrepareSQL("SELECT actor.actor_id, actor.name, path.strPath FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN movie ON actor_link.media_id=movie.idMovie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE actor_link.media_type='movie' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
     else
-      strSQL=PrepareSQL("SELECT DISTINCT actor.actor_id, actor.name FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN movie ON actor_link.media_id=movie.idMovie WHERE actor_link.media_type='movie' AND actor.name LIKE '%%%s%%'", strSearch.c_str());
+      strSQL=PrepareSQL("SELECT DISTINCT actor.actor_id, actor.name FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN movie ON actor_link.media_id=movie.idMovie WHERE actor_link.media_type='movie' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8124,9 +8374,9 @@ void CVideoDatabase::GetTvShowsActorsByName(const std::string& strSearch, CFileI
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL=PrepareSQL("SELECT actor.actor_id, actor.name, path.strPath FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN tvshow ON actor_link.media_id=tvshow.idShow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idPath=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE actor_link.media_type='tvshow' AND actor.name LIKE '%%%s%%'", strSearch.c_str());
+      strSQL=PrepareSQL("SELECT actor.actor_id, actor.name, path.strPath FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN tvshow ON actor_link.media_id=tvshow.idShow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idPath=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE actor_link.media_type='tvshow' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
     else
-      strSQL=PrepareSQL("SELECT DISTINCT actor.actor_id, actor.name FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN tvshow ON actor_link.media_id=tvshow.idShow WHERE actor_link.media_type='tvshow' AND actor.name LIKE '%%%s%%'",strSearch.c_str());
+      strSQL=PrepareSQL("SELECT DISTINCT actor.actor_id, actor.name FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN tvshow ON actor_link.media_id=tvshow.idShow WHERE actor_link.media_type='tvshow' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8166,11 +8416,11 @@ void CVideoDatabase::GetMusicVideoArtistsByName(const std::string& strSearch, CF
 
     std::string strLike;
     if (!strSearch.empty())
-      strLike = "and actor.name like '%%%s%%'";
+      strLike = " AND " + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL=PrepareSQL("SELECT actor.actor_id, actor.name, path.strPath FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN musicvideo ON actor_link.media_id=musicvideo.idMVideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE actor_link.media_type='musicvideo' "+strLike, strSearch.c_str());
+      strSQL=PrepareSQL("SELECT actor.actor_id, actor.name, path.strPath FROM actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id INNER JOIN musicvideo ON actor_link.media_id=musicvideo.idMVideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE actor_link.media_type='musicvideo'") + strLike;
     else
-      strSQL=PrepareSQL("SELECT DISTINCT actor.actor_id, actor.name from actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id WHERE actor_link.media_type='musicvideo' "+strLike,strSearch.c_str());
+      strSQL=PrepareSQL("SELECT DISTINCT actor.actor_id, actor.name from actor INNER JOIN actor_link ON actor_link.actor_id=actor.actor_id WHERE actor_link.media_type='musicvideo'") + strLike;
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8260,7 +8510,7 @@ void CVideoDatabase::GetMusicVideoAlbumsByName(const std::string& strSearch, CFi
                                  " JOIN path ON"
                                  "  path.idPath=files.idPath", VIDEODB_ID_MUSICVIDEO_ALBUM);
     if (!strSearch.empty())
-      strSQL += PrepareSQL(" WHERE musicvideo.c%02d like '%%%s%%'",VIDEODB_ID_MUSICVIDEO_ALBUM, strSearch.c_str());
+      strSQL += " WHERE " + GetFullTextCondition("musicvideosearch", "musicvideo", "idMVideo", {VideoColumn(VIDEODB_ID_MUSICVIDEO_ALBUM)}, strSearch);
 
     m_pDS->query( strSQL );
 
@@ -8306,9 +8556,9 @@ void CVideoDatabase::GetMusicVideosByAlbum(const std::string& strSearch, CFileIt
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d,musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE musicvideo.c%02d LIKE '%%%s%%'", VIDEODB_ID_MUSICVIDEO_ALBUM, VIDEODB_ID_MUSICVIDEO_TITLE, VIDEODB_ID_MUSICVIDEO_ALBUM, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d,musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE ", VIDEODB_ID_MUSICVIDEO_ALBUM, VIDEODB_ID_MUSICVIDEO_TITLE) + GetFullTextCondition("musicvideosearch", "musicvideo", "idMVideo", {VideoColumn(VIDEODB_ID_MUSICVIDEO_ALBUM)}, strSearch);
     else
-      strSQL = PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d,musicvideo.c%02d from musicvideo where musicvideo.c%02d like '%%%s%%'",VIDEODB_ID_MUSICVIDEO_ALBUM,VIDEODB_ID_MUSICVIDEO_TITLE,VIDEODB_ID_MUSICVIDEO_ALBUM,strSearch.c_str());
+      strSQL = PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d,musicvideo.c%02d from musicvideo where ",VIDEODB_ID_MUSICVIDEO_ALBUM,VIDEODB_ID_MUSICVIDEO_TITLE) + GetFullTextCondition("musicvideosearch", "musicvideo", "idMVideo", {VideoColumn(VIDEODB_ID_MUSICVIDEO_ALBUM)}, strSearch);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8366,6 +8616,21 @@ bool CVideoDatabase::GetMusicVideosByWhere(const std::string &baseDir, const Fil
       total = (int)strtol(GetSingleValue(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, m_pDS).c_str(), NULL, 10);
       strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
     }
+    // Draw random items from a cached permutation of the matching ids rather than fetch all of
+    // them to be shuffled
+    else if (extFilter.limit.empty() && extFilter.group.empty() &&
+             sorting.sortBy == SortByRandom && sorting.limitStart == 0 && sorting.limitEnd > 0)
+    {
+      const std::string condition = GetRandomIdCondition(MediaTypeMusicVideo, "musicvideo_view.idMVideo",
+                                                         "musicvideo_view " + strSQLExtra, sorting.limitEnd, total);
+      if (!condition.empty())
+      {
+        extFilter.AppendWhere(condition);
+        strSQLExtra.clear();
+        if (!CDatabase::BuildSQL(strSQLExtra, extFilter, strSQLExtra))
+          return false;
+      }
+    }
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
@@ -8431,7 +8696,6 @@ unsigned int CVideoDatabase::GetRandomMusicVideoIDs(const std::string& strWhere,
     std::string strSQL = "select distinct idMVideo from musicvideo_view";
     if (!strWhere.empty())
       strSQL += " where " + strWhere;
-    strSQL += PrepareSQL(" ORDER BY RANDOM()");
 
     if (!m_pDS->query(strSQL)) return 0;
     songIDs.clear();
@@ -8515,9 +8779,9 @@ void CVideoDatabase::GetMoviesByName(const std::string& strSearch, CFileItemList
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT movie.idMovie, movie.c%02d, path.strPath, movie.idSet FROM movie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE movie.c%02d LIKE '%%%s%%'", VIDEODB_ID_TITLE, VIDEODB_ID_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT movie.idMovie, movie.c%02d, path.strPath, movie.idSet FROM movie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE ", VIDEODB_ID_TITLE) + GetFullTextCondition("moviesearch", "movie", "idMovie", {VideoColumn(VIDEODB_ID_TITLE)}, strSearch);
     else
-      strSQL = PrepareSQL("select movie.idMovie,movie.c%02d, movie.idSet from movie where movie.c%02d like '%%%s%%'",VIDEODB_ID_TITLE,VIDEODB_ID_TITLE,strSearch.c_str());
+      strSQL = PrepareSQL("select movie.idMovie,movie.c%02d, movie.idSet from movie where ",VIDEODB_ID_TITLE) + GetFullTextCondition("moviesearch", "movie", "idMovie", {VideoColumn(VIDEODB_ID_TITLE)}, strSearch);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8562,9 +8826,9 @@ void CVideoDatabase::GetTvShowsByName(const std::string& strSearch, CFileItemLis
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT tvshow.idShow, tvshow.c%02d, path.strPath FROM tvshow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE tvshow.c%02d LIKE '%%%s%%'", VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT tvshow.idShow, tvshow.c%02d, path.strPath FROM tvshow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE ", VIDEODB_ID_TV_TITLE) + GetFullTextCondition("tvshowsearch", "tvshow", "idShow", {VideoColumn(VIDEODB_ID_TV_TITLE)}, strSearch);
     else
-      strSQL = PrepareSQL("select tvshow.idShow,tvshow.c%02d from tvshow where tvshow.c%02d like '%%%s%%'",VIDEODB_ID_TV_TITLE,VIDEODB_ID_TV_TITLE,strSearch.c_str());
+      strSQL = PrepareSQL("select tvshow.idShow,tvshow.c%02d from tvshow where ",VIDEODB_ID_TV_TITLE) + GetFullTextCondition("tvshowsearch", "tvshow", "idShow", {VideoColumn(VIDEODB_ID_TV_TITLE)}, strSearch);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8605,9 +8869,9 @@ void CVideoDatabase::GetEpisodesByName(const std::string& strSearch, CFileItemLi
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath WHERE episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath WHERE ", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE) + GetFullTextCondition("episodesearch", "episode", "idEpisode", {VideoColumn(VIDEODB_ID_EPISODE_TITLE)}, strSearch);
     else
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow WHERE episode.c%02d like '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow WHERE ", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE) + GetFullTextCondition("episodesearch", "episode", "idEpisode", {VideoColumn(VIDEODB_ID_EPISODE_TITLE)}, strSearch);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8650,9 +8914,9 @@ void CVideoDatabase::GetMusicVideosByName(const std::string& strSearch, CFileIte
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE musicvideo.c%02d LIKE '%%%s%%'", VIDEODB_ID_MUSICVIDEO_TITLE, VIDEODB_ID_MUSICVIDEO_TITLE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE ", VIDEODB_ID_MUSICVIDEO_TITLE) + GetFullTextCondition("musicvideosearch", "musicvideo", "idMVideo", {VideoColumn(VIDEODB_ID_MUSICVIDEO_TITLE)}, strSearch);
     else
-      strSQL = PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d from musicvideo where musicvideo.c%02d like '%%%s%%'",VIDEODB_ID_MUSICVIDEO_TITLE,VIDEODB_ID_MUSICVIDEO_TITLE,strSearch.c_str());
+      strSQL = PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d from musicvideo where ",VIDEODB_ID_MUSICVIDEO_TITLE) + GetFullTextCondition("musicvideosearch", "musicvideo", "idMVideo", {VideoColumn(VIDEODB_ID_MUSICVIDEO_TITLE)}, strSearch);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8699,9 +8963,9 @@ void CVideoDatabase::GetEpisodesByPlot(const std::string& strSearch, CFileItemLi
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath WHERE episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_PLOT, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath WHERE ", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE) + GetFullTextCondition("episodesearch", "episode", "idEpisode", {VideoColumn(VIDEODB_ID_EPISODE_PLOT)}, strSearch);
     else
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow WHERE episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_PLOT, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow WHERE ", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE) + GetFullTextCondition("episodesearch", "episode", "idEpisode", {VideoColumn(VIDEODB_ID_EPISODE_PLOT)}, strSearch);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8740,9 +9004,9 @@ void CVideoDatabase::GetMoviesByPlot(const std::string& strSearch, CFileItemList
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("select movie.idMovie, movie.c%02d, path.strPath FROM movie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%'", VIDEODB_ID_TITLE,VIDEODB_ID_PLOT, strSearch.c_str(), VIDEODB_ID_PLOTOUTLINE, strSearch.c_str(), VIDEODB_ID_TAGLINE,strSearch.c_str());
+      strSQL = PrepareSQL("select movie.idMovie, movie.c%02d, path.strPath FROM movie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE ", VIDEODB_ID_TITLE) + GetFullTextCondition("moviesearch", "movie", "idMovie", {VideoColumn(VIDEODB_ID_PLOT), VideoColumn(VIDEODB_ID_PLOTOUTLINE), VideoColumn(VIDEODB_ID_TAGLINE)}, strSearch);
     else
-      strSQL = PrepareSQL("SELECT movie.idMovie, movie.c%02d FROM movie WHERE (movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%')", VIDEODB_ID_TITLE, VIDEODB_ID_PLOT, strSearch.c_str(), VIDEODB_ID_PLOTOUTLINE, strSearch.c_str(), VIDEODB_ID_TAGLINE, strSearch.c_str());
+      strSQL = PrepareSQL("SELECT movie.idMovie, movie.c%02d FROM movie WHERE ", VIDEODB_ID_TITLE) + GetFullTextCondition("moviesearch", "movie", "idMovie", {VideoColumn(VIDEODB_ID_PLOT), VideoColumn(VIDEODB_ID_PLOTOUTLINE), VideoColumn(VIDEODB_ID_TAGLINE)}, strSearch);
 
     m_pDS->query( strSQL );
 
@@ -8784,9 +9048,9 @@ void CVideoDatabase::GetMovieDirectorsByName(const std::string& strSearch, CFile
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name, path.strPath FROM movie INNER JOIN director_link ON (director_link.media_id=movie.idMovie AND director_link.media_type='movie') INNER JOIN actor ON actor.actor_id=director_link.actor_id INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE actor.name LIKE '%%%s%%'", strSearch.c_str());
+      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name, path.strPath FROM movie INNER JOIN director_link ON (director_link.media_id=movie.idMovie AND director_link.media_type='movie') INNER JOIN actor ON actor.actor_id=director_link.actor_id INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
     else
-      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN movie ON director_link.media_id=movie.idMovie WHERE director_link.media_type='movie' AND actor.name like '%%%s%%'", strSearch.c_str());
+      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN movie ON director_link.media_id=movie.idMovie WHERE director_link.media_type='movie' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
 
     m_pDS->query( strSQL );
 
@@ -8827,9 +9091,9 @@ void CVideoDatabase::GetTvShowsDirectorsByName(const std::string& strSearch, CFi
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name, path.strPath FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN tvshow ON director_link.media_id=tvshow.idShow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE director_link.media_type='tvshow' AND actor.name LIKE '%%%s%%'", strSearch.c_str());
+      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name, path.strPath FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN tvshow ON director_link.media_id=tvshow.idShow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE director_link.media_type='tvshow' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
     else
-      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN tvshow ON director_link.media_id=tvshow.idShow WHERE director_link.media_type='tvshow' AND actor.name LIKE '%%%s%%'", strSearch.c_str());
+      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN tvshow ON director_link.media_id=tvshow.idShow WHERE director_link.media_type='tvshow' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
 
     m_pDS->query( strSQL );
 
@@ -8870,9 +9134,9 @@ void CVideoDatabase::GetMusicVideoDirectorsByName(const std::string& strSearch,
       return;
 
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name, path.strPath FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN musicvideo ON director_link.media_id=musicvideo.idMVideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE director_link.media_type='musicvideo' AND actor.name LIKE '%%%s%%'", strSearch.c_str());
+      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name, path.strPath FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN musicvideo ON director_link.media_id=musicvideo.idMVideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE director_link.media_type='musicvideo' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
     else
-      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN musicvideo ON director_link.media_id=musicvideo.idMVideo WHERE director_link.media_type='musicvideo' AND actor.name LIKE '%%%s%%'", strSearch.c_str());
+      strSQL = PrepareSQL("SELECT DISTINCT director_link.actor_id, actor.name FROM actor INNER JOIN director_link ON director_link.actor_id=actor.actor_id INNER JOIN musicvideo ON director_link.media_id=musicvideo.idMVideo WHERE director_link.media_type='musicvideo' AND ") + GetFullTextCondition("actorsearch", "actor", "actor_id", {"name"}, strSearch);
 
     m_pDS->query( strSQL );
 
@@ -9235,6 +9499,10 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
     sql = "DELETE FROM sets WHERE NOT EXISTS (SELECT 1 FROM movie WHERE movie.idSet = sets.idSet)";
     m_pDS->exec(sql);
 
+    // rebuilt on next use rather than updated for every removed item
+    ClearSmartPlaylistCache();
+    CRandomIdCache::GetInstance().Clear();
+
     CommitTransaction();
 
     if (handle)
@@ -10667,7 +10935,13 @@ bool CVideoDatabase::GetFilter(CDbUrl &videoUrl, Filter &filter, SortDescription
        (xsp.GetType() == "episodes" && itemType == "tvshows"))
     {
       std::set<std::string> playlists;
-      filter.AppendWhere(xsp.GetWhereClause(*this, playlists));
+      std::string xspWhere = xsp.GetWhereClause(*this, playlists);
+
+      // use the stored results unless the rules match other items as time goes by
+      playlists.clear();
+      if (xsp.GetType() == itemType && !xsp.IsTimeDependent(playlists))
+        xspWhere = GetSmartPlaylistCondition(itemType, xspWhere);
+      filter.AppendWhere(xspWhere);
 
       if (xsp.GetLimit() > 0)
         sorting.limitEnd = xsp.GetLimit();
@@ -10726,6 +11000,7 @@ bool CVideoDatabase::SetVideoUserRating(int dbId, int rating, const MediaType& m
       sql = PrepareSQL("UPDATE seasons SET userrating=%i WHERE idSeason = %i", rating, dbId);
 
     m_pDS->exec(sql);
+    UpdateSmartPlaylistsForItem(dbId, mediaType);
     return true;
   }
   catch (...)
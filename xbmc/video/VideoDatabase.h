@@ -809,9 +809,10 @@ public:
   std::string GetItemById(const std::string &itemType, int id);
 
   // partymode
-  /*! \brief Gets music video IDs in random order that match the where clause
+  /*! \brief Gets the IDs of the music videos that match the where clause to pick randomly from
   \param strWhere the SQL where clause to apply in the query
-  \param songIDs a vector of <2, id> pairs suited to party mode use
+  \param songIDs a vector of <2, id> pairs suited to party mode use, in no particular order so
+  pick them with KODI::UTILS::RandomSample
   \return count of music video IDs found.
   */
   unsigned int GetRandomMusicVideoIDs(const std::string& strWhere, std::vector<std::pair<int, int> > &songIDs);
@@ -963,6 +964,19 @@ private:
    */
   virtual void CreateViews();
 
+  bool GetSmartPlaylistSource(const std::string &type, std::string &view, std::string &idColumn) const override;
+
+  /*! \brief Evaluate the stored smart playlists again for a changed item
+   \param id the id of the item
+   \param mediaType the type of the item, the show of an episode is updated as well
+   */
+  void UpdateSmartPlaylistsForItem(int id, const MediaType &mediaType);
+
+  /*! \brief Evaluate the stored smart playlists again for the items of a file and their shows,
+   e.g. after its play count or resume point changed
+   */
+  void UpdateSmartPlaylistsForFile(int idFile);
+
   /*! \brief Helper to get a database id given a query.
    Returns an integer, -1 if not found, and greater than 0 if found.
    \param query the SQL that will retrieve a database id.
@@ -26,6 +26,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
+#include "utils/CPUInfo.h"
 #include "utils/EmbeddedArt.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -76,29 +77,49 @@ bool CThumbExtractor::operator==(const CJob* job) const
   return false;
 }
 
-bool CThumbExtractor::DoWork()
+namespace
+{
+
+bool CanExtractThumbs(const CFileItem& item)
 {
-  if (m_item.IsLiveTV()
+  if (item.IsLiveTV()
   // Due to a pvr addon api design flaw (no support for multiple concurrent streams
   // per addon instance), pvr recording thumbnail extraction does not work (reliably).
-  ||  URIUtils::IsPVRRecording(m_item.GetDynPath())
-  ||  URIUtils::IsUPnP(m_item.GetPath())
-  ||  URIUtils::IsBluray(m_item.GetPath())
-  ||  URIUtils::IsPlugin(m_item.GetDynPath()) // plugin path not fully resolved
-  ||  m_item.IsBDFile()
-  ||  m_item.IsDVD()
-  ||  m_item.IsDiscImage()
-  ||  m_item.IsDVDFile(false, true)
-  ||  m_item.IsInternetStream()
-  ||  m_item.IsDiscStub()
-  ||  m_item.IsPlayList())
+  ||  URIUtils::IsPVRRecording(item.GetDynPath())
+  ||  URIUtils::IsUPnP(item.GetPath())
+  ||  URIUtils::IsBluray(item.GetPath())
+  ||  URIUtils::IsPlugin(item.GetDynPath()) // plugin path not fully resolved
+  ||  item.IsBDFile()
+  ||  item.IsDVD()
+  ||  item.IsDiscImage()
+  ||  item.IsDVDFile(false, true)
+  ||  item.IsInternetStream()
+  ||  item.IsDiscStub()
+  ||  item.IsPlayList())
     return false;
 
   // For HTTP/FTP we only allow extraction when on a LAN
-  if (URIUtils::IsRemote(m_item.GetPath()) &&
-     !URIUtils::IsOnLAN(m_item.GetPath())  &&
-     (URIUtils::IsFTP(m_item.GetPath())    ||
-      URIUtils::IsHTTP(m_item.GetPath())))
+  if (URIUtils::IsRemote(item.GetPath()) &&
+     !URIUtils::IsOnLAN(item.GetPath())  &&
+     (URIUtils::IsFTP(item.GetPath())    ||
+      URIUtils::IsHTTP(item.GetPath())))
+    return false;
+
+  return true;
+}
+
+// thumbs are decoded single threaded, leave half the cores to playback and the GUI
+unsigned int GetThumbJobs()
+{
+  const auto cpuInfo = CServiceBroker::GetCPUInfo();
+  return cpuInfo ? std::max(1, cpuInfo->GetCPUCount() / 2) : 1;
+}
+
+} // unnamed namespace
+
+bool CThumbExtractor::DoWork()
+{
+  if (!CanExtractThumbs(m_item))
     return false;
 
   bool result=false;
@@ -175,8 +196,63 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+CThumbBatchExtractor::CThumbBatchExtractor(const CFileItem& item, std::vector<Thumb> thumbs)
+  : m_item(item), m_thumbs(std::move(thumbs))
+{
+  if (item.IsVideoDb() && item.HasVideoInfoTag())
+    m_item.SetPath(item.GetVideoInfoTag()->m_strFileNameAndPath);
+
+  if (m_item.IsStack())
+    m_item.SetPath(CStackDirectory::GetFirstStackedFile(m_item.GetPath()));
+}
+
+CThumbBatchExtractor::~CThumbBatchExtractor() = default;
+
+bool CThumbBatchExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CThumbBatchExtractor* jobExtract = dynamic_cast<const CThumbBatchExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath() &&
+        jobExtract->m_thumbs.size() == m_thumbs.size() &&
+        std::equal(m_thumbs.begin(), m_thumbs.end(), jobExtract->m_thumbs.begin(),
+                   [](const Thumb& a, const Thumb& b) { return a.target == b.target; }))
+      return true;
+  }
+  return false;
+}
+
+bool CThumbBatchExtractor::DoWork()
+{
+  if (!CanExtractThumbs(m_item))
+    return false;
+
+  CLog::Log(LOGDEBUG, "%s - trying to extract %u thumbs from video file %s", __FUNCTION__,
+            static_cast<unsigned int>(m_thumbs.size()), CURL::GetRedacted(m_item.GetPath()).c_str());
+
+  std::vector<CTextureDetails> details(m_thumbs.size());
+  std::vector<CDVDFileInfo::ThumbPosition> positions;
+  for (size_t i = 0; i < m_thumbs.size(); i++)
+  {
+    details[i].file = CTextureCache::GetCacheFile(m_thumbs[i].target) + ".jpg";
+    positions.push_back({m_thumbs[i].pos, &details[i], false});
+  }
+
+  const unsigned int total = m_thumbs.size();
+  unsigned int extracted = CDVDFileInfo::ExtractThumbs(m_item, positions, nullptr,
+                                                       [&](size_t i) {
+    Thumb& thumb = m_thumbs[i];
+    thumb.extracted = positions[i].extracted;
+    if (thumb.extracted)
+      CTextureCache::GetInstance().AddCachedTexture(thumb.target, details[i]);
+    return !ShouldCancel(i + 1, total);
+  });
+
+  return extracted > 0;
+}
+
 CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+  CThumbLoader(), CJobQueue(true, GetThumbJobs(), CJob::PRIORITY_LOW_PAUSABLE)
 {
   m_videoDatabase = new CVideoDatabase();
 }
@@ -56,6 +56,42 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details?
 };
 
+/*!
+ \ingroup thumbs,jobs
+ \brief Job extracting thumbs at several positions of one video in a single pass, e.g. of its
+ chapters
+
+ The positions are processed in the given order, keep them ascending. After each one
+ OnJobProgress() is called with the number of thumbs processed so far.
+
+ \sa CThumbExtractor and CDVDFileInfo::ExtractThumbs
+ */
+class CThumbBatchExtractor : public CJob
+{
+public:
+  struct Thumb
+  {
+    std::string target; ///< thumbpath
+    int64_t pos; ///< position to extract thumb from
+    bool extracted; ///< set once processed
+  };
+
+  CThumbBatchExtractor(const CFileItem& item, std::vector<Thumb> thumbs);
+  ~CThumbBatchExtractor() override;
+
+  bool DoWork() override;
+
+  const char* GetType() const override
+  {
+    return kJobTypeMediaFlags;
+  }
+
+  bool operator==(const CJob* job) const override;
+
+  CFileItem m_item;
+  std::vector<Thumb> m_thumbs;
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
@@ -260,7 +260,9 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
-  // add chapters if around
+  // add chapters if around, their missing thumbs are extracted in one pass
+  std::vector<CThumbBatchExtractor::Thumb> thumbs;
+  std::vector<unsigned int> thumbChapters;
   for (int i = 1; i <= g_application.GetAppPlayer().GetChapterCount(); ++i)
   {
     std::string chapterName;
@@ -283,10 +285,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
       item->SetArt("thumb", cachefile);
     else if (i > m_jobsStarted && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTCHAPTERTHUMBS))
     {
-      CFileItem item(m_filePath, false);
-      CJob* job = new CThumbExtractor(item, m_filePath, true, chapterPath, pos * 1000, false);
-      AddJob(job);
-      m_mapJobsChapter[job] = i;
+      thumbs.push_back({chapterPath, pos * 1000, false});
+      thumbChapters.push_back(i);
       m_jobsStarted++;
     }
 
@@ -296,6 +296,14 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
+  if (!thumbs.empty())
+  {
+    CJob* job = new CThumbBatchExtractor(CFileItem(m_filePath, false), std::move(thumbs));
+    m_mapJobsChapter[job] = std::move(thumbChapters);
+    if (!AddJob(job))
+      m_mapJobsChapter.erase(job);
+  }
+
   // sort items by resume point
   std::sort(items.begin(), items.end(), [](const CFileItemPtr &item1, const CFileItemPtr &item2) {
     return item1->GetProperty("resumepoint").asDouble() < item2->GetProperty("resumepoint").asDouble();
@@ -560,16 +568,32 @@ bool CGUIDialogVideoBookmarks::OnAddEpisodeBookmark()
 void CGUIDialogVideoBookmarks::OnJobComplete(unsigned int jobID,
                                              bool success, CJob* job)
 {
-  if (success && IsActive())
   {
-    MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(job);
-    if (iter != m_mapJobsChapter.end())
-    {
-      unsigned int chapterIdx = (*iter).second;
-      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
-      CApplicationMessenger::GetInstance().SendGUIMessage(m);
-      m_mapJobsChapter.erase(iter);
-    }
+    CSingleLock lock(m_refreshSection);
+    m_mapJobsChapter.erase(job);
   }
   CJobQueue::OnJobComplete(jobID, success, job);
 }
+
+void CGUIDialogVideoBookmarks::OnJobProgress(unsigned int jobID,
+                                             unsigned int progress, unsigned int total,
+                                             const CJob* job)
+{
+  if (!IsActive())
+    return;
+
+  CSingleLock lock(m_refreshSection);
+  MAPJOBSCHAPS::const_iterator iter = m_mapJobsChapter.find(job);
+  const CThumbBatchExtractor* extractor = dynamic_cast<const CThumbBatchExtractor*>(job);
+  if (iter == m_mapJobsChapter.end() || !extractor || progress == 0 ||
+      progress > iter->second.size())
+    return;
+
+  // refresh each chapter as soon as its thumb is there
+  if (extractor->m_thumbs[progress - 1].extracted)
+  {
+    unsigned int chapterIdx = iter->second[progress - 1];
+    CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
+    CApplicationMessenger::GetInstance().SendGUIMessage(m);
+  }
+}
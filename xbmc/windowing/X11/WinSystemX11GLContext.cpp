@@ -13,6 +13,8 @@
 #include "OptionalsReg.h"
 #include "VideoSyncOML.h"
 #include "X11DPMSSupport.h"
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "cores/AudioEngine/Sinks/AESinkWAV.h"
 #include "cores/RetroPlayer/process/X11/RPProcessInfoX11.h"
 #include "cores/RetroPlayer/rendering/VideoRenderers/RPRendererOpenGL.h"
 #include "cores/VideoPlayer/DVDCodecs/DVDFactoryCodec.h"
@@ -63,6 +65,14 @@ CWinSystemX11GLContext::CWinSystemX11GLContext()
   {
     OPTIONALS::SndioRegister();
   }
+  else if (StringUtils::EqualsNoCase(envSink, "NULL"))
+  {
+    CAESinkNULL::Register();
+  }
+  else if (StringUtils::EqualsNoCase(envSink, "WAV"))
+  {
+    CAESinkWAV::Register();
+  }
   else if (StringUtils::EqualsNoCase(envSink, "ALSA+PULSE"))
   {
     OPTIONALS::ALSARegister();
@@ -13,6 +13,8 @@
 #include "GLContextEGL.h"
 #include "OptionalsReg.h"
 #include "X11DPMSSupport.h"
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "cores/AudioEngine/Sinks/AESinkWAV.h"
 #include "cores/RetroPlayer/process/X11/RPProcessInfoX11.h"
 #include "cores/RetroPlayer/rendering/VideoRenderers/RPRendererOpenGLES.h"
 #include "cores/VideoPlayer/DVDCodecs/DVDFactoryCodec.h"
@@ -55,6 +57,14 @@ CWinSystemX11GLESContext::CWinSystemX11GLESContext()
   {
     OPTIONALS::SndioRegister();
   }
+  else if (StringUtils::EqualsNoCase(envSink, "NULL"))
+  {
+    CAESinkNULL::Register();
+  }
+  else if (StringUtils::EqualsNoCase(envSink, "WAV"))
+  {
+    CAESinkWAV::Register();
+  }
   else
   {
     if (!OPTIONALS::PulseAudioRegister())
@@ -14,6 +14,8 @@
 #include "OffScreenModeSetting.h"
 #include "OptionalsReg.h"
 #include "ServiceBroker.h"
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "cores/AudioEngine/Sinks/AESinkWAV.h"
 #include "messaging/ApplicationMessenger.h"
 #include "settings/DisplaySettings.h"
 #include "settings/Settings.h"
@@ -55,6 +57,14 @@ CWinSystemGbm::CWinSystemGbm() :
   {
     OPTIONALS::SndioRegister();
   }
+  else if (StringUtils::EqualsNoCase(envSink, "NULL"))
+  {
+    CAESinkNULL::Register();
+  }
+  else if (StringUtils::EqualsNoCase(envSink, "WAV"))
+  {
+    CAESinkWAV::Register();
+  }
   else if (StringUtils::EqualsNoCase(envSink, "ALSA+PULSE"))
   {
     OPTIONALS::ALSARegister();
@@ -22,6 +22,8 @@
 #include "VideoSyncWpPresentation.h"
 #include "WinEventsWayland.h"
 #include "WindowDecorator.h"
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "cores/AudioEngine/Sinks/AESinkWAV.h"
 #include "cores/RetroPlayer/process/wayland/RPProcessInfoWayland.h"
 #include "cores/VideoPlayer/Process/wayland/ProcessInfoWayland.h"
 #include "guilib/DispResource.h"
@@ -158,6 +160,14 @@ CWinSystemWayland::CWinSystemWayland()
   {
     OPTIONALS::SndioRegister();
   }
+  else if (StringUtils::EqualsNoCase(envSink, "NULL"))
+  {
+    CAESinkNULL::Register();
+  }
+  else if (StringUtils::EqualsNoCase(envSink, "WAV"))
+  {
+    CAESinkWAV::Register();
+  }
   else if (StringUtils::EqualsNoCase(envSink, "ALSA+PULSE"))
   {
     OPTIONALS::ALSARegister();
@@ -945,7 +945,12 @@ bool CGUIMediaWindow::Refresh(bool clearCache /* = false */)
     return false;
 
   if (clearCache)
+  {
     m_vecItems->RemoveDiscCache(GetID());
+    if (URIUtils::IsPlugin(strCurrentDirectory))
+      XFILE::CPluginDirectory::InvalidateCache(strCurrentDirectory,
+                                               CURL(strCurrentDirectory).GetHostName());
+  }
 
   bool ret = true;
 
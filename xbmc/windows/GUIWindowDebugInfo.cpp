@@ -119,6 +119,7 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                 stat.availPhys / 1024, stat.totalPhys / 1024, CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetSystemInfoProvider().GetFPS(),
                                 strCores.c_str(), ucAppName.c_str(), dCPU, profiling.c_str());
 #endif
+    info += "\n" + CServiceBroker::GetGUI()->GetWindowManager().GetFrameStats().GetSummary();
   }
 
   // render the skin debug info